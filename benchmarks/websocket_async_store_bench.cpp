@@ -0,0 +1,119 @@
+#include <vix/websocket/AsyncMessageStore.hpp>
+#include <vix/websocket/LogMessageStore.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Caller-side append latency with a durable store.
+ *
+ * The store is LogMessageStore with syncEveryAppend, so every append pays an
+ * fdatasync. "sync" calls it directly, as a message handler did before;
+ * "async" calls AsyncMessageStore::append() over the same store. Messages
+ * arrive every 100 us, like a busy handler; percentiles are of the time the
+ * caller spends inside append(). "drain ms" is how long flush() then waits
+ * for the writer to catch up.
+ */
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+
+  constexpr int MESSAGES = 2000;
+  constexpr auto INTERVAL = std::chrono::microseconds(100);
+
+  using clock = std::chrono::steady_clock;
+
+  ws::JsonMessage make_message(int i)
+  {
+    ws::JsonMessage m;
+    m.kind = "event";
+    m.room = "room-" + std::to_string(i % 16);
+    m.type = "chat.message";
+    m.payload = vix::json::kvs{"user", "bench", "text", "hello from the benchmark", "seq", i};
+    return m;
+  }
+
+  struct Result
+  {
+    double p50{0};
+    double p99{0};
+    double max{0};
+    double drainMs{0};
+  };
+
+  template <typename Store>
+  Result run(Store &store, const std::vector<ws::JsonMessage> &messages)
+  {
+    std::vector<double> us;
+    us.reserve(messages.size());
+
+    auto next = clock::now();
+    for (const auto &m : messages)
+    {
+      std::this_thread::sleep_until(next);
+      next += INTERVAL;
+
+      const auto t0 = clock::now();
+      store.append(m);
+      us.push_back(std::chrono::duration<double, std::micro>(clock::now() - t0).count());
+    }
+
+    const auto t0 = clock::now();
+    store.flush();
+
+    Result r;
+    r.drainMs = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+    std::sort(us.begin(), us.end());
+    r.p50 = us[us.size() / 2];
+    r.p99 = us[us.size() * 99 / 100];
+    r.max = us.back();
+    return r;
+  }
+
+  void print_row(const char *name, const Result &r)
+  {
+    std::printf("%-8s %10.1f %10.1f %10.1f %10.1f\n", name, r.p50, r.p99, r.max, r.drainMs);
+  }
+}
+
+int main()
+{
+  std::vector<ws::JsonMessage> messages;
+  for (int i = 0; i < MESSAGES; ++i)
+  {
+    messages.push_back(make_message(i));
+  }
+
+  ws::LogStoreOptions options;
+  options.syncEveryAppend = true;
+
+  std::printf("%-8s %10s %10s %10s %10s\n", "path", "p50 us", "p99 us", "max us", "drain ms");
+
+  const fs::path syncDir = fs::temp_directory_path() / "vix_ws_async_bench_sync";
+  fs::remove_all(syncDir);
+  {
+    ws::LogMessageStore store(syncDir.string(), options);
+    print_row("sync", run(store, messages));
+  }
+
+  const fs::path asyncDir = fs::temp_directory_path() / "vix_ws_async_bench_async";
+  fs::remove_all(asyncDir);
+  {
+    ws::LogMessageStore inner(asyncDir.string(), options);
+    ws::AsyncMessageStore store(inner);
+    print_row("async", run(store, messages));
+  }
+
+  fs::remove_all(syncDir);
+  fs::remove_all(asyncDir);
+  return 0;
+}
@@ -0,0 +1,220 @@
+#include <vix/websocket/CoreGroup.hpp>
+#include <vix/websocket/SessionRegistry.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Room broadcast fan-out to 50 000 sessions.
+ *
+ * "registry" walks the shared, lock-sharded BasicSessionRegistry from the
+ * sending thread, which then touches every session itself. "cores/N" hands
+ * the broadcast to N core threads through their lock-free inboxes; each
+ * core only visits the sessions it owns. Timings cover the broadcast call
+ * until the last session was reached.
+ *
+ * Scaling needs as many free CPUs as cores; on a host with fewer, the
+ * cores/N rows measure the hand-off overhead instead.
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  constexpr std::size_t SESSIONS = 50000;
+  constexpr int ROUNDS = 200;
+
+  struct FakeSession
+  {
+    std::uint64_t queued{0};
+    std::uint64_t bytes{0};
+  };
+
+  /** Stand-in for Session::send_frame(): bookkeeping on the session. */
+  inline void deliver(FakeSession &s)
+  {
+    ++s.queued;
+    s.bytes += 64;
+  }
+
+  class Workers
+  {
+  public:
+    explicit Workers(std::size_t n)
+        : queues_(n)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        threads_.emplace_back(
+            [this, i]()
+            {
+              detail::this_core = i;
+              Queue &q = queues_[i];
+
+              while (true)
+              {
+                std::function<void()> fn;
+                {
+                  std::unique_lock<std::mutex> lock(q.mutex);
+                  q.cv.wait(lock, [&]()
+                            { return q.stop || !q.work.empty(); });
+                  if (q.work.empty())
+                  {
+                    return;
+                  }
+                  fn = std::move(q.work.front());
+                  q.work.pop_front();
+                }
+                fn();
+              }
+            });
+      }
+    }
+
+    ~Workers()
+    {
+      for (Queue &q : queues_)
+      {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.stop = true;
+        q.cv.notify_all();
+      }
+      for (auto &t : threads_)
+      {
+        t.join();
+      }
+    }
+
+    void post(std::size_t core, std::function<void()> fn)
+    {
+      Queue &q = queues_[core];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.work.push_back(std::move(fn));
+      q.cv.notify_one();
+    }
+
+  private:
+    struct Queue
+    {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::deque<std::function<void()>> work;
+      bool stop{false};
+    };
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+  };
+
+  using clock = std::chrono::steady_clock;
+
+  double us_per_broadcast(clock::duration elapsed)
+  {
+    return std::chrono::duration<double, std::micro>(elapsed).count() / ROUNDS;
+  }
+
+  double bench_registry(const std::vector<std::shared_ptr<FakeSession>> &sessions)
+  {
+    detail::BasicSessionRegistry<FakeSession> registry;
+    for (const auto &s : sessions)
+    {
+      registry.join(s, "room");
+    }
+
+    const auto t0 = clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+      registry.for_each_in_room("room", deliver);
+    }
+    return us_per_broadcast(clock::now() - t0);
+  }
+
+  double bench_cores(const std::vector<std::shared_ptr<FakeSession>> &sessions, std::size_t cores)
+  {
+    // The group must outlive the workers' last drain.
+    std::unique_ptr<detail::BasicCoreGroup<FakeSession>> group;
+    Workers workers(cores);
+    group = std::make_unique<detail::BasicCoreGroup<FakeSession>>(
+        cores,
+        [&workers](std::size_t core, std::function<void()> fn)
+        {
+          workers.post(core, std::move(fn));
+        });
+
+    std::atomic<std::size_t> done{0};
+    for (std::size_t i = 0; i < sessions.size(); ++i)
+    {
+      group->join(i % cores, sessions[i], "room");
+    }
+
+    auto wait_done = [&](std::size_t target)
+    {
+      while (done.load(std::memory_order_acquire) < target)
+      {
+        std::this_thread::yield();
+      }
+    };
+
+    // A marker posted after the broadcast runs once its core is done.
+    auto round = [&]()
+    {
+      group->broadcast_room("room", deliver);
+      for (std::size_t c = 0; c < cores; ++c)
+      {
+        workers.post(c, [&done]()
+                     { done.fetch_add(1, std::memory_order_release); });
+      }
+    };
+
+    round();
+    wait_done(cores);
+    done.store(0);
+
+    const auto t0 = clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+      round();
+    }
+    wait_done(cores * ROUNDS);
+    return us_per_broadcast(clock::now() - t0);
+  }
+}
+
+int main()
+{
+  std::vector<std::shared_ptr<FakeSession>> sessions;
+  sessions.reserve(SESSIONS);
+  for (std::size_t i = 0; i < SESSIONS; ++i)
+  {
+    sessions.push_back(std::make_shared<FakeSession>());
+  }
+
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  std::printf("%-12s %14s\n", "path", "us/broadcast");
+  std::printf("%-12s %14.1f\n", "registry", bench_registry(sessions));
+
+  for (std::size_t cores : {1u, 2u, 4u, 8u})
+  {
+    char name[16];
+    std::snprintf(name, sizeof(name), "cores/%zu", cores);
+    std::printf("%-12s %14.1f\n", name, bench_cores(sessions, cores));
+  }
+
+  std::uint64_t sink = 0;
+  for (const auto &s : sessions)
+  {
+    sink += s->queued;
+  }
+  std::printf("(checksum %llu)\n", static_cast<unsigned long long>(sink));
+  return 0;
+}
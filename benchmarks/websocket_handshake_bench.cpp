@@ -0,0 +1,218 @@
+#include <vix/websocket/handshake.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Cost of computing one Sec-WebSocket-Accept value from a 24-character
+ * client key.
+ *
+ * "legacy" reproduces the previous path (string concatenation, input copied
+ * into a std::vector, scalar SHA-1, base64 built one push_back at a time).
+ * The other rows run the stack-only accept-key path with each SHA-1 kernel.
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  constexpr std::size_t ITERATIONS = 1000000;
+
+  std::uint32_t rol32(std::uint32_t value, std::uint32_t bits)
+  {
+    return (value << bits) | (value >> (32u - bits));
+  }
+
+  std::array<unsigned char, 20> legacy_sha1(const unsigned char *data, std::size_t len)
+  {
+    std::uint32_t h[5] = {0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u};
+    const std::uint64_t bit_len = static_cast<std::uint64_t>(len) * 8ull;
+
+    std::vector<unsigned char> msg(data, data + len);
+    msg.push_back(0x80u);
+    while ((msg.size() % 64u) != 56u)
+    {
+      msg.push_back(0x00u);
+    }
+    for (int i = 7; i >= 0; --i)
+    {
+      msg.push_back(static_cast<unsigned char>((bit_len >> (i * 8)) & 0xFFu));
+    }
+
+    for (std::size_t chunk = 0; chunk < msg.size(); chunk += 64)
+    {
+      std::uint32_t w[80]{};
+      for (int i = 0; i < 16; ++i)
+      {
+        const std::size_t j = chunk + static_cast<std::size_t>(i) * 4u;
+        w[i] = (std::uint32_t{msg[j]} << 24) | (std::uint32_t{msg[j + 1]} << 16) |
+               (std::uint32_t{msg[j + 2]} << 8) | std::uint32_t{msg[j + 3]};
+      }
+      for (int i = 16; i < 80; ++i)
+      {
+        w[i] = rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+      }
+
+      std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+      for (int i = 0; i < 80; ++i)
+      {
+        std::uint32_t f = 0;
+        std::uint32_t k = 0;
+        if (i < 20)
+        {
+          f = (b & c) | ((~b) & d);
+          k = 0x5A827999u;
+        }
+        else if (i < 40)
+        {
+          f = b ^ c ^ d;
+          k = 0x6ED9EBA1u;
+        }
+        else if (i < 60)
+        {
+          f = (b & c) | (b & d) | (c & d);
+          k = 0x8F1BBCDCu;
+        }
+        else
+        {
+          f = b ^ c ^ d;
+          k = 0xCA62C1D6u;
+        }
+        const std::uint32_t temp = rol32(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rol32(b, 30);
+        b = a;
+        a = temp;
+      }
+
+      h[0] += a;
+      h[1] += b;
+      h[2] += c;
+      h[3] += d;
+      h[4] += e;
+    }
+
+    std::array<unsigned char, 20> out{};
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      out[i * 4 + 0] = static_cast<unsigned char>(h[i] >> 24);
+      out[i * 4 + 1] = static_cast<unsigned char>(h[i] >> 16);
+      out[i * 4 + 2] = static_cast<unsigned char>(h[i] >> 8);
+      out[i * 4 + 3] = static_cast<unsigned char>(h[i]);
+    }
+    return out;
+  }
+
+  std::string legacy_base64(const unsigned char *data, std::size_t len)
+  {
+    static constexpr char table[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve(((len + 2u) / 3u) * 4u);
+
+    std::size_t i = 0;
+    for (; i + 3u <= len; i += 3u)
+    {
+      const std::uint32_t n = (std::uint32_t{data[i]} << 16) |
+                              (std::uint32_t{data[i + 1]} << 8) | std::uint32_t{data[i + 2]};
+      out.push_back(table[(n >> 18) & 0x3F]);
+      out.push_back(table[(n >> 12) & 0x3F]);
+      out.push_back(table[(n >> 6) & 0x3F]);
+      out.push_back(table[n & 0x3F]);
+    }
+    if (len - i == 2u)
+    {
+      const std::uint32_t n = (std::uint32_t{data[i]} << 16) | (std::uint32_t{data[i + 1]} << 8);
+      out.push_back(table[(n >> 18) & 0x3F]);
+      out.push_back(table[(n >> 12) & 0x3F]);
+      out.push_back(table[(n >> 6) & 0x3F]);
+      out.push_back('=');
+    }
+    return out;
+  }
+
+  std::string legacy_accept(const std::string &key)
+  {
+    const std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    const auto digest = legacy_sha1(
+        reinterpret_cast<const unsigned char *>(input.data()), input.size());
+    return legacy_base64(digest.data(), digest.size());
+  }
+
+  /** Accept key on the stack path, forcing @p kernel for the two blocks. */
+  detail::AcceptKey kernel_accept(detail::Sha1Kernel kernel, const std::string &key)
+  {
+    std::array<unsigned char, 60> input{};
+    key.copy(reinterpret_cast<char *>(input.data()), 24);
+    std::string_view guid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    guid.copy(reinterpret_cast<char *>(input.data()) + 24, guid.size());
+
+    const auto digest = detail::sha1_digest_with(kernel, input.data(), input.size());
+    detail::AcceptKey out{};
+    detail::base64_encode_to(digest.data(), digest.size(), out.data());
+    return out;
+  }
+
+  template <typename Fn>
+  double ns_per_key(Fn fn)
+  {
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; ++i)
+    {
+      fn(i);
+    }
+    const auto t1 = clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+  }
+}
+
+int main()
+{
+  std::string key = "dGhlIHNhbXBsZSBub25jZQ==";
+  std::size_t sink = 0;
+
+  std::printf("active kernel: %s\n", detail::sha1_kernel_name(detail::active_sha1_kernel()));
+  std::printf("%-22s %10s\n", "path", "ns/key");
+
+  const double legacy = ns_per_key(
+      [&](std::size_t i)
+      {
+        key[0] = static_cast<char>('A' + (i & 15));
+        sink += static_cast<unsigned char>(legacy_accept(key)[0]);
+      });
+  std::printf("%-22s %10.1f\n", "legacy", legacy);
+
+  for (auto kernel : {detail::Sha1Kernel::Scalar, detail::Sha1Kernel::ShaNi, detail::Sha1Kernel::ArmSha})
+  {
+    if (!detail::sha1_kernel_supported(kernel))
+    {
+      continue;
+    }
+
+    const double ns = ns_per_key(
+        [&](std::size_t i)
+        {
+          key[0] = static_cast<char>('A' + (i & 15));
+          sink += static_cast<unsigned char>(kernel_accept(kernel, key)[0]);
+        });
+    std::printf("stack/%-16s %10.1f\n", detail::sha1_kernel_name(kernel), ns);
+  }
+
+  const double dispatched = ns_per_key(
+      [&](std::size_t i)
+      {
+        key[0] = static_cast<char>('A' + (i & 15));
+        sink += static_cast<unsigned char>(detail::websocket_accept_key(key)[0]);
+      });
+  std::printf("%-22s %10.1f\n", "websocket_accept_key", dispatched);
+
+  std::printf("(checksum %zu)\n", sink);
+  return 0;
+}
@@ -0,0 +1,204 @@
+#include <vix/websocket/LogMessageStore.hpp>
+#include <vix/websocket/SqliteMessageStore.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * LogMessageStore append throughput against the disk and SqliteMessageStore.
+ *
+ * "write()" is the sequential-disk baseline: records of the log's average
+ * size written back to back with write(2), no encoding. "log" is
+ * LogMessageStore::append(); "sqlite/1024" is SqliteMessageStore with
+ * 1024-message group commit. Each timing ends with the store's flush(),
+ * and fdatasync() for the baseline.
+ *
+ * History columns are microseconds per query over the filled stores:
+ *   room    latest 50 messages of a room
+ *   page    50 room messages before a cursor in the middle
+ *   replay  100 messages after a cursor in the middle
+ */
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+
+  constexpr int MESSAGES = 200000;
+  constexpr int ROOMS = 16;
+  constexpr int QUERIES = 2000;
+
+  using clock = std::chrono::steady_clock;
+
+  fs::path fresh(const char *name)
+  {
+    const fs::path path = fs::temp_directory_path() / name;
+    fs::remove_all(path);
+    for (const char *suffix : {"-wal", "-shm"})
+    {
+      fs::remove(path.string() + suffix);
+    }
+    return path;
+  }
+
+  std::string make_id(std::uint64_t n)
+  {
+    return ws::detail::MonotonicIdGenerator::format(n);
+  }
+
+  ws::JsonMessage make_message(int i)
+  {
+    ws::JsonMessage m;
+    m.id = make_id(1000000 + static_cast<std::uint64_t>(i));
+    m.kind = "event";
+    m.room = "room-" + std::to_string(i % ROOMS);
+    m.type = "chat.message";
+    m.ts = "2025-01-01T00:00:00Z";
+    m.payload = vix::json::kvs{"user", "bench", "text", "hello from the benchmark", "seq", i};
+    return m;
+  }
+
+  struct Result
+  {
+    double seconds{0};
+    double room{0};
+    double page{0};
+    double replay{0};
+  };
+
+  template <typename Fn>
+  double us_per_query(Fn &&fn)
+  {
+    const auto t0 = clock::now();
+    for (int q = 0; q < QUERIES; ++q)
+    {
+      fn(q);
+    }
+    return std::chrono::duration<double, std::micro>(clock::now() - t0).count() / QUERIES;
+  }
+
+  template <typename Store>
+  Result run(Store &store, const std::vector<ws::JsonMessage> &messages, std::size_t &sink)
+  {
+    Result r;
+    const auto t0 = clock::now();
+    for (const auto &m : messages)
+    {
+      store.append(m);
+    }
+    store.flush();
+    r.seconds = std::chrono::duration<double>(clock::now() - t0).count();
+
+    const std::string middle = make_id(1000000 + MESSAGES / 2);
+    r.room = us_per_query([&](int q)
+                          { sink += store.list_by_room("room-" + std::to_string(q % ROOMS), 50).size(); });
+    r.page = us_per_query([&](int q)
+                          { sink += store.list_by_room("room-" + std::to_string(q % ROOMS), 50, middle).size(); });
+    r.replay = us_per_query([&](int)
+                            { sink += store.replay_from(middle, 100).size(); });
+    return r;
+  }
+
+  /** Bytes of valid records in a segment, following the length prefixes. */
+  std::uint64_t used_bytes(const fs::path &segment)
+  {
+    std::ifstream in(segment, std::ios::binary);
+    std::uint64_t used = 0;
+    unsigned char header[8];
+    while (in.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+      const std::uint32_t body = header[0] | (header[1] << 8) | (header[2] << 16) |
+                                 (static_cast<std::uint32_t>(header[3]) << 24);
+      if (body == 0)
+        break;
+      used += sizeof(header) + body;
+      in.seekg(body, std::ios::cur);
+    }
+    return used;
+  }
+
+  double bench_write(std::size_t recordBytes)
+  {
+    const fs::path path = fresh("vix_ws_log_bench_raw.bin");
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    std::vector<char> record(recordBytes, 'x');
+
+    const auto t0 = clock::now();
+    for (int i = 0; i < MESSAGES; ++i)
+    {
+      if (::write(fd, record.data(), record.size()) < 0)
+        break;
+    }
+    ::fdatasync(fd);
+    const double seconds = std::chrono::duration<double>(clock::now() - t0).count();
+
+    ::close(fd);
+    fs::remove(path);
+    return seconds;
+  }
+
+  void print_row(const char *name, double seconds, double bytes, const Result *r)
+  {
+    std::printf("%-12s %12.0f %10.1f", name, MESSAGES / seconds, bytes / seconds / 1e6);
+    if (r)
+    {
+      std::printf(" %10.1f %10.1f %10.1f", r->room, r->page, r->replay);
+    }
+    std::printf("\n");
+  }
+}
+
+int main()
+{
+  std::vector<ws::JsonMessage> messages;
+  messages.reserve(MESSAGES);
+  for (int i = 0; i < MESSAGES; ++i)
+  {
+    messages.push_back(make_message(i));
+  }
+
+  std::size_t sink = 0;
+
+  const fs::path logDir = fresh("vix_ws_log_bench");
+  Result log;
+  std::uint64_t logBytes = 0;
+  {
+    ws::LogMessageStore store(logDir.string());
+    log = run(store, messages, sink);
+    for (const auto &entry : fs::directory_iterator(logDir))
+    {
+      logBytes += used_bytes(entry.path());
+    }
+  }
+
+  const fs::path dbPath = fresh("vix_ws_log_bench.db");
+  Result sqlite;
+  {
+    ws::SqliteStoreOptions options;
+    options.groupCommitMessages = 1024;
+    ws::SqliteMessageStore store(dbPath.string(), options);
+    sqlite = run(store, messages, sink);
+  }
+
+  const double raw = bench_write(logBytes / MESSAGES);
+
+  std::printf("%-12s %12s %10s %10s %10s %10s\n", "path", "msgs/s", "MB/s", "room", "page", "replay");
+  print_row("write()", raw, static_cast<double>(logBytes), nullptr);
+  print_row("log", log.seconds, static_cast<double>(logBytes), &log);
+  print_row("sqlite/1024", sqlite.seconds, static_cast<double>(logBytes), &sqlite);
+  std::printf("(record %llu bytes, rows read %zu)\n",
+              static_cast<unsigned long long>(logBytes / MESSAGES), sink);
+
+  fs::remove_all(logDir);
+  fresh("vix_ws_log_bench.db");
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <vix/websocket/mask.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::MaskKernel;
+
+  /** The original per-byte loop from detail::apply_mask_in_place. */
+  void legacy_mask(std::byte *data, std::size_t size, const std::array<std::byte, 4> &key)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      data[i] = data[i] ^ key[i % 4];
+    }
+  }
+
+  template <typename Fn>
+  double measure_gib_per_s(std::vector<std::byte> &buf, std::size_t size, Fn &&fn)
+  {
+    using clock = std::chrono::steady_clock;
+
+    // Touch ~512 MiB per measurement, never fewer than 8 iterations.
+    const std::size_t target = std::size_t{512} * 1024 * 1024;
+    std::size_t iterations = target / size;
+    if (iterations < 8)
+    {
+      iterations = 8;
+    }
+
+    fn(buf.data() + 1, size); // warm-up; offset 1 keeps the head unaligned
+
+    const auto start = clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      fn(buf.data() + 1, size);
+    }
+    const auto stop = clock::now();
+
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    const double bytes = static_cast<double>(size) * static_cast<double>(iterations);
+    return bytes / seconds / (1024.0 * 1024.0 * 1024.0);
+  }
+}
+
+int main()
+{
+  const std::array<std::byte, 4> key = {
+      std::byte{0x12}, std::byte{0x34}, std::byte{0x56}, std::byte{0x78}};
+
+  const std::array<MaskKernel, 4> kernels = {
+      MaskKernel::Scalar64,
+      MaskKernel::Sse2,
+      MaskKernel::Avx2,
+      MaskKernel::Neon,
+  };
+
+  const std::size_t max_size = std::size_t{16} * 1024 * 1024;
+  std::vector<std::byte> buf(max_size + 64, std::byte{0xAB});
+
+  std::printf("active kernel: %s\n",
+              vix::websocket::detail::mask_kernel_name(
+                  vix::websocket::detail::active_mask_kernel()));
+  std::printf("%10s %10s", "size", "legacy");
+  for (MaskKernel k : kernels)
+  {
+    if (vix::websocket::detail::mask_kernel_supported(k))
+    {
+      std::printf(" %10s", vix::websocket::detail::mask_kernel_name(k));
+    }
+  }
+  std::printf(" %10s %8s   (GiB/s)\n", "dispatch", "speedup");
+
+  for (std::size_t size = 16; size <= max_size; size *= 4)
+  {
+    const double legacy = measure_gib_per_s(
+        buf, size,
+        [&](std::byte *p, std::size_t n)
+        { legacy_mask(p, n, key); });
+
+    std::printf("%10zu %10.2f", size, legacy);
+
+    for (MaskKernel k : kernels)
+    {
+      if (!vix::websocket::detail::mask_kernel_supported(k))
+      {
+        continue;
+      }
+
+      const double rate = measure_gib_per_s(
+          buf, size,
+          [&](std::byte *p, std::size_t n)
+          { vix::websocket::detail::apply_mask_with(k, p, n, key, 0); });
+
+      std::printf(" %10.2f", rate);
+    }
+
+    const double dispatched = measure_gib_per_s(
+        buf, size,
+        [&](std::byte *p, std::size_t n)
+        { vix::websocket::detail::apply_mask(p, n, key, 0); });
+
+    std::printf(" %10.2f %7.1fx\n", dispatched, dispatched / legacy);
+  }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <vix/websocket/MessageId.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Message id generation throughput.
+ *
+ * "legacy" reproduces the previous generate_id(): system_clock microseconds
+ * zero-padded through an ostringstream (and colliding within a microsecond).
+ * "monotonic" is MonotonicIdGenerator::next(), formatted; "monotonic/N"
+ * runs N threads against one generator.
+ */
+
+namespace
+{
+  constexpr int IDS = 2000000;
+
+  using clock = std::chrono::steady_clock;
+
+  std::string legacy_id()
+  {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+
+    std::ostringstream oss;
+    oss << std::setw(20) << std::setfill('0') << micros;
+    return oss.str();
+  }
+
+  double millions_per_second(std::size_t count, clock::duration elapsed)
+  {
+    return count / std::chrono::duration<double>(elapsed).count() / 1e6;
+  }
+
+  double bench_legacy(std::size_t &sink)
+  {
+    const auto t0 = clock::now();
+    for (int i = 0; i < IDS; ++i)
+    {
+      sink += legacy_id().back();
+    }
+    return millions_per_second(IDS, clock::now() - t0);
+  }
+
+  double bench_monotonic(int threads, std::size_t &sink)
+  {
+    vix::websocket::detail::MonotonicIdGenerator ids;
+    std::vector<std::size_t> sums(static_cast<std::size_t>(threads), 0);
+
+    const auto t0 = clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+      workers.emplace_back(
+          [&ids, &sums, t]()
+          {
+            for (int i = 0; i < IDS; ++i)
+            {
+              sums[static_cast<std::size_t>(t)] += ids.next().back();
+            }
+          });
+    }
+    for (auto &w : workers)
+    {
+      w.join();
+    }
+    const auto elapsed = clock::now() - t0;
+
+    for (std::size_t s : sums)
+    {
+      sink += s;
+    }
+    return millions_per_second(static_cast<std::size_t>(IDS) * threads, elapsed);
+  }
+}
+
+int main()
+{
+  std::size_t sink = 0;
+
+  std::printf("%-14s %12s\n", "generator", "M ids/s");
+  std::printf("%-14s %12.2f\n", "legacy", bench_legacy(sink));
+  std::printf("%-14s %12.2f\n", "monotonic", bench_monotonic(1, sink));
+
+  for (int threads : {2, 4})
+  {
+    char name[24];
+    std::snprintf(name, sizeof(name), "monotonic/%d", threads);
+    std::printf("%-14s %12.2f\n", name, bench_monotonic(threads, sink));
+  }
+
+  std::printf("(checksum %zu)\n", sink);
+  return 0;
+}
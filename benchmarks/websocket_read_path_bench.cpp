@@ -0,0 +1,171 @@
+#include <vix/websocket/ReadBuffer.hpp>
+#include <vix/websocket/protocol.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Pipelines a burst of small masked client frames through the session
+ * receive path, the way Session::read_frame consumes them: bytes arrive in
+ * socket-sized reads and every complete frame is parsed and unmasked.
+ *
+ * "legacy" reproduces the previous path (std::string buffer, per-frame
+ * memcpy into a vector, erase from the front). "cursor" is the
+ * ReadBuffer + decode_frame_in_place path now used by Session.
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  constexpr std::size_t FRAME_COUNT = 10000;
+
+  std::vector<std::byte> make_burst()
+  {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<std::size_t> len(16, 200);
+
+    std::vector<std::byte> burst;
+    for (std::size_t i = 0; i < FRAME_COUNT; ++i)
+    {
+      const std::string text(len(rng), 'x');
+      const auto frame = detail::build_text_frame(text, true);
+      burst.insert(burst.end(), frame.begin(), frame.end());
+    }
+    return burst;
+  }
+
+  std::size_t run_legacy(const std::vector<std::byte> &burst, std::size_t readSize)
+  {
+    std::string buffer;
+    std::size_t frames = 0;
+    std::size_t checksum = 0;
+    std::size_t offset = 0;
+
+    while (offset < burst.size() || buffer.size() >= 2)
+    {
+      if (offset < burst.size())
+      {
+        const std::size_t n = std::min(readSize, burst.size() - offset);
+        buffer.append(reinterpret_cast<const char *>(burst.data() + offset), n);
+        offset += n;
+      }
+
+      while (buffer.size() >= 2)
+      {
+        const auto *p = reinterpret_cast<const std::byte *>(buffer.data());
+        if (buffer.size() < detail::frame_header_size(p))
+        {
+          break;
+        }
+
+        const auto h = detail::parse_frame_header(p, buffer.size());
+        const std::size_t frame_size = h.header_size + h.payload_length;
+        if (buffer.size() < frame_size)
+        {
+          break;
+        }
+
+        std::vector<std::byte> bytes(frame_size);
+        std::memcpy(bytes.data(), buffer.data(), frame_size);
+        buffer.erase(0, frame_size);
+
+        const auto f = detail::decode_frame(bytes);
+        checksum += f.payload.size();
+        ++frames;
+      }
+
+      if (offset >= burst.size())
+      {
+        break;
+      }
+    }
+
+    return frames + (checksum & 1);
+  }
+
+  std::size_t run_cursor(const std::vector<std::byte> &burst, std::size_t readSize)
+  {
+    detail::ReadBuffer buffer;
+    std::size_t frames = 0;
+    std::size_t checksum = 0;
+    std::size_t offset = 0;
+
+    while (offset < burst.size())
+    {
+      const std::size_t n = std::min(readSize, burst.size() - offset);
+      auto space = buffer.prepare(n);
+      std::memcpy(space.data(), burst.data() + offset, n); // stands in for async_read
+      buffer.commit(n);
+      offset += n;
+
+      while (buffer.size() >= 2)
+      {
+        if (buffer.size() < detail::frame_header_size(buffer.data()))
+        {
+          break;
+        }
+
+        const auto h = detail::parse_frame_header(buffer.data(), buffer.size());
+        const std::size_t frame_size = h.header_size + h.payload_length;
+        if (buffer.size() < frame_size)
+        {
+          break;
+        }
+
+        const auto f = detail::decode_frame_in_place(buffer.data(), h);
+        checksum += f.payload.size();
+        buffer.consume(frame_size);
+        ++frames;
+      }
+    }
+
+    return frames + (checksum & 1);
+  }
+
+  template <typename Fn>
+  double ns_per_frame(Fn &&fn)
+  {
+    using clock = std::chrono::steady_clock;
+    constexpr int rounds = 5;
+
+    fn();
+    const auto start = clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+      fn();
+    }
+    const auto stop = clock::now();
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           (static_cast<double>(rounds) * FRAME_COUNT);
+  }
+}
+
+int main()
+{
+  const auto burst = make_burst();
+
+  std::printf("%zu frames, %zu bytes pipelined\n", FRAME_COUNT, burst.size());
+  std::printf("%12s %14s %14s %9s\n", "read size", "legacy ns/fr", "cursor ns/fr", "speedup");
+
+  const std::size_t readSizes[] = {8192, 65536, burst.size()};
+  for (std::size_t readSize : readSizes)
+  {
+    const double legacy = ns_per_frame([&]
+                                       { return run_legacy(burst, readSize); });
+    const double cursor = ns_per_frame([&]
+                                       { return run_cursor(burst, readSize); });
+
+    std::printf("%12zu %14.1f %14.1f %8.1fx\n", readSize, legacy, cursor, legacy / cursor);
+  }
+
+  return 0;
+}
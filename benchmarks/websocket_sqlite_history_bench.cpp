@@ -0,0 +1,265 @@
+#include <vix/websocket/SqliteMessageStore.hpp>
+
+#include <nlohmann/json.hpp>
+#include <sqlite3.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+/*
+ * Room history latency as the messages table grows to 10M rows.
+ *
+ * 100 busy rooms share the traffic; one "quiet" room gets every 10 000th
+ * message. "legacy" runs the previous queries on the previous schema (TEXT
+ * id primary key only), where finding a quiet room's page walks the whole
+ * id index. "store" is SqliteMessageStore with the (room, seq) index.
+ *
+ * Columns are microseconds per query:
+ *   busy    latest 50 messages of a busy room
+ *   quiet   latest 50 messages of the quiet room
+ *   page    50 busy-room messages before a cursor in the middle
+ *   replay  100 messages after a cursor in the middle
+ *
+ * Pass the largest table size as the first argument (default 10000000).
+ */
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+
+  constexpr int BUSY_ROOMS = 100;
+  constexpr std::uint64_t QUIET_EVERY = 10000;
+
+  using clock = std::chrono::steady_clock;
+
+  std::string db_path(const char *name)
+  {
+    const fs::path path = fs::temp_directory_path() / name;
+    for (const char *suffix : {"", "-wal", "-shm"})
+    {
+      fs::remove(path.string() + suffix);
+    }
+    return path.string();
+  }
+
+  std::string make_id(std::uint64_t n)
+  {
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%020llu", static_cast<unsigned long long>(n));
+    return buf;
+  }
+
+  std::string room_of(std::uint64_t n)
+  {
+    return n % QUIET_EVERY == 0 ? "quiet" : "room-" + std::to_string(n % BUSY_ROOMS);
+  }
+
+  struct Row
+  {
+    double busy{0};
+    double quiet{0};
+    double page{0};
+    double replay{0};
+  };
+
+  template <typename Fn>
+  double us_per_query(int queries, Fn &&fn)
+  {
+    const auto t0 = clock::now();
+    for (int q = 0; q < queries; ++q)
+    {
+      fn(q);
+    }
+    return std::chrono::duration<double, std::micro>(clock::now() - t0).count() / queries;
+  }
+
+  /** Previous schema and queries, driven through raw SQLite. */
+  class LegacyTable
+  {
+  public:
+    LegacyTable()
+    {
+      sqlite3_open(db_path("vix_ws_history_legacy.db").c_str(), &db_);
+      sqlite3_exec(db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+      sqlite3_exec(
+          db_,
+          "CREATE TABLE messages ("
+          "  id TEXT PRIMARY KEY, kind TEXT NOT NULL, room TEXT,"
+          "  type TEXT NOT NULL, ts TEXT NOT NULL, payload_json TEXT NOT NULL);",
+          nullptr, nullptr, nullptr);
+
+      sqlite3_prepare_v2(
+          db_,
+          "INSERT INTO messages VALUES (?1, 'event', ?2, 'chat', '2025-01-01T00:00:00Z', '{\"n\":1}');",
+          -1, &insert_, nullptr);
+      sqlite3_prepare_v2(
+          db_,
+          "SELECT id, kind, room, type, ts, payload_json FROM messages "
+          "WHERE room = ?1 ORDER BY id DESC LIMIT ?2;",
+          -1, &list_, nullptr);
+      sqlite3_prepare_v2(
+          db_,
+          "SELECT id, kind, room, type, ts, payload_json FROM messages "
+          "WHERE room = ?1 AND id < ?2 ORDER BY id DESC LIMIT ?3;",
+          -1, &page_, nullptr);
+      sqlite3_prepare_v2(
+          db_,
+          "SELECT id, kind, room, type, ts, payload_json FROM messages "
+          "WHERE id > ?1 ORDER BY id ASC LIMIT ?2;",
+          -1, &replay_, nullptr);
+    }
+
+    ~LegacyTable()
+    {
+      for (sqlite3_stmt *stmt : {insert_, list_, page_, replay_})
+      {
+        sqlite3_finalize(stmt);
+      }
+      sqlite3_close(db_);
+    }
+
+    void fill(std::uint64_t from, std::uint64_t to)
+    {
+      sqlite3_exec(db_, "BEGIN;", nullptr, nullptr, nullptr);
+      for (std::uint64_t n = from; n < to; ++n)
+      {
+        const std::string id = make_id(n);
+        const std::string room = room_of(n);
+        sqlite3_bind_text(insert_, 1, id.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(insert_, 2, room.c_str(), -1, SQLITE_STATIC);
+        sqlite3_step(insert_);
+        sqlite3_reset(insert_);
+      }
+      sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr);
+    }
+
+    std::size_t list(const std::string &room, int limit)
+    {
+      sqlite3_bind_text(list_, 1, room.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int(list_, 2, limit);
+      return drain(list_);
+    }
+
+    std::size_t page(const std::string &room, const std::string &before, int limit)
+    {
+      sqlite3_bind_text(page_, 1, room.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_text(page_, 2, before.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int(page_, 3, limit);
+      return drain(page_);
+    }
+
+    std::size_t replay(const std::string &from, int limit)
+    {
+      sqlite3_bind_text(replay_, 1, from.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int(replay_, 2, limit);
+      return drain(replay_);
+    }
+
+  private:
+    static std::size_t drain(sqlite3_stmt *stmt)
+    {
+      std::size_t rows = 0;
+      while (sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        // Decode the payload like the store does, so only the query differs.
+        const auto *payload = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 5));
+        rows += ws::detail::nlohmann_payload_to_kvs(nlohmann::json::parse(payload)).flat.size() / 2;
+      }
+      sqlite3_reset(stmt);
+      return rows;
+    }
+
+    sqlite3 *db_{nullptr};
+    sqlite3_stmt *insert_{nullptr};
+    sqlite3_stmt *list_{nullptr};
+    sqlite3_stmt *page_{nullptr};
+    sqlite3_stmt *replay_{nullptr};
+  };
+
+  void fill_store(ws::SqliteMessageStore &store, std::uint64_t from, std::uint64_t to)
+  {
+    for (std::uint64_t n = from; n < to; ++n)
+    {
+      ws::JsonMessage m;
+      m.id = make_id(n);
+      m.kind = "event";
+      m.room = room_of(n);
+      m.type = "chat";
+      m.ts = "2025-01-01T00:00:00Z";
+      m.payload = vix::json::kvs{"n", 1};
+      store.append(m);
+    }
+    store.flush();
+  }
+
+  void print_row(const char *name, std::uint64_t rows, const Row &r)
+  {
+    std::printf("%-8s %10llu %10.1f %10.1f %10.1f %10.1f\n",
+                name,
+                static_cast<unsigned long long>(rows),
+                r.busy,
+                r.quiet,
+                r.page,
+                r.replay);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const std::uint64_t maxRows =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000ull;
+
+  ws::SqliteStoreOptions options;
+  options.groupCommitMessages = 4096;
+  ws::SqliteMessageStore store(db_path("vix_ws_history_store.db"), options);
+  LegacyTable legacy;
+
+  std::printf("%-8s %10s %10s %10s %10s %10s\n", "path", "rows", "busy", "quiet", "page", "replay");
+
+  std::uint64_t filled = 0;
+  std::size_t sink = 0;
+  for (std::uint64_t rows = 10000; rows <= maxRows; rows *= 10)
+  {
+    fill_store(store, filled, rows);
+    legacy.fill(filled, rows);
+    filled = rows;
+
+    const std::string middle = make_id(rows / 2);
+
+    // The legacy quiet-room query scans the table; run it less often.
+    const int queries = 200;
+    const int slowQueries = rows >= 1000000 ? 3 : 20;
+
+    Row old;
+    old.busy = us_per_query(queries, [&](int q)
+                            { sink += legacy.list(room_of(static_cast<std::uint64_t>(q) + 1), 50); });
+    old.quiet = us_per_query(slowQueries, [&](int)
+                             { sink += legacy.list("quiet", 50); });
+    old.page = us_per_query(queries, [&](int q)
+                            { sink += legacy.page(room_of(static_cast<std::uint64_t>(q) + 1), middle, 50); });
+    old.replay = us_per_query(queries, [&](int)
+                              { sink += legacy.replay(middle, 100); });
+
+    Row now;
+    now.busy = us_per_query(queries, [&](int q)
+                            { sink += store.list_by_room(room_of(static_cast<std::uint64_t>(q) + 1), 50).size(); });
+    now.quiet = us_per_query(queries, [&](int)
+                             { sink += store.list_by_room("quiet", 50).size(); });
+    now.page = us_per_query(queries, [&](int q)
+                            { sink += store.list_by_room(room_of(static_cast<std::uint64_t>(q) + 1), 50, middle).size(); });
+    now.replay = us_per_query(queries, [&](int)
+                              { sink += store.replay_from(middle, 100).size(); });
+
+    print_row("legacy", rows, old);
+    print_row("store", rows, now);
+  }
+
+  std::printf("(rows read %zu)\n", sink);
+  return 0;
+}
@@ -0,0 +1,190 @@
+#include <vix/websocket/SqliteMessageStore.hpp>
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * SqliteMessageStore append throughput on WAL, plus room history latency.
+ *
+ * "legacy" reproduces the previous append path: prepare, bind, step and
+ * finalize per message, one autocommit transaction each. "cached" keeps the
+ * statement but still commits every append (groupCommitMessages = 1).
+ * "group/N" batches N appends per transaction through the writer thread;
+ * its timing includes the final flush(), so every message is committed.
+ *
+ * Results depend heavily on the file system's fsync cost.
+ */
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+
+  constexpr int MESSAGES = 20000;
+  constexpr int PRODUCERS = 4;
+  constexpr int HISTORY_QUERIES = 2000;
+
+  using clock = std::chrono::steady_clock;
+
+  std::string db_path(const char *name)
+  {
+    const fs::path path = fs::temp_directory_path() / name;
+    for (const char *suffix : {"", "-wal", "-shm"})
+    {
+      fs::remove(path.string() + suffix);
+    }
+    return path.string();
+  }
+
+  ws::JsonMessage make_message(int i)
+  {
+    ws::JsonMessage m;
+    m.kind = "event";
+    m.room = "room-" + std::to_string(i % 16);
+    m.type = "chat.message";
+    m.payload = vix::json::kvs{"user", "bench", "text", "hello from the benchmark", "seq", i};
+    return m;
+  }
+
+  double per_second(int count, clock::duration elapsed)
+  {
+    return count / std::chrono::duration<double>(elapsed).count();
+  }
+
+  double bench_legacy(const std::vector<ws::JsonMessage> &messages)
+  {
+    const std::string path = db_path("vix_ws_bench_legacy.db");
+    {
+      // Creates the schema and WAL mode.
+      ws::SqliteMessageStore schema(path);
+    }
+
+    sqlite3 *db = nullptr;
+    sqlite3_open(path.c_str(), &db);
+
+    const auto t0 = clock::now();
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+      const ws::JsonMessage &m = messages[i];
+      const std::string id = std::to_string(1000000000 + i);
+      const std::string payload = "{\"seq\":" + std::to_string(i) + "}";
+
+      sqlite3_stmt *stmt = nullptr;
+      sqlite3_prepare_v2(
+          db,
+          "INSERT OR REPLACE INTO messages "
+          "(id, kind, room, type, ts, payload_json) "
+          "VALUES (?, ?, ?, ?, ?, ?);",
+          -1, &stmt, nullptr);
+      sqlite3_bind_text(stmt, 1, id.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(stmt, 2, m.kind.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(stmt, 3, m.room.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(stmt, 4, m.type.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(stmt, 5, "2025-01-01T00:00:00Z", -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(stmt, 6, payload.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_step(stmt);
+      sqlite3_finalize(stmt);
+    }
+    const auto elapsed = clock::now() - t0;
+
+    sqlite3_close(db);
+    return per_second(static_cast<int>(messages.size()), elapsed);
+  }
+
+  double bench_store(
+      const char *name,
+      const std::vector<ws::JsonMessage> &messages,
+      std::size_t groupCommit,
+      int producers)
+  {
+    ws::SqliteStoreOptions options;
+    options.groupCommitMessages = groupCommit;
+    ws::SqliteMessageStore store(db_path(name), options);
+
+    const std::size_t perProducer = messages.size() / static_cast<std::size_t>(producers);
+
+    const auto t0 = clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+      threads.emplace_back(
+          [&, p]()
+          {
+            const std::size_t begin = static_cast<std::size_t>(p) * perProducer;
+            for (std::size_t i = begin; i < begin + perProducer; ++i)
+            {
+              ws::JsonMessage m = messages[i];
+              m.id = std::to_string(1000000000 + i);
+              store.append(m);
+            }
+          });
+    }
+    for (auto &t : threads)
+    {
+      t.join();
+    }
+    store.flush();
+
+    return per_second(static_cast<int>(perProducer) * producers, clock::now() - t0);
+  }
+
+  double bench_history(const std::vector<ws::JsonMessage> &messages)
+  {
+    ws::SqliteStoreOptions options;
+    options.groupCommitMessages = 1024;
+    ws::SqliteMessageStore store(db_path("vix_ws_bench_history.db"), options);
+
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+      ws::JsonMessage m = messages[i];
+      m.id = std::to_string(1000000000 + i);
+      store.append(m);
+    }
+    store.flush();
+
+    std::size_t rows = 0;
+    const auto t0 = clock::now();
+    for (int q = 0; q < HISTORY_QUERIES; ++q)
+    {
+      rows += store.list_by_room("room-" + std::to_string(q % 16), 50).size();
+    }
+    const auto elapsed = clock::now() - t0;
+
+    std::printf("(history rows %zu)\n", rows);
+    return std::chrono::duration<double, std::micro>(elapsed).count() / HISTORY_QUERIES;
+  }
+}
+
+int main()
+{
+  std::vector<ws::JsonMessage> messages;
+  messages.reserve(MESSAGES);
+  for (int i = 0; i < MESSAGES; ++i)
+  {
+    messages.push_back(make_message(i));
+  }
+
+  std::printf("%-22s %14s\n", "append path", "msgs/s");
+  std::printf("%-22s %14.0f\n", "legacy", bench_legacy(messages));
+  std::printf("%-22s %14.0f\n", "cached", bench_store("vix_ws_bench_cached.db", messages, 1, 1));
+
+  for (std::size_t n : {64u, 256u, 1024u})
+  {
+    char name[32];
+    std::snprintf(name, sizeof(name), "group/%zu", n);
+    std::printf("%-22s %14.0f\n", name, bench_store("vix_ws_bench_group.db", messages, n, 1));
+
+    std::snprintf(name, sizeof(name), "group/%zu x%d", n, PRODUCERS);
+    std::printf("%-22s %14.0f\n", name, bench_store("vix_ws_bench_group.db", messages, n, PRODUCERS));
+  }
+
+  std::printf("\n%-22s %14.1f\n", "list_by_room us", bench_history(messages));
+  return 0;
+}
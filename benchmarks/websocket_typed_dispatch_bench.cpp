@@ -0,0 +1,120 @@
+#include <vix/websocket/TypedRouteTable.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * Cost of dispatching one typed message as the number of routes grows.
+ *
+ * "linear" reproduces the previous App dispatcher: every route handler is
+ * called for every message and filters on the type itself. "indexed" is
+ * the TypedRouteTable lookup now used by App::on().
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  struct Context
+  {
+    std::size_t hits = 0;
+  };
+
+  using Handler = std::function<void(Context &, const std::string &)>;
+
+  constexpr std::size_t MESSAGES = 200000;
+
+  std::string type_name(std::size_t i)
+  {
+    return "app.domain" + std::to_string(i % 7) + ".event" + std::to_string(i);
+  }
+
+  template <typename Fn>
+  double ns_per_message(Fn &&fn)
+  {
+    using clock = std::chrono::steady_clock;
+
+    fn();
+    const auto start = clock::now();
+    fn();
+    const auto stop = clock::now();
+
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           static_cast<double>(MESSAGES);
+  }
+}
+
+int main()
+{
+  std::printf("%8s %14s %14s %9s\n", "routes", "linear ns/msg", "indexed ns/msg", "speedup");
+
+  const std::size_t routeCounts[] = {1, 8, 16, 64, 256};
+  for (std::size_t routes : routeCounts)
+  {
+    std::vector<std::string> types;
+    for (std::size_t i = 0; i < routes; ++i)
+    {
+      types.push_back(type_name(i));
+    }
+
+    std::vector<Handler> linear;
+    detail::TypedRouteTable<Handler> indexed;
+
+    for (const auto &type : types)
+    {
+      linear.push_back(
+          [type](Context &ctx, const std::string &t)
+          {
+            if (t == type)
+            {
+              ++ctx.hits;
+            }
+          });
+
+      indexed.add(type,
+                  [](Context &ctx, const std::string &)
+                  {
+                    ++ctx.hits;
+                  });
+    }
+
+    Context ctx;
+
+    const double linearNs = ns_per_message(
+        [&]
+        {
+          for (std::size_t m = 0; m < MESSAGES; ++m)
+          {
+            const std::string &type = types[m % routes];
+            for (const auto &handler : linear)
+            {
+              handler(ctx, type);
+            }
+          }
+        });
+
+    const double indexedNs = ns_per_message(
+        [&]
+        {
+          for (std::size_t m = 0; m < MESSAGES; ++m)
+          {
+            const std::string &type = types[m % routes];
+            indexed.dispatch(type, ctx, type);
+          }
+        });
+
+    std::printf("%8zu %14.1f %14.1f %8.1fx\n", routes, linearNs, indexedNs, linearNs / indexedNs);
+
+    if (ctx.hits != 4 * MESSAGES)
+    {
+      std::fprintf(stderr, "dispatch mismatch: %zu hits\n", ctx.hits);
+      return 1;
+    }
+  }
+
+  return 0;
+}
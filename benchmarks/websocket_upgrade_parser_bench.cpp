@@ -0,0 +1,169 @@
+#include <vix/websocket/UpgradeParser.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+/*
+ * Handshake request parsing throughput: every header the server checks
+ * during the upgrade is extracted from a typical browser request.
+ *
+ * "legacy" reproduces the previous path (find the blank line, copy the
+ * head, then one lower-casing scan of the whole head per header lookup).
+ * "parser" is detail::UpgradeParser as used by Session::read_http_head.
+ * Each request arrives in 1 or 3 reads.
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  const std::string request =
+      "GET /chat?room=general HTTP/1.1\r\n"
+      "Host: example.com:8080\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+      "Accept: */*\r\n"
+      "Accept-Language: en-US,en;q=0.5\r\n"
+      "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+      "Sec-WebSocket-Version: 13\r\n"
+      "Origin: https://example.com\r\n"
+      "Sec-WebSocket-Extensions: permessage-deflate\r\n"
+      "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+      "Connection: keep-alive, Upgrade\r\n"
+      "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark\r\n"
+      "Sec-Fetch-Dest: empty\r\n"
+      "Sec-Fetch-Mode: websocket\r\n"
+      "Sec-Fetch-Site: same-origin\r\n"
+      "Pragma: no-cache\r\n"
+      "Cache-Control: no-cache\r\n"
+      "Upgrade: websocket\r\n"
+      "\r\n";
+
+  std::string to_lower_copy(std::string s)
+  {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c)
+                   { return static_cast<char>(std::tolower(c)); });
+    return s;
+  }
+
+  std::string trim_copy(std::string s)
+  {
+    const auto not_space = [](unsigned char c)
+    { return !std::isspace(c); };
+    s.erase(s.begin(), std::find_if(s.begin(), s.end(), not_space));
+    s.erase(std::find_if(s.rbegin(), s.rend(), not_space).base(), s.end());
+    return s;
+  }
+
+  std::string get_header_value(const std::string &raw, const std::string &name)
+  {
+    const std::string needle = to_lower_copy(name) + ":";
+    std::size_t pos = 0;
+    while (pos < raw.size())
+    {
+      const std::size_t line_end = raw.find("\r\n", pos);
+      const std::size_t end = line_end == std::string::npos ? raw.size() : line_end;
+      std::string line = raw.substr(pos, end - pos);
+      std::string lower = to_lower_copy(line);
+      if (lower.rfind(needle, 0) == 0)
+      {
+        return trim_copy(line.substr(needle.size()));
+      }
+      if (line_end == std::string::npos)
+      {
+        break;
+      }
+      pos = line_end + 2;
+    }
+    return {};
+  }
+
+  std::size_t run_legacy(std::size_t reads)
+  {
+    std::string buffer;
+    const std::size_t step = request.size() / reads + 1;
+    std::size_t offset = 0;
+
+    while (true)
+    {
+      const std::size_t n = std::min(step, request.size() - offset);
+      buffer.append(request, offset, n);
+      offset += n;
+
+      const std::size_t pos = buffer.find("\r\n\r\n");
+      if (pos != std::string::npos)
+      {
+        const std::string raw = buffer.substr(0, pos + 4);
+        std::size_t sum = 0;
+        sum += to_lower_copy(get_header_value(raw, "Upgrade")).size();
+        sum += to_lower_copy(get_header_value(raw, "Connection")).size();
+        sum += trim_copy(get_header_value(raw, "Sec-WebSocket-Key")).size();
+        sum += trim_copy(get_header_value(raw, "Sec-WebSocket-Version")).size();
+        sum += get_header_value(raw, "Sec-WebSocket-Extensions").size();
+        return sum;
+      }
+    }
+  }
+
+  std::size_t run_parser(std::size_t reads)
+  {
+    detail::UpgradeParser parser;
+    const std::size_t step = request.size() / reads + 1;
+    std::size_t received = 0;
+
+    while (true)
+    {
+      received = std::min(received + step, request.size());
+      const std::string_view buffer(request.data(), received);
+
+      if (parser.parse(buffer) == detail::UpgradeParser::Status::Complete)
+      {
+        const detail::UpgradeRequest r = parser.request(buffer);
+        return r.upgrade.size() + r.connection.size() + r.key.size() +
+               r.version.size() + r.extensions.lines[0].size();
+      }
+    }
+  }
+
+  template <typename Fn>
+  double handshakes_per_sec(Fn fn, std::size_t reads, std::size_t &sink)
+  {
+    using clock = std::chrono::steady_clock;
+    constexpr std::size_t ITERATIONS = 200000;
+
+    const auto t0 = clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; ++i)
+    {
+      sink += fn(reads);
+    }
+    const auto t1 = clock::now();
+
+    return static_cast<double>(ITERATIONS) /
+           std::chrono::duration<double>(t1 - t0).count();
+  }
+}
+
+int main()
+{
+  std::size_t sink = 0;
+
+  std::printf("request head: %zu bytes\n", request.size());
+  std::printf("%-6s %6s %14s %10s\n", "path", "reads", "handshakes/s", "ns/req");
+
+  for (std::size_t reads : {1, 3})
+  {
+    const double legacy = handshakes_per_sec(run_legacy, reads, sink);
+    const double parser = handshakes_per_sec(run_parser, reads, sink);
+
+    std::printf("%-6s %6zu %14.0f %10.1f\n", "legacy", reads, legacy, 1e9 / legacy);
+    std::printf("%-6s %6zu %14.0f %10.1f\n", "parser", reads, parser, 1e9 / parser);
+  }
+
+  std::printf("(checksum %zu)\n", sink);
+  return 0;
+}
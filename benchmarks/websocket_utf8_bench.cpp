@@ -0,0 +1,142 @@
+#include <vix/websocket/utf8.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define VIX_WS_BENCH_RDTSC 1
+#endif
+
+/*
+ * Validation throughput of every UTF-8 kernel on typical text frame
+ * payloads: pure ASCII JSON, mixed European text and CJK-heavy text.
+ * Cycles are reference (TSC) cycles on x86-64.
+ */
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  std::string make_payload(const char *unit, std::size_t size)
+  {
+    std::string s;
+    while (s.size() < size)
+    {
+      s += unit;
+    }
+    // Cut on a code point boundary.
+    while (!s.empty() && (static_cast<unsigned char>(s.back()) & 0xC0) == 0x80)
+    {
+      s.pop_back();
+    }
+    if (!s.empty() && static_cast<unsigned char>(s.back()) >= 0xC0)
+    {
+      s.pop_back();
+    }
+    return s;
+  }
+
+  struct Result
+  {
+    double gbPerSec;
+    double cyclesPerByte;
+  };
+
+  Result measure(detail::Utf8Kernel kernel, const std::string &payload)
+  {
+    using clock = std::chrono::steady_clock;
+    const auto data = std::span<const std::byte>(
+        reinterpret_cast<const std::byte *>(payload.data()), payload.size());
+
+    const std::size_t iterations = (std::size_t{256} << 20) / payload.size() + 1;
+    std::size_t valid = 0;
+
+    valid += detail::is_valid_utf8_with(kernel, data);
+
+#if defined(VIX_WS_BENCH_RDTSC)
+    const std::uint64_t c0 = __rdtsc();
+#endif
+    const auto t0 = clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      valid += detail::is_valid_utf8_with(kernel, data);
+    }
+    const auto t1 = clock::now();
+#if defined(VIX_WS_BENCH_RDTSC)
+    const std::uint64_t c1 = __rdtsc();
+#endif
+
+    if (valid != iterations + 1)
+    {
+      std::fprintf(stderr, "payload rejected by %s\n", detail::utf8_kernel_name(kernel));
+    }
+
+    const double bytes = static_cast<double>(payload.size()) * static_cast<double>(iterations);
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+    Result r{bytes / ns, 0.0};
+#if defined(VIX_WS_BENCH_RDTSC)
+    r.cyclesPerByte = static_cast<double>(c1 - c0) / bytes;
+#endif
+    return r;
+  }
+}
+
+int main()
+{
+  struct Corpus
+  {
+    const char *name;
+    const char *unit;
+  };
+
+  const Corpus corpora[] = {
+      {"ascii-json", R"({"type":"chat.message","payload":{"room":"general","text":"hello"}})"},
+      {"latin", "Größenmaßstäbe für Übungen à la française, señor. "},
+      {"cjk", "ウェブソケットの検証は速くなければならない。中文测试文本。"},
+  };
+
+  const std::size_t sizes[] = {256, 4096, 65536, 1 << 20};
+  const detail::Utf8Kernel kernels[] = {
+      detail::Utf8Kernel::Scalar,
+      detail::Utf8Kernel::Sse4,
+      detail::Utf8Kernel::Avx2,
+      detail::Utf8Kernel::Neon,
+  };
+
+  std::printf("active kernel: %s\n", detail::utf8_kernel_name(detail::active_utf8_kernel()));
+  std::printf("%-11s %8s %-7s %9s %12s\n", "corpus", "bytes", "kernel", "GB/s", "cycles/byte");
+
+  for (const auto &corpus : corpora)
+  {
+    for (std::size_t size : sizes)
+    {
+      const std::string payload = make_payload(corpus.unit, size);
+
+      for (auto kernel : kernels)
+      {
+        if (!detail::utf8_kernel_supported(kernel))
+        {
+          continue;
+        }
+
+        const Result r = measure(kernel, payload);
+        std::printf("%-11s %8zu %-7s %9.2f %12.3f\n",
+                    corpus.name,
+                    payload.size(),
+                    detail::utf8_kernel_name(kernel),
+                    r.gbPerSec,
+                    r.cyclesPerByte);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -30,6 +30,7 @@
 #include <nlohmann/json.hpp>
 
 #include <vix.hpp>
+#include <vix/websocket/AsyncMessageStore.hpp>
 #include <vix/websocket/AttachedRuntime.hpp>
 #include <vix/websocket/SqliteMessageStore.hpp>
 
@@ -165,7 +166,12 @@ namespace
   struct ChatPersistentState
   {
     ChatRoomRegistry registry;
-    vix::websocket::SqliteMessageStore store{"storage/chat_rooms.db"};
+    // Commits every append (no group commit), so a Stored receipt from the
+    // async store below means the message is on disk.
+    vix::websocket::SqliteMessageStore sqlite{"storage/chat_rooms.db"};
+    // Handlers only queue appends; a writer thread pays for the disk.
+    // Declared after sqlite, so it drains before the database closes.
+    vix::websocket::AsyncMessageStore store{sqlite};
   };
 
   /**
@@ -522,6 +528,8 @@ namespace
           res.json({
               {"rooms", static_cast<int>(state->registry.room_count())},
               {"members", static_cast<int>(state->registry.member_count())},
+              {"store_queue_depth", static_cast<int>(state->store.depth())},
+              {"store_queue_high_water", static_cast<int>(state->store.high_water())},
           });
         });
   }
@@ -192,7 +192,10 @@ namespace
 
     runtime.metrics.messages_out_total.fetch_add(1, std::memory_order_relaxed);
 
-    runtime.ws.broadcast_json(
+    // Only the latest snapshot matters: a client that has not read the
+    // previous one yet gets it replaced instead of queued behind it.
+    runtime.ws.broadcast_json_conflated(
+        "dashboard.snapshot",
         "dashboard.snapshot",
         {
             "service",
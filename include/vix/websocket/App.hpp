@@ -25,6 +25,7 @@
 #include <vix/json/Simple.hpp>
 #include <vix/websocket/protocol.hpp>
 #include <vix/websocket/server.hpp>
+#include <vix/websocket/TypedRouteTable.hpp>
 
 namespace vix::websocket
 {
@@ -77,6 +78,19 @@ namespace vix::websocket
      */
     [[nodiscard]] App &ws(const std::string &endpoint, TypedHandler handler);
 
+    /**
+     * @brief Register a handler for one typed message type.
+     *
+     * Unlike ws(), which sees every message, the handler is only invoked
+     * for messages whose type equals @p type; dispatch is a single hash
+     * lookup regardless of how many types are registered.
+     *
+     * @param type Message type to match exactly.
+     * @param handler Typed message handler.
+     * @return Current app instance.
+     */
+    [[nodiscard]] App &on(const std::string &type, TypedHandler handler);
+
     /**
      * @brief Run the WebSocket server in blocking mode.
      */
@@ -126,18 +140,23 @@ namespace vix::websocket
     struct Route
     {
       std::string endpoint;
+      std::string type;
       TypedHandler handler;
     };
 
+    /** @brief Immutable route index shared with the installed dispatcher. */
+    using RouteTable = detail::TypedRouteTable<TypedHandler>;
+
     /**
-     * @brief Install the internal typed-message dispatcher.
+     * @brief Rebuild the route index and install the typed-message dispatcher.
      */
     void install_dispatcher();
 
     /**
-     * @brief Dispatch one typed message to all registered handlers.
+     * @brief Dispatch one typed message to the handlers matching its type.
      */
-    void dispatch_typed_message(
+    static void dispatch_typed_message(
+        const RouteTable &table,
         Session &session,
         const std::string &type,
         const vix::json::kvs &payload);
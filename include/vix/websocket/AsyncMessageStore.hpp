@@ -0,0 +1,244 @@
+/**
+ *
+ *  @file AsyncMessageStore.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_ASYNC_MESSAGE_STORE_HPP
+#define VIX_WEBSOCKET_ASYNC_MESSAGE_STORE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vix/websocket/MessageStore.hpp>
+#include <vix/websocket/Metrics.hpp>
+#include <vix/websocket/MpscQueue.hpp>
+#include <vix/websocket/protocol.hpp>
+
+namespace vix::websocket
+{
+  /**
+   * @brief Outcome of an asynchronous store write.
+   */
+  enum class StoreWriteStatus : std::uint8_t
+  {
+    /**
+     * @brief The inner store's append() returned.
+     *
+     * Durable only if the inner store commits inside append(); with
+     * SqliteMessageStore group commit the message is merely queued there.
+     */
+    Stored,
+
+    /** @brief The inner store's append() threw; see StoreReceipt::error. */
+    Failed,
+
+    /** @brief Never queued: the queue was full or the store was shutting down. */
+    Rejected,
+  };
+
+  /**
+   * @brief Report delivered to a store-write callback.
+   */
+  struct StoreReceipt
+  {
+    StoreWriteStatus status{StoreWriteStatus::Rejected};
+
+    /** @brief Exception message when status is Failed. */
+    std::string error{};
+
+    /** @brief Writes already queued when this one was accepted. */
+    std::size_t queuePosition{0};
+
+    /** @brief True if the message reached the inner store. */
+    bool ok() const noexcept
+    {
+      return status == StoreWriteStatus::Stored;
+    }
+  };
+
+  /**
+   * @brief Callback run once per asynchronous write, on the writer thread.
+   */
+  using StoreCallback = std::function<void(const StoreReceipt &)>;
+
+  /**
+   * @brief Settings of AsyncMessageStore.
+   */
+  struct AsyncStoreOptions
+  {
+    /** @brief Most writes accepted and not yet completed, the one being stored included. */
+    std::size_t capacity = 8192;
+
+    /**
+     * @brief What a write does when the queue is full.
+     *
+     * True waits for room (backpressure on the caller); false rejects the
+     * write at once so the caller never waits on the disk.
+     */
+    bool blockWhenFull = true;
+  };
+
+  /**
+   * @brief IMessageStore that moves appends onto a dedicated writer thread.
+   *
+   * Appends go into a bounded lock-free MPSC queue and return; one writer
+   * thread hands them to the wrapped store in submission order, so a slow
+   * fsync stalls the writer instead of the I/O threads that called append().
+   *
+   * Reads flush() first, so they see every write accepted before them,
+   * then go to the wrapped store, which must be safe to read while the
+   * writer appends (SqliteMessageStore and LogMessageStore are). From a
+   * write callback they do not wait.
+   *
+   * Shutdown (explicit or from the destructor) rejects new writes, waits
+   * for every queued write to reach the wrapped store and joins the writer.
+   * A write callback may call shutdown(), which then returns without
+   * joining, but must not destroy the store: the writer thread is still
+   * running inside it. A write callback may also append; when the queue is
+   * full that write is rejected even with blockWhenFull, since only the
+   * writer thread could make room.
+   */
+  class AsyncMessageStore : public IMessageStore
+  {
+  public:
+    /**
+     * @brief Wrap @p inner and start the writer thread.
+     *
+     * @param inner Store written by the writer thread; must outlive this object.
+     * @param options Queue capacity and overflow behavior.
+     * @param metrics Optional metrics collector (may be null).
+     */
+    explicit AsyncMessageStore(
+        IMessageStore &inner,
+        AsyncStoreOptions options = {},
+        WebSocketMetrics *metrics = nullptr);
+
+    /**
+     * @brief Shut down and join the writer.
+     *
+     * Must not run on the writer thread, i.e. from a write callback.
+     */
+    ~AsyncMessageStore() override;
+
+    AsyncMessageStore(const AsyncMessageStore &) = delete;
+    AsyncMessageStore &operator=(const AsyncMessageStore &) = delete;
+
+    /** @brief Queue @p msg without tracking it. */
+    void append(const JsonMessage &msg) override;
+
+    /**
+     * @brief Queue @p msg and report its outcome.
+     *
+     * @param msg Message to store.
+     * @param callback Run once on the writer thread, or inline when rejected.
+     * @return False if the write was rejected.
+     */
+    bool append(JsonMessage msg, StoreCallback callback);
+
+    /** @brief Queue @p msg; the future resolves when the write completes. */
+    [[nodiscard]] std::future<StoreReceipt> append_future(JsonMessage msg);
+
+    /** @brief Block until every write accepted before this call has completed. */
+    void flush();
+
+    /**
+     * @brief Reject new writes, drain the queue and join the writer. Idempotent.
+     *
+     * From a write callback it only stops the store; the writer exits once
+     * the queue is drained and the destructor joins it.
+     */
+    void shutdown();
+
+    [[nodiscard]] std::vector<JsonMessage> list_by_room(
+        const std::string &room,
+        std::size_t limit,
+        const std::optional<std::string> &before_id = std::nullopt) override;
+
+    [[nodiscard]] std::vector<JsonMessage> replay_from(
+        const std::string &start_id,
+        std::size_t limit) override;
+
+    /** @brief Writes accepted and not yet completed. */
+    [[nodiscard]] std::size_t depth() const noexcept
+    {
+      return depth_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Deepest the queue has been. */
+    [[nodiscard]] std::size_t high_water() const noexcept
+    {
+      return highWater_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Writes completed, stored or failed. */
+    [[nodiscard]] std::uint64_t completed() const noexcept
+    {
+      return completed_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Write
+    {
+      JsonMessage msg{};
+      StoreCallback callback{};
+      std::size_t queuePosition{0};
+    };
+
+    bool submit(Write write);
+    void release_slot();
+    void reject(StoreCallback &callback);
+    void complete(Write &write);
+    void writer_loop();
+    void wake_writer();
+    void notify_waiters();
+
+    IMessageStore &inner_;
+    AsyncStoreOptions options_;
+    WebSocketMetrics *metrics_;
+
+    detail::MpscQueue<Write> queue_;
+
+    /** @brief Accepted writes not yet completed; bounds the queue. */
+    std::atomic<std::size_t> depth_{0};
+    std::atomic<std::size_t> highWater_{0};
+
+    /** @brief Writes pushed; flush() waits for completed_ to reach it. */
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> completed_{0};
+
+    std::atomic<bool> stopping_{false};
+
+    /** @brief True while the writer is about to sleep or sleeping. */
+    std::atomic<bool> writerIdle_{false};
+
+    /** @brief Threads blocked in flush() or on a full queue. */
+    std::atomic<std::size_t> waiters_{0};
+
+    std::mutex mutex_;
+    std::condition_variable writerCv_;
+    std::condition_variable waitersCv_;
+
+    std::mutex shutdownMutex_;
+    std::thread writer_;
+  };
+
+} // namespace vix::websocket
+
+#endif // VIX_WEBSOCKET_ASYNC_MESSAGE_STORE_HPP
@@ -0,0 +1,419 @@
+/**
+ *
+ *  @file CoreGroup.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_CORE_GROUP_HPP
+#define VIX_WEBSOCKET_CORE_GROUP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <vix/websocket/MpscQueue.hpp>
+
+namespace vix::websocket::detail
+{
+  /** @brief Index of a core that owns no thread. */
+  inline constexpr std::size_t NO_CORE = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Core owned by the calling thread, or NO_CORE.
+   *
+   * Set once by each IO thread of a shared-nothing engine.
+   */
+  inline thread_local std::size_t this_core = NO_CORE;
+
+  /**
+   * @brief Shared-nothing session ownership across cores.
+   *
+   * Each core owns a disjoint set of sessions and the room memberships of
+   * those sessions, in plain containers touched only by the core's own
+   * thread. Nothing is locked: work for a core is either run inline, when
+   * the caller already is that core, or pushed on the core's lock-free MPSC
+   * inbox. The first push into an idle inbox asks the core's thread to
+   * drain it through the wake callback, so a burst costs one wake-up.
+   *
+   * A broadcast sends one command per core; every core fans out to its own
+   * members in parallel, which is what lets fan-out scale with cores.
+   *
+   * @tparam SessionT Session type, owned through std::shared_ptr.
+   */
+  template <typename SessionT>
+  class BasicCoreGroup
+  {
+  public:
+    using RoomId = std::string;
+    using SessionPtr = std::shared_ptr<SessionT>;
+    using SessionFn = std::function<void(SessionT &)>;
+
+    /**
+     * @brief Run a callable on the thread that owns a core.
+     *
+     * @param core Target core.
+     * @param fn Work to run on that core's thread.
+     */
+    using WakeFn = std::function<void(std::size_t core, std::function<void()> fn)>;
+
+    BasicCoreGroup(std::size_t cores, WakeFn wake)
+        : wake_(std::move(wake))
+    {
+      cores_.reserve(cores);
+      for (std::size_t i = 0; i < cores; ++i)
+      {
+        cores_.push_back(std::make_unique<Core>());
+      }
+    }
+
+    /** @brief Number of cores. */
+    std::size_t size() const noexcept
+    {
+      return cores_.size();
+    }
+
+    /** @brief Number of sessions owned across all cores. */
+    std::size_t session_count() const noexcept
+    {
+      return sessionCount_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Give @p session to @p core. Idempotent.
+     */
+    void add(std::size_t core, SessionPtr session)
+    {
+      run_on(
+          core,
+          [this, session = std::move(session)](Core &c)
+          {
+            entry_for(c, session);
+          });
+    }
+
+    /**
+     * @brief Forget a session and drop it from the rooms it joined.
+     */
+    void remove(std::size_t core, const SessionT *session)
+    {
+      run_on(
+          core,
+          [this, session](Core &c)
+          {
+            auto it = c.sessions.find(session);
+            if (it == c.sessions.end())
+            {
+              return;
+            }
+
+            for (const RoomId &room : it->second.rooms)
+            {
+              drop_member(c, room, session);
+            }
+
+            c.sessions.erase(it);
+            sessionCount_.fetch_sub(1, std::memory_order_relaxed);
+          });
+    }
+
+    /**
+     * @brief Add a session to a room on its core. Idempotent.
+     */
+    void join(std::size_t core, SessionPtr session, RoomId room)
+    {
+      run_on(
+          core,
+          [this, session = std::move(session), room = std::move(room)](Core &c)
+          {
+            auto &rooms = entry_for(c, session).rooms;
+            if (std::find(rooms.begin(), rooms.end(), room) != rooms.end())
+            {
+              return;
+            }
+
+            rooms.push_back(room);
+            c.rooms[room].push_back(session);
+          });
+    }
+
+    /**
+     * @brief Remove a session from one room.
+     */
+    void leave(std::size_t core, const SessionT *session, RoomId room)
+    {
+      run_on(
+          core,
+          [session, room = std::move(room)](Core &c)
+          {
+            auto it = c.sessions.find(session);
+            if (it == c.sessions.end())
+            {
+              return;
+            }
+
+            auto &rooms = it->second.rooms;
+            auto pos = std::find(rooms.begin(), rooms.end(), room);
+            if (pos == rooms.end())
+            {
+              return;
+            }
+
+            rooms.erase(pos);
+            drop_member(c, room, session);
+          });
+    }
+
+    /**
+     * @brief Remove a session from every room while keeping it owned.
+     */
+    void leave_all(std::size_t core, const SessionT *session)
+    {
+      run_on(
+          core,
+          [session](Core &c)
+          {
+            auto it = c.sessions.find(session);
+            if (it == c.sessions.end())
+            {
+              return;
+            }
+
+            for (const RoomId &room : it->second.rooms)
+            {
+              drop_member(c, room, session);
+            }
+            it->second.rooms.clear();
+          });
+    }
+
+    /**
+     * @brief Invoke @p fn for every live session, each on its own core.
+     *
+     * Returns before the cores have run; @p fn is copied once per core.
+     */
+    void broadcast(SessionFn fn)
+    {
+      for (std::size_t i = 0; i < cores_.size(); ++i)
+      {
+        run_on(
+            i,
+            [this, fn](Core &c)
+            {
+              for (auto it = c.sessions.begin(); it != c.sessions.end();)
+              {
+                if (auto s = it->second.session.lock())
+                {
+                  fn(*s);
+                  ++it;
+                }
+                else
+                {
+                  for (const RoomId &room : it->second.rooms)
+                  {
+                    drop_member(c, room, it->first);
+                  }
+                  it = c.sessions.erase(it);
+                  sessionCount_.fetch_sub(1, std::memory_order_relaxed);
+                }
+              }
+            });
+      }
+    }
+
+    /**
+     * @brief Invoke @p fn for every live member of @p room, each on its core.
+     *
+     * Returns before the cores have run; @p fn is copied once per core.
+     */
+    void broadcast_room(const RoomId &room, SessionFn fn)
+    {
+      auto shared = std::make_shared<const RoomId>(room);
+
+      for (std::size_t i = 0; i < cores_.size(); ++i)
+      {
+        run_on(
+            i,
+            [shared, fn](Core &c)
+            {
+              auto it = c.rooms.find(*shared);
+              if (it == c.rooms.end())
+              {
+                return;
+              }
+
+              auto &members = it->second;
+              members.erase(
+                  std::remove_if(
+                      members.begin(),
+                      members.end(),
+                      [&fn](const std::weak_ptr<SessionT> &weak)
+                      {
+                        auto s = weak.lock();
+                        if (!s)
+                        {
+                          return true;
+                        }
+                        fn(*s);
+                        return false;
+                      }),
+                  members.end());
+
+              if (members.empty())
+              {
+                c.rooms.erase(it);
+              }
+            });
+      }
+    }
+
+  private:
+    struct Entry
+    {
+      std::weak_ptr<SessionT> session;
+      std::vector<RoomId> rooms;
+    };
+
+    struct Core;
+    using Command = std::function<void(Core &)>;
+
+    struct Core
+    {
+      /** @brief Work pushed by other threads. */
+      MpscQueue<Command> inbox;
+
+      /** @brief True while a drain is scheduled or running. */
+      std::atomic<bool> scheduled{false};
+
+      std::unordered_map<const SessionT *, Entry> sessions;
+      std::unordered_map<RoomId, std::vector<std::weak_ptr<SessionT>>> rooms;
+    };
+
+    template <typename Fn>
+    void run_on(std::size_t core, Fn &&fn)
+    {
+      if (core >= cores_.size())
+      {
+        return;
+      }
+
+      Core &c = *cores_[core];
+
+      if (this_core == core)
+      {
+        fn(c);
+        return;
+      }
+
+      c.inbox.push(Command(std::forward<Fn>(fn)));
+
+      if (!c.scheduled.exchange(true, std::memory_order_acq_rel))
+      {
+        wake_(core, [this, core]()
+              { drain(core); });
+      }
+    }
+
+    void drain(std::size_t core)
+    {
+      Core &c = *cores_[core];
+      Command cmd;
+
+      while (true)
+      {
+        while (c.inbox.pop(cmd))
+        {
+          cmd(c);
+        }
+
+        // Reading the flag back synchronizes with producers that saw it
+        // set, so their pushes are visible to the empty() check below.
+        c.scheduled.exchange(false, std::memory_order_acq_rel);
+
+        if (c.inbox.empty() ||
+            c.scheduled.exchange(true, std::memory_order_acq_rel))
+        {
+          return;
+        }
+      }
+    }
+
+    /**
+     * @brief Entry of @p session on @p c, created if needed.
+     *
+     * An entry whose session expired without remove() belongs to a dead
+     * session at the same address; its rooms are left before it is reused.
+     */
+    Entry &entry_for(Core &c, const SessionPtr &session)
+    {
+      auto [it, inserted] = c.sessions.try_emplace(session.get());
+      Entry &entry = it->second;
+
+      if (inserted)
+      {
+        sessionCount_.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (entry.session.expired())
+      {
+        for (const RoomId &room : entry.rooms)
+        {
+          drop_member(c, room, session.get());
+        }
+        entry.rooms.clear();
+      }
+      else
+      {
+        return entry;
+      }
+
+      entry.session = session;
+      return entry;
+    }
+
+    static void drop_member(Core &c, const RoomId &room, const SessionT *session)
+    {
+      auto it = c.rooms.find(room);
+      if (it == c.rooms.end())
+      {
+        return;
+      }
+
+      auto &members = it->second;
+      members.erase(
+          std::remove_if(
+              members.begin(),
+              members.end(),
+              [session](const std::weak_ptr<SessionT> &weak)
+              {
+                auto s = weak.lock();
+                return !s || s.get() == session;
+              }),
+          members.end());
+
+      if (members.empty())
+      {
+        c.rooms.erase(it);
+      }
+    }
+
+    WakeFn wake_;
+    std::vector<std::unique_ptr<Core>> cores_;
+    std::atomic<std::size_t> sessionCount_{0};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_CORE_GROUP_HPP
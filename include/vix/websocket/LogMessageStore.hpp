@@ -0,0 +1,184 @@
+/**
+ *
+ *  @file LogMessageStore.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_LOG_MESSAGE_STORE_HPP
+#define VIX_WEBSOCKET_LOG_MESSAGE_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/websocket/MessageId.hpp>
+#include <vix/websocket/MessageStore.hpp>
+#include <vix/websocket/protocol.hpp>
+
+namespace vix::websocket
+{
+  /**
+   * @brief Settings of LogMessageStore.
+   */
+  struct LogStoreOptions
+  {
+    /** @brief Size of each segment file; a larger record gets its own segment. */
+    std::size_t segmentBytes = 64 * 1024 * 1024;
+
+    /** @brief One sparse index entry per this many records (global and per room). */
+    std::size_t indexInterval = 64;
+
+    /** @brief fdatasync() after every append instead of only in flush(). */
+    bool syncEveryAppend = false;
+  };
+
+  /**
+   * @brief Append-only, segmented, file-backed message store.
+   *
+   * Messages are written as length-prefixed, CRC-checked binary records to
+   * fixed-size segment files in one directory and read back through
+   * read-only memory maps. Each record links to the previous record of its
+   * room, so a room page follows those links instead of scanning; sparse
+   * id indexes, one global and one per room, place id cursors.
+   *
+   * The indexes live in memory and are rebuilt by scanning the segments
+   * when the store is opened; a torn record at the tail ends the log.
+   * Like SqliteMessageStore, cursors assume ids increase in append order,
+   * which generated ids do. Appending an id twice stores two records.
+   *
+   * POSIX only (pwrite and mmap).
+   */
+  class LogMessageStore : public IMessageStore
+  {
+  public:
+    /**
+     * @brief Open or create a log store in @p directory.
+     *
+     * @param directory Directory holding the segment files; created if missing.
+     * @param options Segment size, index density and sync policy.
+     */
+    explicit LogMessageStore(const std::string &directory, LogStoreOptions options = {});
+
+    ~LogMessageStore() override;
+
+    LogMessageStore(const LogMessageStore &) = delete;
+    LogMessageStore &operator=(const LogMessageStore &) = delete;
+    LogMessageStore(LogMessageStore &&) = delete;
+    LogMessageStore &operator=(LogMessageStore &&) = delete;
+
+    /** @brief Append a message record. */
+    void append(const JsonMessage &msg) override;
+
+    /** @brief fdatasync() the active segment. */
+    void flush();
+
+    /**
+     * @brief List messages of a room, newest first.
+     *
+     * @param room Room identifier.
+     * @param limit Maximum number of messages.
+     * @param before_id Only messages with a smaller id.
+     */
+    [[nodiscard]] std::vector<JsonMessage> list_by_room(
+        const std::string &room,
+        std::size_t limit,
+        const std::optional<std::string> &before_id = std::nullopt) override;
+
+    /**
+     * @brief Messages with an id greater than @p start_id, oldest first.
+     *
+     * @param start_id Cursor id; empty replays from the beginning.
+     * @param limit Maximum number of messages.
+     */
+    [[nodiscard]] std::vector<JsonMessage> replay_from(
+        const std::string &start_id,
+        std::size_t limit) override;
+
+    /** @brief Number of records in the log. */
+    std::uint64_t size() const;
+
+  private:
+    /** @brief Record position: segment number in the high, offset in the low 32 bits. */
+    using Location = std::uint64_t;
+
+    static constexpr Location NO_LOCATION = ~Location{0};
+
+    struct Segment;
+
+    /** @brief Sparse index entry: id of the record at @ref location. */
+    struct IndexEntry
+    {
+      std::string id;
+      Location location{NO_LOCATION};
+    };
+
+    struct RoomIndex
+    {
+      /** @brief Newest record of the room. */
+      Location last{NO_LOCATION};
+
+      /** @brief Records of the room so far. */
+      std::uint64_t count{0};
+
+      /** @brief Every indexInterval-th record of the room. */
+      std::vector<IndexEntry> sparse{};
+    };
+
+    /** @brief Record decoded from a segment; strings point into the map. */
+    struct RecordView;
+
+    std::string directory_;
+    LogStoreOptions options_;
+
+    /** @brief Appends exclusive, reads shared. */
+    mutable std::shared_mutex mutex_;
+
+    std::vector<std::unique_ptr<Segment>> segments_;
+    std::unordered_map<std::string, RoomIndex> rooms_;
+
+    /** @brief Every indexInterval-th record of the log. */
+    std::vector<IndexEntry> sparse_;
+
+    std::uint64_t records_{0};
+
+    /** @brief Reused encode buffer of append(). */
+    std::vector<std::byte> scratch_;
+
+    detail::MonotonicIdGenerator ids_{};
+
+    void open_segments();
+    Segment &open_segment(std::uint32_t number, bool create, std::size_t bytes);
+    Segment &writable_segment(std::size_t recordBytes);
+
+    /**
+     * @brief Decode the record at @p location, or nullopt past the end.
+     *
+     * @param verify Also check the CRC (recovery scan).
+     */
+    std::optional<RecordView> read(Location location, bool verify = false) const;
+
+    /** @brief Location following the record at @p location. */
+    Location next(Location location, const RecordView &record) const;
+
+    /** @brief Add the record at @p location to the in-memory indexes. */
+    void index(Location location, std::string_view id, std::string_view room);
+
+    static JsonMessage to_message(const RecordView &record);
+  };
+
+} // namespace vix::websocket
+
+#endif // VIX_WEBSOCKET_LOG_MESSAGE_STORE_HPP
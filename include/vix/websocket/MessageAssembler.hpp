@@ -0,0 +1,152 @@
+/**
+ *
+ *  @file MessageAssembler.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_MESSAGE_ASSEMBLER_HPP
+#define VIX_WEBSOCKET_MESSAGE_ASSEMBLER_HPP
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <vix/websocket/protocol.hpp>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Reassembly state for fragmented WebSocket data messages.
+   *
+   * Tracks the opcode of the message in progress, validates the
+   * Text/Binary → Continuation* sequence required by RFC 6455 §5.4 and
+   * enforces a maximum message size across all fragments.
+   *
+   * Two ways to consume it:
+   * - buffered: append() every fragment payload and take() the contiguous
+   *   message once the FIN fragment has been accepted;
+   * - streaming: only call begin_frame() for accounting and forward the
+   *   payload bytes elsewhere, so the message is never resident.
+   *
+   * Control frames are not fragments and must not be passed here.
+   */
+  class MessageAssembler
+  {
+  public:
+    explicit MessageAssembler(std::size_t maxMessageSize) noexcept
+        : maxMessageSize_(maxMessageSize)
+    {
+    }
+
+    /**
+     * @brief Account for the header of one data frame.
+     *
+     * @param opcode Frame opcode (Text, Binary or Continuation).
+     * @param fin FIN bit of the frame.
+     * @param payloadLength Payload length announced by the frame header.
+     * @return Opcode of the message the frame belongs to (Text or Binary).
+     *
+     * @throws std::runtime_error on an unexpected continuation, a new data
+     *         frame while a message is in progress, or when the message
+     *         would exceed the maximum size.
+     */
+    Opcode begin_frame(Opcode opcode, bool fin, std::size_t payloadLength)
+    {
+      if (opcode == Opcode::Continuation)
+      {
+        if (!inProgress_)
+        {
+          throw std::runtime_error("websocket continuation frame without a message in progress");
+        }
+      }
+      else if (opcode == Opcode::Text || opcode == Opcode::Binary)
+      {
+        if (inProgress_)
+        {
+          throw std::runtime_error("websocket data frame received while a fragmented message is in progress");
+        }
+
+        opcode_ = opcode;
+        messageSize_ = 0;
+        buffer_.clear();
+      }
+      else
+      {
+        throw std::runtime_error("websocket control frame passed to message assembler");
+      }
+
+      if (payloadLength > maxMessageSize_ - messageSize_)
+      {
+        throw std::runtime_error("websocket message exceeds max message size");
+      }
+
+      messageSize_ += payloadLength;
+      inProgress_ = !fin;
+      return opcode_;
+    }
+
+    /** @brief Append fragment payload bytes (buffered mode). */
+    void append(std::span<const std::byte> payload)
+    {
+      buffer_.append(reinterpret_cast<const char *>(payload.data()), payload.size());
+    }
+
+    /**
+     * @brief Move the reassembled message out (buffered mode).
+     *
+     * Call once the FIN fragment has been accepted and appended.
+     */
+    std::string take()
+    {
+      std::string out;
+      out.swap(buffer_);
+      return out;
+    }
+
+    /** @brief True while a fragmented message awaits its FIN fragment. */
+    bool in_progress() const noexcept
+    {
+      return inProgress_;
+    }
+
+    /** @brief Opcode of the current (or last) message. */
+    Opcode opcode() const noexcept
+    {
+      return opcode_;
+    }
+
+    /** @brief Payload bytes accounted for the current (or last) message. */
+    std::size_t message_size() const noexcept
+    {
+      return messageSize_;
+    }
+
+    /** @brief Drop any partial message. */
+    void reset() noexcept
+    {
+      inProgress_ = false;
+      opcode_ = Opcode::Text;
+      messageSize_ = 0;
+      buffer_.clear();
+    }
+
+  private:
+    std::size_t maxMessageSize_;
+    bool inProgress_{false};
+    Opcode opcode_{Opcode::Text};
+    std::size_t messageSize_{0};
+    std::string buffer_{};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_MESSAGE_ASSEMBLER_HPP
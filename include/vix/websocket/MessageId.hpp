@@ -0,0 +1,124 @@
+/**
+ *
+ *  @file MessageId.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_MESSAGE_ID_HPP
+#define VIX_WEBSOCKET_MESSAGE_ID_HPP
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Lock-free generator of strictly increasing message ids.
+   *
+   * An id is the wall clock in nanoseconds since the epoch, raised to one
+   * past the previous id when the clock has not advanced or stepped back.
+   * Ids never repeat within a generator and keep increasing across clock
+   * corrections; under sustained bursts above one id per nanosecond they
+   * run ahead of the clock until it catches up.
+   *
+   * Ids are written as 20 zero-padded decimal digits, so string order is
+   * numeric order and they sort after the microsecond ids written before.
+   */
+  class MonotonicIdGenerator
+  {
+  public:
+    /** @brief Width of a formatted id. */
+    static constexpr std::size_t ID_DIGITS = 20;
+
+    /** @brief Next id as a number, using the system clock. */
+    std::uint64_t next_value() noexcept
+    {
+      const auto now = std::chrono::system_clock::now().time_since_epoch();
+      return next_value(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    }
+
+    /** @brief Next id as a number for the clock reading @p nowNs. */
+    std::uint64_t next_value(std::uint64_t nowNs) noexcept
+    {
+      std::uint64_t last = last_.load(std::memory_order_relaxed);
+      std::uint64_t id = 0;
+
+      do
+      {
+        id = nowNs > last ? nowNs : last + 1;
+      } while (!last_.compare_exchange_weak(
+          last, id, std::memory_order_relaxed, std::memory_order_relaxed));
+
+      return id;
+    }
+
+    /** @brief Next id, formatted. */
+    std::string next()
+    {
+      return format(next_value());
+    }
+
+    /**
+     * @brief Make every later id greater than @p value.
+     *
+     * Used to resume after the highest id already stored.
+     */
+    void observe(std::uint64_t value) noexcept
+    {
+      std::uint64_t last = last_.load(std::memory_order_relaxed);
+      while (value > last &&
+             !last_.compare_exchange_weak(
+                 last, value, std::memory_order_relaxed, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    /** @brief Format @p value as ID_DIGITS zero-padded digits. */
+    static std::string format(std::uint64_t value)
+    {
+      std::string out(ID_DIGITS, '0');
+      char digits[ID_DIGITS];
+      const auto result = std::to_chars(digits, digits + ID_DIGITS, value);
+      const std::size_t n = static_cast<std::size_t>(result.ptr - digits);
+      out.replace(ID_DIGITS - n, n, digits, n);
+      return out;
+    }
+
+    /** @brief Parse an id written by format(); nullopt for other strings. */
+    static std::optional<std::uint64_t> parse(std::string_view id) noexcept
+    {
+      if (id.size() != ID_DIGITS)
+      {
+        return std::nullopt;
+      }
+
+      std::uint64_t value = 0;
+      const auto result = std::from_chars(id.data(), id.data() + id.size(), value);
+      if (result.ec != std::errc{} || result.ptr != id.data() + id.size())
+      {
+        return std::nullopt;
+      }
+      return value;
+    }
+
+  private:
+    std::atomic<std::uint64_t> last_{0};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_MESSAGE_ID_HPP
@@ -49,6 +49,47 @@ namespace vix::websocket
     /** @brief Total errors observed (counter). */
     std::atomic<std::uint64_t> errors_total{0};
 
+    /** @brief Flushes of a session write queue, one write batch each (counter). */
+    std::atomic<std::uint64_t> write_batches_total{0};
+    /** @brief Messages written across all flush batches (counter). */
+    std::atomic<std::uint64_t> write_batch_messages_total{0};
+
+    /** @brief Queued messages discarded by a drop backpressure policy (counter). */
+    std::atomic<std::uint64_t> backpressure_dropped_total{0};
+    /** @brief Queued messages superseded by a newer one with the same key (counter). */
+    std::atomic<std::uint64_t> backpressure_conflated_total{0};
+    /** @brief Sessions closed because their write queue overflowed (counter). */
+    std::atomic<std::uint64_t> backpressure_closes_total{0};
+    /** @brief Deepest session write queue seen, in messages (gauge). */
+    std::atomic<std::uint64_t> write_queue_high_water_messages{0};
+    /** @brief Deepest session write queue seen, in payload bytes (gauge). */
+    std::atomic<std::uint64_t> write_queue_high_water_bytes{0};
+
+    /** @brief Outbound messages sent compressed with permessage-deflate (counter). */
+    std::atomic<std::uint64_t> deflate_messages_total{0};
+    /** @brief Uncompressed bytes fed to the compressor (counter). */
+    std::atomic<std::uint64_t> deflate_bytes_in_total{0};
+    /** @brief Compressed bytes produced by the compressor (counter). */
+    std::atomic<std::uint64_t> deflate_bytes_out_total{0};
+
+    /** @brief Inbound compressed messages inflated (counter). */
+    std::atomic<std::uint64_t> inflate_messages_total{0};
+    /** @brief Compressed bytes received (counter). */
+    std::atomic<std::uint64_t> inflate_bytes_in_total{0};
+    /** @brief Bytes produced by inflating received messages (counter). */
+    std::atomic<std::uint64_t> inflate_bytes_out_total{0};
+
+    /** @brief Writes queued for an AsyncMessageStore writer (gauge). */
+    std::atomic<std::uint64_t> store_queue_depth{0};
+    /** @brief Deepest AsyncMessageStore queue seen (gauge). */
+    std::atomic<std::uint64_t> store_queue_high_water{0};
+    /** @brief Writes handed to the wrapped store (counter). */
+    std::atomic<std::uint64_t> store_writes_total{0};
+    /** @brief Writes whose wrapped-store append threw (counter). */
+    std::atomic<std::uint64_t> store_write_failures_total{0};
+    /** @brief Writes rejected on a full queue or during shutdown (counter). */
+    std::atomic<std::uint64_t> store_writes_rejected_total{0};
+
     /** @brief Total long-polling sessions created (counter). */
     std::atomic<std::uint64_t> lp_sessions_total{0};
     /** @brief Current number of active long-polling sessions (gauge). */
@@ -64,6 +105,18 @@ namespace vix::websocket
     /** @brief Total messages drained from LP buffers (counter). */
     std::atomic<std::uint64_t> lp_messages_drained_total{0};
 
+    /**
+     * @brief Outbound compression ratio (uncompressed / compressed bytes).
+     *
+     * Returns 1.0 until something has been compressed.
+     */
+    [[nodiscard]] double deflate_compression_ratio() const noexcept;
+
+    /**
+     * @brief Average number of messages per write batch (0 before any flush).
+     */
+    [[nodiscard]] double average_write_batch_size() const noexcept;
+
     /**
      * @brief Render metrics in Prometheus text exposition format.
      */
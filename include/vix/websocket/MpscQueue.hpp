@@ -0,0 +1,110 @@
+/**
+ *
+ *  @file MpscQueue.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_MPSC_QUEUE_HPP
+#define VIX_WEBSOCKET_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Unbounded lock-free multi-producer, single-consumer queue.
+   *
+   * Linked list with a stub node (Vyukov): push() is one atomic exchange
+   * and never blocks; pop() is only called from the owning consumer thread.
+   * A push that is still linking its node can hide the nodes behind it for
+   * a moment, so pop() may report empty while a push is in flight; callers
+   * that need to see it re-check after their own wake-up handshake.
+   *
+   * @tparam T Value type; must be default constructible and movable.
+   */
+  template <typename T>
+  class MpscQueue
+  {
+  public:
+    MpscQueue()
+        : head_(new Node()),
+          tail_(head_.load(std::memory_order_relaxed))
+    {
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    ~MpscQueue()
+    {
+      Node *node = tail_;
+      while (node)
+      {
+        Node *next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+      }
+    }
+
+    /** @brief Enqueue @p value. Safe from any thread. */
+    void push(T value)
+    {
+      Node *node = new Node();
+      node->value = std::move(value);
+
+      Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+      prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Dequeue into @p out. Consumer thread only.
+     *
+     * @return False if no completed push is visible.
+     */
+    bool pop(T &out)
+    {
+      Node *tail = tail_;
+      Node *next = tail->next.load(std::memory_order_acquire);
+      if (!next)
+      {
+        return false;
+      }
+
+      out = std::move(next->value);
+      next->value = T{};
+      tail_ = next;
+      delete tail;
+      return true;
+    }
+
+    /** @brief True if no completed push is visible. Consumer thread only. */
+    bool empty() const
+    {
+      return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    struct Node
+    {
+      std::atomic<Node *> next{nullptr};
+      T value{};
+    };
+
+    /** @brief Last pushed node; producers swing it. */
+    std::atomic<Node *> head_;
+
+    /** @brief Stub node before the next value; consumer only. */
+    Node *tail_;
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_MPSC_QUEUE_HPP
@@ -0,0 +1,181 @@
+/**
+ *
+ *  @file ReadBuffer.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_READ_BUFFER_HPP
+#define VIX_WEBSOCKET_READ_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Reusable receive buffer with read and write cursors.
+   *
+   * Bytes are appended at the write cursor (prepare() + commit()) and
+   * released from the read cursor (consume()). Consuming never moves
+   * memory: unread bytes are only compacted to the front when prepare()
+   * runs out of tail space, and the storage only grows when compaction
+   * alone cannot satisfy the request.
+   *
+   * Views returned by readable() stay valid until the next prepare().
+   */
+  class ReadBuffer
+  {
+  public:
+    explicit ReadBuffer(std::size_t initialCapacity = 16 * 1024)
+        : storage_(initialCapacity)
+    {
+    }
+
+    /** @brief Number of unread bytes. */
+    std::size_t size() const noexcept
+    {
+      return writePos_ - readPos_;
+    }
+
+    /** @brief True if there are no unread bytes. */
+    bool empty() const noexcept
+    {
+      return readPos_ == writePos_;
+    }
+
+    /** @brief Total allocated storage in bytes. */
+    std::size_t capacity() const noexcept
+    {
+      return storage_.size();
+    }
+
+    /** @brief Pointer to the first unread byte. */
+    std::byte *data() noexcept
+    {
+      return storage_.data() + readPos_;
+    }
+
+    /** @brief Pointer to the first unread byte. */
+    const std::byte *data() const noexcept
+    {
+      return storage_.data() + readPos_;
+    }
+
+    /** @brief Unread bytes as a mutable span. */
+    std::span<std::byte> readable() noexcept
+    {
+      return std::span<std::byte>(data(), size());
+    }
+
+    /** @brief Unread bytes as characters, for text protocols (HTTP head). */
+    std::string_view view() const noexcept
+    {
+      return std::string_view(reinterpret_cast<const char *>(data()), size());
+    }
+
+    /**
+     * @brief Return writable tail space of at least @p minFree bytes.
+     *
+     * Compacts unread bytes to the front only when the tail is too small,
+     * and grows the storage only when compaction is not enough.
+     */
+    std::span<std::byte> prepare(std::size_t minFree)
+    {
+      if (storage_.size() - writePos_ < minFree)
+      {
+        const std::size_t unread = size();
+
+        if (readPos_ != 0 && storage_.size() - unread >= minFree)
+        {
+          if (unread != 0)
+          {
+            std::memmove(storage_.data(), storage_.data() + readPos_, unread);
+          }
+          readPos_ = 0;
+          writePos_ = unread;
+          ++compactions_;
+        }
+        else
+        {
+          if (readPos_ != 0)
+          {
+            std::memmove(storage_.data(), storage_.data() + readPos_, unread);
+            readPos_ = 0;
+            writePos_ = unread;
+            ++compactions_;
+          }
+
+          storage_.resize(std::max(storage_.size() * 2, unread + minFree));
+        }
+      }
+
+      return std::span<std::byte>(
+          storage_.data() + writePos_,
+          storage_.size() - writePos_);
+    }
+
+    /** @brief Mark @p n bytes written into the prepare() span as readable. */
+    void commit(std::size_t n) noexcept
+    {
+      writePos_ += std::min(n, storage_.size() - writePos_);
+    }
+
+    /** @brief Append bytes (copying). */
+    void append(const std::byte *bytes, std::size_t n)
+    {
+      auto out = prepare(n);
+      std::memcpy(out.data(), bytes, n);
+      commit(n);
+    }
+
+    /**
+     * @brief Release @p n bytes from the front.
+     *
+     * When the buffer drains completely both cursors rewind to the start,
+     * which keeps the common "one read, N whole frames" case copy-free.
+     */
+    void consume(std::size_t n) noexcept
+    {
+      readPos_ += std::min(n, size());
+
+      if (readPos_ == writePos_)
+      {
+        readPos_ = 0;
+        writePos_ = 0;
+      }
+    }
+
+    /** @brief Drop all unread bytes. */
+    void clear() noexcept
+    {
+      readPos_ = 0;
+      writePos_ = 0;
+    }
+
+    /** @brief Number of times unread bytes were moved to the front. */
+    std::size_t compactions() const noexcept
+    {
+      return compactions_;
+    }
+
+  private:
+    std::vector<std::byte> storage_;
+    std::size_t readPos_{0};
+    std::size_t writePos_{0};
+    std::size_t compactions_{0};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_READ_BUFFER_HPP
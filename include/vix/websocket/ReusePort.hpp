@@ -0,0 +1,82 @@
+/**
+ *
+ *  @file ReusePort.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_REUSE_PORT_HPP
+#define VIX_WEBSOCKET_REUSE_PORT_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Native TCP socket bound with SO_REUSEADDR and SO_REUSEPORT.
+   *
+   * Several of these, or any other SO_REUSEPORT sockets of the same user,
+   * can bind one address and port; the kernel then spreads incoming
+   * connections across the listening ones. POSIX only.
+   */
+  class ReusePortSocket
+  {
+  public:
+    ReusePortSocket() = default;
+    ~ReusePortSocket();
+
+    ReusePortSocket(ReusePortSocket &&other) noexcept;
+    ReusePortSocket &operator=(ReusePortSocket &&other) noexcept;
+
+    ReusePortSocket(const ReusePortSocket &) = delete;
+    ReusePortSocket &operator=(const ReusePortSocket &) = delete;
+
+    /**
+     * @brief Bind @p host:@p port with SO_REUSEPORT set before bind().
+     *
+     * @param host IPv4 address; empty means 0.0.0.0.
+     * @param port Port, or 0 for an ephemeral one.
+     * @param backlog listen() backlog; negative binds without listening.
+     * @throws std::system_error if the socket cannot be bound.
+     */
+    static ReusePortSocket bind(const std::string &host, std::uint16_t port, int backlog = 128);
+
+    /** @brief Native descriptor, or -1. */
+    int fd() const noexcept
+    {
+      return fd_;
+    }
+
+    /** @brief Port actually bound. */
+    std::uint16_t port() const;
+
+    void close() noexcept;
+
+  private:
+    explicit ReusePortSocket(int fd) noexcept
+        : fd_(fd)
+    {
+    }
+
+    int fd_{-1};
+  };
+
+  /**
+   * @brief Check that another SO_REUSEPORT socket can join @p host:@p port.
+   *
+   * Binds and closes a probe socket. Linux only lets it bind if the socket
+   * already listening there was itself bound with SO_REUSEPORT, so this
+   * tells whether a second acceptor on the port would get EADDRINUSE.
+   */
+  bool reuse_port_joinable(const std::string &host, std::uint16_t port) noexcept;
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_REUSE_PORT_HPP
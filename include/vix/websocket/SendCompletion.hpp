@@ -0,0 +1,222 @@
+/**
+ *
+ *  @file SendCompletion.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_SEND_COMPLETION_HPP
+#define VIX_WEBSOCKET_SEND_COMPLETION_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace vix::websocket
+{
+  /**
+   * @brief Outcome of a tracked send.
+   */
+  enum class SendStatus : std::uint8_t
+  {
+    /** @brief Every frame of the message was handed to the socket. */
+    Written,
+
+    /** @brief Never queued: the session was closing, or closed for backpressure. */
+    Rejected,
+
+    /** @brief Discarded by the overflow policy, or by a close before writing. */
+    Dropped,
+  };
+
+  /**
+   * @brief Report delivered to a send-completion callback.
+   */
+  struct SendReceipt
+  {
+    /** @brief What happened to the message. */
+    SendStatus status{SendStatus::Dropped};
+
+    /** @brief Messages already pending in the write queue when it was queued. */
+    std::size_t queuePosition{0};
+
+    /** @brief Wire bytes written for this message, frame headers included. */
+    std::size_t bytes{0};
+
+    /** @brief Bytes the session had written in total once this message completed. */
+    std::uint64_t totalBytesFlushed{0};
+
+    /** @brief True if the message reached the socket. */
+    bool ok() const noexcept
+    {
+      return status == SendStatus::Written;
+    }
+  };
+
+  /**
+   * @brief Callback run once per tracked send.
+   */
+  using SendCallback = std::function<void(const SendReceipt &)>;
+
+  namespace detail
+  {
+    /**
+     * @brief Move-only completion carried by a queued message.
+     *
+     * finish() runs the callback once. A completion destroyed before that,
+     * because its message was shed, replaced or cleared on close, reports
+     * SendStatus::Dropped, so every tracked send completes exactly once.
+     */
+    class SendCompletion
+    {
+    public:
+      SendCompletion() = default;
+
+      explicit SendCompletion(SendCallback callback) noexcept
+          : callback_(std::move(callback))
+      {
+      }
+
+      SendCompletion(SendCompletion &&other) noexcept
+          : callback_(std::exchange(other.callback_, nullptr)),
+            receipt_(other.receipt_)
+      {
+      }
+
+      SendCompletion &operator=(SendCompletion &&other) noexcept
+      {
+        if (this != &other)
+        {
+          finish(SendStatus::Dropped);
+          callback_ = std::exchange(other.callback_, nullptr);
+          receipt_ = other.receipt_;
+        }
+        return *this;
+      }
+
+      SendCompletion(const SendCompletion &) = delete;
+      SendCompletion &operator=(const SendCompletion &) = delete;
+
+      ~SendCompletion()
+      {
+        finish(SendStatus::Dropped);
+      }
+
+      /** @brief True while a callback is pending. */
+      explicit operator bool() const noexcept
+      {
+        return static_cast<bool>(callback_);
+      }
+
+      void set_queue_position(std::size_t position) noexcept
+      {
+        receipt_.queuePosition = position;
+      }
+
+      /** @brief Account @p n wire bytes written for the message. */
+      void add_bytes(std::size_t n) noexcept
+      {
+        receipt_.bytes += n;
+      }
+
+      /**
+       * @brief Run the callback with @p status; later calls do nothing.
+       *
+       * @param status Outcome of the send.
+       * @param totalBytesFlushed Session byte counter after the write.
+       */
+      void finish(SendStatus status, std::uint64_t totalBytesFlushed = 0) noexcept
+      {
+        if (!callback_)
+        {
+          return;
+        }
+
+        SendCallback callback = std::exchange(callback_, nullptr);
+        receipt_.status = status;
+        receipt_.totalBytesFlushed = totalBytesFlushed;
+
+        try
+        {
+          callback(receipt_);
+        }
+        catch (...)
+        {
+        }
+      }
+
+    private:
+      SendCallback callback_{};
+      SendReceipt receipt_{};
+    };
+  } // namespace detail
+
+  /**
+   * @brief Awaitable completed by the callback it hands out.
+   *
+   * Returned by Session::async_send_text() and async_send_binary();
+   * `co_await` yields the SendReceipt.
+   *
+   * The callback may run on any thread, before or after the awaiting
+   * coroutine suspends; whichever side comes second resumes it.
+   */
+  class SendAwaitable
+  {
+  public:
+    /** @brief Callback completing this awaitable; call it once. */
+    SendCallback callback() const
+    {
+      return [state = state_](const SendReceipt &receipt)
+      {
+        state->receipt = receipt;
+        if (state->phase.exchange(DONE, std::memory_order_acq_rel) == WAITING)
+        {
+          state->waiter.resume();
+        }
+      };
+    }
+
+    bool await_ready() const noexcept
+    {
+      return state_->phase.load(std::memory_order_acquire) == DONE;
+    }
+
+    bool await_suspend(std::coroutine_handle<> waiter) noexcept
+    {
+      state_->waiter = waiter;
+      return state_->phase.exchange(WAITING, std::memory_order_acq_rel) != DONE;
+    }
+
+    SendReceipt await_resume() const noexcept
+    {
+      return state_->receipt;
+    }
+
+  private:
+    static constexpr int IDLE = 0;
+    static constexpr int WAITING = 1;
+    static constexpr int DONE = 2;
+
+    struct State
+    {
+      std::atomic<int> phase{IDLE};
+      SendReceipt receipt{};
+      std::coroutine_handle<> waiter{};
+    };
+
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+  };
+
+} // namespace vix::websocket
+
+#endif // VIX_WEBSOCKET_SEND_COMPLETION_HPP
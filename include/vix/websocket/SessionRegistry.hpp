@@ -0,0 +1,604 @@
+/**
+ *
+ *  @file SessionRegistry.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_SESSION_REGISTRY_HPP
+#define VIX_WEBSOCKET_SESSION_REGISTRY_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Sharded registry of live sessions and their room memberships.
+   *
+   * Sessions are spread over SHARDS buckets by address and rooms over SHARDS
+   * buckets by name, each with its own mutex, so connection churn and
+   * broadcasts from different threads rarely meet on the same lock.
+   *
+   * Room membership is published as immutable snapshots: join/leave publish
+   * a new member list under the room shard lock, while broadcasters only
+   * copy the snapshot pointer and iterate it without holding any lock. A
+   * member list is a vector of shared, immutable chunks of CHUNK members;
+   * a join or leave copies the chunk pointers and at most two chunks, so
+   * its cost grows with room size / CHUNK rather than with room size. A
+   * leave moves the last member into the freed slot, so the members stay
+   * densely packed and member order is not preserved.
+   *
+   * Cleanup is incremental. Every session remembers the rooms it joined, so
+   * removing it touches only those rooms; expired entries met during a
+   * broadcast are dropped from the shard being visited, and a room snapshot
+   * found to hold expired members is compacted once by that broadcaster.
+   *
+   * Lock order is session shard, then room shard.
+   *
+   * @tparam SessionT Session type, owned through std::shared_ptr.
+   */
+  template <typename SessionT>
+  class BasicSessionRegistry
+  {
+    struct Member
+    {
+      std::weak_ptr<SessionT> session;
+
+      /** @brief Identity of the member, compared without locking it. */
+      const SessionT *raw{nullptr};
+    };
+
+  public:
+    using RoomId = std::string;
+    using SessionPtr = std::shared_ptr<SessionT>;
+
+    static constexpr std::size_t SHARDS = 16;
+
+    /** @brief Members per chunk of a room member list. */
+    static constexpr std::size_t CHUNK = 64;
+
+    /**
+     * @brief Immutable member list of a room.
+     */
+    class Members
+    {
+    public:
+      /** @brief Number of members, expired ones included. */
+      std::size_t size() const noexcept
+      {
+        return size_;
+      }
+
+      bool empty() const noexcept
+      {
+        return size_ == 0;
+      }
+
+      /** @brief Invoke @p fn with the weak pointer of every member. */
+      template <typename Fn>
+      void for_each(Fn &&fn) const
+      {
+        for (const auto &chunk : chunks_)
+        {
+          for (const Member &m : *chunk)
+          {
+            fn(m.session);
+          }
+        }
+      }
+
+    private:
+      friend class BasicSessionRegistry;
+
+      std::vector<std::shared_ptr<const std::vector<Member>>> chunks_{};
+      std::size_t size_{0};
+    };
+
+    using MembersSnapshot = std::shared_ptr<const Members>;
+
+    /**
+     * @brief Track a newly opened session. Idempotent.
+     */
+    void add(const SessionPtr &session)
+    {
+      if (!session)
+      {
+        return;
+      }
+
+      auto &shard = session_shard(session.get());
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      entry_for(shard, session);
+    }
+
+    /**
+     * @brief Forget a session and remove it from every room it joined.
+     */
+    void remove(const SessionT *session)
+    {
+      if (!session)
+      {
+        return;
+      }
+
+      auto &shard = session_shard(session);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto it = shard.entries.find(session);
+      if (it == shard.entries.end())
+      {
+        return;
+      }
+
+      for (const RoomId &room : it->second.rooms)
+      {
+        remove_member(room, session);
+      }
+
+      shard.entries.erase(it);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add a session to a room. Idempotent.
+     *
+     * A session that was not registered yet is registered on the fly.
+     */
+    void join(const SessionPtr &session, const RoomId &room)
+    {
+      if (!session)
+      {
+        return;
+      }
+
+      auto &shard = session_shard(session.get());
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto &rooms = entry_for(shard, session).rooms;
+      if (std::find(rooms.begin(), rooms.end(), room) != rooms.end())
+      {
+        return;
+      }
+      rooms.push_back(room);
+
+      add_member(room, session);
+    }
+
+    /**
+     * @brief Remove a session from one room.
+     */
+    void leave(const SessionT *session, const RoomId &room)
+    {
+      if (!session)
+      {
+        return;
+      }
+
+      auto &shard = session_shard(session);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto it = shard.entries.find(session);
+      if (it == shard.entries.end())
+      {
+        return;
+      }
+
+      auto &rooms = it->second.rooms;
+      auto pos = std::find(rooms.begin(), rooms.end(), room);
+      if (pos == rooms.end())
+      {
+        return;
+      }
+      rooms.erase(pos);
+
+      remove_member(room, session);
+    }
+
+    /**
+     * @brief Remove a session from every room while keeping it registered.
+     */
+    void leave_all(const SessionT *session)
+    {
+      if (!session)
+      {
+        return;
+      }
+
+      auto &shard = session_shard(session);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto it = shard.entries.find(session);
+      if (it == shard.entries.end())
+      {
+        return;
+      }
+
+      for (const RoomId &room : it->second.rooms)
+      {
+        remove_member(room, session);
+      }
+      it->second.rooms.clear();
+    }
+
+    /**
+     * @brief Current member snapshot of a room, or null if the room is empty.
+     *
+     * The snapshot is immutable and may be iterated without any lock. It can
+     * contain sessions that expired after it was taken.
+     */
+    MembersSnapshot room_members(const RoomId &room)
+    {
+      auto &roomShard = room_shard(room);
+      std::lock_guard<std::mutex> lock(roomShard.mutex);
+
+      auto it = roomShard.rooms.find(room);
+      if (it == roomShard.rooms.end())
+      {
+        return nullptr;
+      }
+      return it->second.members;
+    }
+
+    /**
+     * @brief Invoke @p fn for every live member of @p room.
+     *
+     * Runs on a snapshot, outside of every registry lock.
+     */
+    template <typename Fn>
+    void for_each_in_room(const RoomId &room, Fn &&fn)
+    {
+      MembersSnapshot members = room_members(room);
+      if (!members)
+      {
+        return;
+      }
+
+      bool sawExpired = false;
+      members->for_each(
+          [&fn, &sawExpired](const std::weak_ptr<SessionT> &weak)
+          {
+            if (auto s = weak.lock())
+            {
+              fn(*s);
+            }
+            else
+            {
+              sawExpired = true;
+            }
+          });
+
+      if (sawExpired)
+      {
+        compact_room(room, members);
+      }
+    }
+
+    /**
+     * @brief Invoke @p fn for every live session, one shard at a time.
+     *
+     * Only the shard being visited is locked; expired entries found along
+     * the way are dropped. @p fn must not call back into the registry.
+     */
+    template <typename Fn>
+    void for_each_session(Fn &&fn)
+    {
+      visit_sessions(
+          [&fn](const SessionPtr &s)
+          {
+            fn(*s);
+          });
+    }
+
+    /**
+     * @brief Strong references to every live session.
+     */
+    std::vector<SessionPtr> sessions()
+    {
+      std::vector<SessionPtr> out;
+      out.reserve(size());
+
+      visit_sessions(
+          [&out](const SessionPtr &s)
+          {
+            out.push_back(s);
+          });
+      return out;
+    }
+
+    /**
+     * @brief Number of registered sessions.
+     */
+    std::size_t size() const noexcept
+    {
+      return size_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    using Chunk = std::vector<Member>;
+
+    struct Entry
+    {
+      std::weak_ptr<SessionT> session;
+      std::vector<RoomId> rooms;
+    };
+
+    struct SessionShard
+    {
+      std::mutex mutex;
+      std::unordered_map<const SessionT *, Entry> entries;
+    };
+
+    struct Room
+    {
+      MembersSnapshot members;
+
+      /** @brief Position of every member in the member list. */
+      std::unordered_map<const SessionT *, std::size_t> slots;
+    };
+
+    struct RoomShard
+    {
+      std::mutex mutex;
+      std::unordered_map<RoomId, Room> rooms;
+    };
+
+    template <typename Fn>
+    void visit_sessions(Fn &&fn)
+    {
+      for (auto &shard : sessionShards_)
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        for (auto it = shard.entries.begin(); it != shard.entries.end();)
+        {
+          if (auto s = it->second.session.lock())
+          {
+            fn(s);
+            ++it;
+          }
+          else
+          {
+            for (const RoomId &room : it->second.rooms)
+            {
+              remove_member(room, it->first);
+            }
+            it = shard.entries.erase(it);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Entry of @p session, created if needed. Requires the shard lock.
+     *
+     * An entry whose session expired without remove() belongs to a dead
+     * session at the same address; its rooms are left before it is reused.
+     */
+    Entry &entry_for(SessionShard &shard, const SessionPtr &session)
+    {
+      auto [it, inserted] = shard.entries.try_emplace(session.get());
+      Entry &entry = it->second;
+
+      if (inserted)
+      {
+        size_.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (entry.session.expired())
+      {
+        for (const RoomId &room : entry.rooms)
+        {
+          remove_member(room, session.get());
+        }
+        entry.rooms.clear();
+      }
+      else
+      {
+        return entry;
+      }
+
+      entry.session = session;
+      return entry;
+    }
+
+    SessionShard &session_shard(const SessionT *session) noexcept
+    {
+      // Drop the low bits, which are constant for heap allocations.
+      const auto h = std::hash<const SessionT *>{}(session) >> 4;
+      return sessionShards_[h % SHARDS];
+    }
+
+    RoomShard &room_shard(const RoomId &room) noexcept
+    {
+      return roomShards_[std::hash<RoomId>{}(room) % SHARDS];
+    }
+
+    /** @brief Copy of chunk @p index of @p members, to be modified. */
+    static std::shared_ptr<Chunk> copy_chunk(const Members &members, std::size_t index)
+    {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->reserve(CHUNK);
+      chunk->assign(members.chunks_[index]->begin(), members.chunks_[index]->end());
+      return chunk;
+    }
+
+    /** Requires the owning session shard lock. */
+    void add_member(const RoomId &room, const SessionPtr &session)
+    {
+      auto &roomShard = room_shard(room);
+      std::lock_guard<std::mutex> lock(roomShard.mutex);
+
+      Room &r = roomShard.rooms[room];
+      auto next = r.members ? std::make_shared<Members>(*r.members)
+                            : std::make_shared<Members>();
+      const Member member{session, session.get()};
+
+      // An expired member compacted away later may still hold the address.
+      if (auto slot = r.slots.find(session.get()); slot != r.slots.end())
+      {
+        auto chunk = copy_chunk(*next, slot->second / CHUNK);
+        (*chunk)[slot->second % CHUNK] = member;
+        next->chunks_[slot->second / CHUNK] = std::move(chunk);
+        r.members = std::move(next);
+        return;
+      }
+
+      if (next->chunks_.empty() || next->chunks_.back()->size() == CHUNK)
+      {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->reserve(CHUNK);
+        chunk->push_back(member);
+        next->chunks_.push_back(std::move(chunk));
+      }
+      else
+      {
+        auto chunk = copy_chunk(*next, next->chunks_.size() - 1);
+        chunk->push_back(member);
+        next->chunks_.back() = std::move(chunk);
+      }
+
+      r.slots.emplace(session.get(), next->size_);
+      ++next->size_;
+      r.members = std::move(next);
+    }
+
+    /** Requires the owning session shard lock. */
+    void remove_member(const RoomId &room, const SessionT *session)
+    {
+      auto &roomShard = room_shard(room);
+      std::lock_guard<std::mutex> lock(roomShard.mutex);
+
+      auto it = roomShard.rooms.find(room);
+      if (it == roomShard.rooms.end() || !it->second.members)
+      {
+        return;
+      }
+
+      Room &r = it->second;
+      auto slot = r.slots.find(session);
+      if (slot == r.slots.end())
+      {
+        return;
+      }
+
+      const std::size_t pos = slot->second;
+      r.slots.erase(slot);
+
+      const Members &current = *r.members;
+      if (current.size_ == 1)
+      {
+        roomShard.rooms.erase(it);
+        return;
+      }
+
+      // Move the last member into the freed slot.
+      auto next = std::make_shared<Members>(current);
+      const std::size_t lastIndex = next->chunks_.size() - 1;
+      auto last = copy_chunk(*next, lastIndex);
+      const Member moved = last->back();
+      last->pop_back();
+
+      if (pos != next->size_ - 1)
+      {
+        if (pos / CHUNK == lastIndex)
+        {
+          (*last)[pos % CHUNK] = moved;
+        }
+        else
+        {
+          auto chunk = copy_chunk(*next, pos / CHUNK);
+          (*chunk)[pos % CHUNK] = moved;
+          next->chunks_[pos / CHUNK] = std::move(chunk);
+        }
+        r.slots[moved.raw] = pos;
+      }
+
+      if (last->empty())
+      {
+        next->chunks_.pop_back();
+      }
+      else
+      {
+        next->chunks_.back() = std::move(last);
+      }
+
+      --next->size_;
+      r.members = std::move(next);
+    }
+
+    /** Rebuild @p room without expired members, unless it changed since @p seen. */
+    void compact_room(const RoomId &room, const MembersSnapshot &seen)
+    {
+      auto &roomShard = room_shard(room);
+      std::lock_guard<std::mutex> lock(roomShard.mutex);
+
+      auto it = roomShard.rooms.find(room);
+      if (it == roomShard.rooms.end() || it->second.members != seen)
+      {
+        return;
+      }
+
+      Room &r = it->second;
+      auto next = std::make_shared<Members>();
+      std::shared_ptr<Chunk> chunk;
+      r.slots.clear();
+
+      for (const auto &from : seen->chunks_)
+      {
+        for (const Member &m : *from)
+        {
+          if (m.session.expired())
+          {
+            continue;
+          }
+
+          if (!chunk || chunk->size() == CHUNK)
+          {
+            if (chunk)
+            {
+              next->chunks_.push_back(std::move(chunk));
+            }
+            chunk = std::make_shared<Chunk>();
+            chunk->reserve(CHUNK);
+          }
+
+          chunk->push_back(m);
+          r.slots.emplace(m.raw, next->size_++);
+        }
+      }
+
+      if (next->size_ == 0)
+      {
+        roomShard.rooms.erase(it);
+        return;
+      }
+
+      next->chunks_.push_back(std::move(chunk));
+      r.members = std::move(next);
+    }
+
+    std::array<SessionShard, SHARDS> sessionShards_{};
+    std::array<RoomShard, SHARDS> roomShards_{};
+    std::atomic<std::size_t> size_{0};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_SESSION_REGISTRY_HPP
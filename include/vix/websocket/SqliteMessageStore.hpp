@@ -14,22 +14,65 @@
 #ifndef VIX_WEBSOCKET_SQLITE_MESSAGE_STORE_HPP
 #define VIX_WEBSOCKET_SQLITE_MESSAGE_STORE_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <optional>
 
+#include <vix/websocket/MessageId.hpp>
 #include <vix/websocket/MessageStore.hpp>
 #include <vix/websocket/protocol.hpp>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace vix::websocket
 {
+  /**
+   * @brief Write batching of SqliteMessageStore.
+   */
+  struct SqliteStoreOptions
+  {
+    /**
+     * @brief Appends committed per transaction.
+     *
+     * 1 commits every append() before it returns. Larger values hand
+     * appends to a writer thread that commits them in one transaction per
+     * groupCommitMessages messages or groupCommitDelay, whichever is first.
+     */
+    std::size_t groupCommitMessages = 1;
+
+    /** @brief Longest time an append waits for its transaction. */
+    std::chrono::milliseconds groupCommitDelay{5};
+
+    /**
+     * @brief Called when a group-commit batch fails, with the ids it lost.
+     *
+     * The batch is rolled back, so none of its messages are stored. Runs on
+     * the thread that committed the batch (the writer, flush() or a read)
+     * without any store lock held.
+     */
+    std::function<void(std::exception_ptr error, const std::vector<std::string> &lostIds)>
+        onCommitError{};
+  };
+
   /**
    * @brief SQLite-backed persistent message store.
    *
    * Stores WebSocket JsonMessage objects in a SQLite database,
    * designed for history replay, room-based queries, and WAL-friendly persistence.
+   * Statements are prepared once and reused for the store's lifetime.
+   *
+   * Rows are clustered by an integer append sequence with a (room, seq)
+   * index, so history pages and replay cost the same at any table size.
+   * Messages come back in append order; id cursors assume ids sort in
+   * append order too, as generated ids do.
    */
   class SqliteMessageStore : public IMessageStore
   {
@@ -38,8 +81,11 @@ namespace vix::websocket
      * @brief Open or create a SQLite message store.
      *
      * @param db_path Path to the SQLite database file.
+     * @param options Write batching.
      */
-    explicit SqliteMessageStore(const std::string &db_path);
+    explicit SqliteMessageStore(
+        const std::string &db_path,
+        SqliteStoreOptions options = {});
 
     ~SqliteMessageStore() override;
 
@@ -48,12 +94,29 @@ namespace vix::websocket
     SqliteMessageStore(SqliteMessageStore &&) = delete;
     SqliteMessageStore &operator=(SqliteMessageStore &&) = delete;
 
-    /** @brief Persist a message into the database. */
+    /**
+     * @brief Persist a message into the database.
+     *
+     * With group commit the message is only queued and is durable once its
+     * batch commits. A failed batch never makes a later append() throw; its
+     * messages are lost and reported through
+     * SqliteStoreOptions::onCommitError and flush().
+     */
     void append(const JsonMessage &msg) override;
 
+    /**
+     * @brief Commit all pending group-commit appends now.
+     *
+     * @throws The error of the first batch that failed since the last
+     *         flush(), whichever thread committed it.
+     */
+    void flush();
+
     /**
      * @brief List messages for a given room.
      *
+     * Pending group-commit appends are committed first.
+     *
      * @param room Room identifier.
      * @param limit Maximum number of messages.
      * @param before_id Optional cursor for pagination.
@@ -74,13 +137,89 @@ namespace vix::websocket
         std::size_t limit) override;
 
   private:
+    /** @brief Normalized message ready to be bound to the insert statement. */
+    struct Row
+    {
+      std::string id;
+      std::string kind;
+      std::string room;
+      std::string type;
+      std::string ts;
+      std::string payloadJson;
+    };
+
     sqlite3 *db_{nullptr};
 
-    /** @brief Initialize database schema if missing. */
+    SqliteStoreOptions options_{};
+
+    /** @brief Source of ids for messages appended without one. */
+    detail::MonotonicIdGenerator ids_{};
+
+    /** @brief Serializes statement use and commits. */
+    std::mutex dbMutex_;
+
+    sqlite3_stmt *insertStmt_{nullptr};
+    sqlite3_stmt *listStmt_{nullptr};
+    sqlite3_stmt *listBeforeStmt_{nullptr};
+    sqlite3_stmt *replayStmt_{nullptr};
+
+    /** @brief Guards pending_, stopping_ and writerError_. */
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCv_;
+
+    /** @brief Appends waiting for the writer thread. */
+    std::vector<Row> pending_;
+
+    /** @brief Batch being committed; reused between commits. */
+    std::vector<Row> committing_;
+
+    /** @brief When the oldest pending append arrived. */
+    std::chrono::steady_clock::time_point firstPendingAt_{};
+
+    bool stopping_{false};
+
+    /** @brief First failed batch since the last flush(); rethrown by it. */
+    std::exception_ptr writerError_{};
+
+    /** @brief Group-commit writer; not started when batching is disabled. */
+    std::thread writer_;
+
+    /** @brief Schema written to PRAGMA user_version. */
+    static constexpr int SCHEMA_VERSION = 1;
+
+    /** @brief Create the schema, or migrate a version 0 table in place. */
     void init_schema();
 
-    /** @brief Generate a unique message identifier. */
-    static std::string generate_id();
+    /** @brief Prepare the statements kept for the store's lifetime. */
+    void prepare_statements();
+
+    /**
+     * @brief Fill missing ts and kind and serialize the payload.
+     *
+     * A missing id is left empty; append() generates it under the lock that
+     * fixes insert order, so generated ids sort in append order.
+     */
+    Row make_row(const JsonMessage &msg);
+
+    /** @brief Bind @p row to the insert statement and run it. Needs dbMutex_. */
+    void insert_row(const Row &row);
+
+    /**
+     * @brief Commit the pending appends in one transaction.
+     *
+     * A failed batch is rolled back, recorded for flush() and passed to
+     * onCommitError; it does not throw.
+     */
+    void commit_pending();
+
+    /** @brief Group-commit writer loop. */
+    void writer_loop();
+
+    /** @brief Rethrow and clear a failed batch error. Needs pendingMutex_. */
+    void rethrow_writer_error();
+
+    /** @brief Resume id generation after the highest stored id. */
+    void seed_ids();
   };
 
 } // namespace vix::websocket
@@ -0,0 +1,144 @@
+/**
+ *
+ *  @file TimerWheel.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_TIMER_WHEEL_HPP
+#define VIX_WEBSOCKET_TIMER_WHEEL_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Hierarchical timing wheel shared by all sessions of a server.
+   *
+   * Four levels of 64 slots each; with the default 100 ms tick the wheel
+   * covers about 19 days, longer delays are clamped. Scheduling, re-arming
+   * and cancelling are O(1): timers are intrusive list nodes owned by the
+   * caller. advance() is driven from outside (the server posts it into its
+   * io_context once per tick) and runs expired callbacks on the calling
+   * thread, outside the internal lock, so callbacks may re-arm timers.
+   *
+   * A callback can still run once after a concurrent cancel() that raced
+   * with its expiry; callers re-check their own state.
+   */
+  class TimerWheel
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    static constexpr std::size_t LEVELS = 4;
+    static constexpr std::size_t SLOT_BITS = 6;
+    static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+
+    /**
+     * @brief Intrusive timer handle.
+     *
+     * Owned by the caller; must not move while armed. Destroying an armed
+     * timer cancels it.
+     */
+    class Timer
+    {
+    public:
+      Timer() = default;
+      ~Timer();
+
+      Timer(const Timer &) = delete;
+      Timer &operator=(const Timer &) = delete;
+
+    private:
+      friend class TimerWheel;
+
+      TimerWheel *wheel_{nullptr};
+      Timer *prev_{nullptr};
+      Timer *next_{nullptr};
+      std::uint64_t expiry_{0};
+      std::uint8_t level_{0};
+      std::uint8_t slot_{0};
+      bool linked_{false};
+      Callback callback_{};
+    };
+
+    explicit TimerWheel(
+        std::chrono::milliseconds tick = std::chrono::milliseconds{100},
+        Clock::time_point origin = Clock::now());
+
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /**
+     * @brief Arm @p timer to run @p callback after @p delay.
+     *
+     * Re-arms the timer if it is already scheduled. Delays are rounded up
+     * to whole ticks, with a minimum of one tick.
+     */
+    void schedule(Timer &timer, std::chrono::milliseconds delay, Callback callback);
+
+    /**
+     * @brief Re-arm @p timer with its current callback.
+     */
+    void reschedule(Timer &timer, std::chrono::milliseconds delay);
+
+    /** @brief Disarm @p timer; no-op if it is not scheduled. */
+    void cancel(Timer &timer) noexcept;
+
+    /**
+     * @brief Process every tick up to @p now and run expired callbacks.
+     *
+     * @return Number of callbacks run.
+     */
+    std::size_t advance(Clock::time_point now);
+
+    /** @brief Last processed tick. */
+    std::uint64_t now_tick() const noexcept
+    {
+      return now_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Tick duration. */
+    std::chrono::milliseconds tick() const noexcept
+    {
+      return tick_;
+    }
+
+    /** @brief Convert a duration to whole ticks, rounding up. */
+    std::uint64_t to_ticks(std::chrono::milliseconds d) const noexcept;
+
+    /** @brief Number of armed timers. */
+    std::size_t size() const;
+
+  private:
+    void link_locked(Timer &timer) noexcept;
+    void unlink_locked(Timer &timer) noexcept;
+    void cascade_locked(std::size_t level) noexcept;
+
+    const std::chrono::milliseconds tick_;
+    const Clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::atomic<std::uint64_t> now_{0};
+    std::size_t size_{0};
+    std::array<std::array<Timer *, SLOTS>, LEVELS> slots_{};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_TIMER_WHEEL_HPP
@@ -0,0 +1,121 @@
+/**
+ *
+ *  @file TypedRouteTable.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_TYPED_ROUTE_TABLE_HPP
+#define VIX_WEBSOCKET_TYPED_ROUTE_TABLE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Transparent string hash so lookups by std::string_view do not
+   *        allocate a key.
+   */
+  struct RouteTypeHash
+  {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view s) const noexcept
+    {
+      return std::hash<std::string_view>{}(s);
+    }
+  };
+
+  /**
+   * @brief Handlers indexed by message type.
+   *
+   * Built once when routes change and then only read, so dispatch is one
+   * hash lookup followed by the handlers registered for that type. Handlers
+   * registered without a type still see every message, in registration
+   * order, before the typed ones.
+   *
+   * @tparam Handler Callable type, typically a std::function.
+   */
+  template <typename Handler>
+  class TypedRouteTable
+  {
+  public:
+    /** @brief Register a handler for every message. */
+    void add_any(Handler handler)
+    {
+      if (handler)
+      {
+        any_.push_back(std::move(handler));
+      }
+    }
+
+    /** @brief Register a handler for messages whose type is @p type. */
+    void add(const std::string &type, Handler handler)
+    {
+      if (handler)
+      {
+        byType_[type].push_back(std::move(handler));
+      }
+    }
+
+    /**
+     * @brief Invoke every handler matching @p type.
+     *
+     * @return Number of handlers invoked.
+     */
+    template <typename... Args>
+    std::size_t dispatch(std::string_view type, Args &&...args) const
+    {
+      std::size_t called = 0;
+
+      for (const auto &handler : any_)
+      {
+        handler(args...);
+        ++called;
+      }
+
+      auto it = byType_.find(type);
+      if (it == byType_.end())
+      {
+        return called;
+      }
+
+      for (const auto &handler : it->second)
+      {
+        handler(args...);
+        ++called;
+      }
+      return called;
+    }
+
+    /** @brief Number of distinct message types with a handler. */
+    std::size_t type_count() const noexcept
+    {
+      return byType_.size();
+    }
+
+    bool empty() const noexcept
+    {
+      return any_.empty() && byType_.empty();
+    }
+
+  private:
+    std::vector<Handler> any_;
+    std::unordered_map<std::string, std::vector<Handler>, RouteTypeHash, std::equal_to<>> byType_;
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_TYPED_ROUTE_TABLE_HPP
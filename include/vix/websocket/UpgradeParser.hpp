@@ -0,0 +1,206 @@
+/**
+ *
+ *  @file UpgradeParser.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_UPGRADE_PARSER_HPP
+#define VIX_WEBSOCKET_UPGRADE_PARSER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Every line of a list header, such as Sec-WebSocket-Extensions.
+   *
+   * RFC 6455 section 9.1 lets a client split a list header over several
+   * lines; together they mean one comma-separated list.
+   */
+  struct HeaderValues
+  {
+    /** @brief Most lines recorded; a request with more is rejected. */
+    static constexpr std::size_t MAX_LINES = 8;
+
+    std::array<std::string_view, MAX_LINES> lines{};
+    std::size_t count{0};
+
+    bool empty() const noexcept
+    {
+      return count == 0;
+    }
+
+    /**
+     * @brief The whole list, with lines joined by ", ".
+     *
+     * Returns the only line itself when there is one; @p storage is used
+     * only to join several lines.
+     */
+    std::string_view joined(std::string &storage) const;
+  };
+
+  /**
+   * @brief Views into a parsed WebSocket upgrade request.
+   *
+   * Every field points into the buffer handed to UpgradeParser::parse()
+   * and is only valid as long as that buffer is. Header values are trimmed
+   * of surrounding whitespace; absent headers are empty.
+   */
+  struct UpgradeRequest
+  {
+    std::string_view method{};
+    /** @brief Full request target, e.g. "/chat?room=1". */
+    std::string_view target{};
+    std::string_view path{};
+    /** @brief Query string without the leading '?'. */
+    std::string_view query{};
+
+    std::string_view host{};
+    std::string_view origin{};
+    std::string_view upgrade{};
+    std::string_view connection{};
+    std::string_view key{};
+    std::string_view version{};
+    HeaderValues extensions{};
+    HeaderValues protocol{};
+
+    /** @brief True if a Connection header lists the "upgrade" token. */
+    bool connectionUpgrade{false};
+
+    /** @brief Size of the request head, including the final blank line. */
+    std::size_t headSize{0};
+  };
+
+  /**
+   * @brief Single-pass, allocation-free parser for the HTTP upgrade request.
+   *
+   * parse() is called with everything received so far, starting at the
+   * first byte of the request. Only lines completed since the previous call
+   * are scanned, so feeding a request one read at a time stays linear.
+   * Fields are kept as offsets, which lets the caller's buffer move (or be
+   * compacted) between calls as long as its contents are preserved.
+   *
+   * Only the headers the handshake needs are recorded. When a header occurs
+   * more than once the first occurrence wins, except for Connection, whose
+   * tokens are checked on every occurrence, and the list headers
+   * Sec-WebSocket-Extensions and Sec-WebSocket-Protocol, whose every line
+   * is kept (see HeaderValues).
+   */
+  class UpgradeParser
+  {
+  public:
+    enum class Status : std::uint8_t
+    {
+      /** @brief The head is not complete yet; read more and call again. */
+      NeedMore,
+      /** @brief The head is complete; request() is available. */
+      Complete,
+      /** @brief The request is malformed or too large; see error(). */
+      Error,
+    };
+
+    explicit UpgradeParser(std::size_t maxHeadSize = 64 * 1024) noexcept
+        : maxHeadSize_(maxHeadSize)
+    {
+    }
+
+    /**
+     * @brief Continue parsing @p buffer.
+     *
+     * Once Complete or Error is returned, further calls return the same
+     * status until reset().
+     */
+    Status parse(std::string_view buffer) noexcept;
+
+    /**
+     * @brief Resolve the parsed fields against @p buffer.
+     *
+     * @p buffer must hold the same bytes passed to the last parse() call.
+     * Only meaningful after parse() returned Complete.
+     */
+    UpgradeRequest request(std::string_view buffer) const noexcept;
+
+    /** @brief Reason for the last Error status, or an empty string. */
+    const char *error() const noexcept
+    {
+      return error_;
+    }
+
+    /** @brief Forget all state and start a new request. */
+    void reset() noexcept
+    {
+      *this = UpgradeParser(maxHeadSize_);
+    }
+
+  private:
+    struct Field
+    {
+      std::uint32_t offset{0};
+      std::uint32_t size{0};
+    };
+
+    enum class HeaderId : std::uint8_t
+    {
+      Host,
+      Origin,
+      Upgrade,
+      Connection,
+      Key,
+      Version,
+      Extensions,
+      Protocol,
+      Count,
+    };
+
+    /** @brief First list header; every id from here on keeps all its lines. */
+    static constexpr auto FIRST_LIST = static_cast<std::size_t>(HeaderId::Extensions);
+    static constexpr std::size_t LISTS =
+        static_cast<std::size_t>(HeaderId::Count) - FIRST_LIST;
+
+    bool parse_request_line(std::string_view buffer, std::size_t end) noexcept;
+    bool parse_header_line(std::string_view buffer, std::size_t end) noexcept;
+    Status fail(const char *reason) noexcept;
+
+    std::size_t maxHeadSize_;
+    /** @brief Start of the first line not parsed yet. */
+    std::size_t lineStart_{0};
+    /** @brief Where the CRLF search resumes within the current line. */
+    std::size_t scanPos_{0};
+    Status status_{Status::NeedMore};
+    const char *error_{""};
+
+    Field method_{};
+    Field target_{};
+    Field headers_[static_cast<std::size_t>(HeaderId::Count)]{};
+    bool seen_[static_cast<std::size_t>(HeaderId::Count)]{};
+    Field lists_[LISTS][HeaderValues::MAX_LINES]{};
+    std::uint8_t listCounts_[LISTS]{};
+    bool connectionUpgrade_{false};
+    std::size_t headSize_{0};
+  };
+
+  /** @brief ASCII case-insensitive equality. */
+  bool iequals_ascii(std::string_view a, std::string_view b) noexcept;
+
+  /**
+   * @brief True if the comma-separated header @p value lists @p token.
+   *
+   * Comparison is ASCII case-insensitive and ignores whitespace around
+   * each element.
+   */
+  bool header_has_token(std::string_view value, std::string_view token) noexcept;
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_UPGRADE_PARSER_HPP
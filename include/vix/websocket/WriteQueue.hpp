@@ -0,0 +1,699 @@
+/**
+ *
+ *  @file WriteQueue.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_WRITE_QUEUE_HPP
+#define VIX_WEBSOCKET_WRITE_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace vix::websocket
+{
+  /**
+   * @brief What a session does when its write queue is full.
+   */
+  enum class BackpressurePolicy
+  {
+    /** @brief Close the session (reason "backpressure"). */
+    Close,
+
+    /** @brief Discard queued messages, oldest first, until the new one fits. */
+    DropOldest,
+
+    /** @brief Discard the message being sent. */
+    DropNewest,
+
+    /**
+     * @brief Keep only the latest queued message per key.
+     *
+     * Falls back to Close when the queue is still full afterwards.
+     */
+    ConflateByKey,
+  };
+
+  /**
+   * @brief Scheduling class of an outgoing message.
+   *
+   * Higher classes get a larger share of each flush; Bulk is never starved.
+   */
+  enum class SendPriority : std::uint8_t
+  {
+    /** @brief Interactive traffic such as acks and presence. */
+    High,
+
+    /** @brief Default class. */
+    Normal,
+
+    /** @brief Large transfers that may wait. */
+    Bulk,
+  };
+
+  /**
+   * @brief Write queue limits and overflow policy of a session.
+   */
+  struct BackpressureOptions
+  {
+    /** @brief Maximum number of queued messages. */
+    std::size_t maxMessages = 1024;
+
+    /** @brief Maximum queued payload bytes. */
+    std::size_t maxBytes = 4 * 1024 * 1024;
+
+    /** @brief Action taken when a message does not fit. */
+    BackpressurePolicy policy = BackpressurePolicy::Close;
+  };
+
+  /**
+   * @brief Parse a policy name: close, drop_oldest, drop_newest or conflate.
+   *
+   * @return True if @p name was recognised.
+   */
+  inline bool parse_backpressure_policy(std::string_view name, BackpressurePolicy &out) noexcept
+  {
+    if (name == "close")
+      out = BackpressurePolicy::Close;
+    else if (name == "drop_oldest")
+      out = BackpressurePolicy::DropOldest;
+    else if (name == "drop_newest")
+      out = BackpressurePolicy::DropNewest;
+    else if (name == "conflate")
+      out = BackpressurePolicy::ConflateByKey;
+    else
+      return false;
+
+    return true;
+  }
+
+  /**
+   * @brief Current depth and lifetime counters of a session write queue.
+   */
+  struct WriteQueueStats
+  {
+    /** @brief Messages waiting to be flushed. */
+    std::size_t messages{0};
+
+    /** @brief Payload bytes waiting to be flushed. */
+    std::size_t bytes{0};
+
+    /** @brief Highest message count seen since the session opened. */
+    std::size_t highWaterMessages{0};
+
+    /** @brief Highest payload byte count seen since the session opened. */
+    std::size_t highWaterBytes{0};
+
+    /** @brief Messages discarded by DropOldest or DropNewest. */
+    std::uint64_t dropped{0};
+
+    /** @brief Messages superseded by a newer one with the same key. */
+    std::uint64_t conflated{0};
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief Lane of a session write queue, highest priority first.
+     *
+     * Control carries ping, pong and close frames; the others map to
+     * SendPriority.
+     */
+    enum class WriteLane : std::uint8_t
+    {
+      Control,
+      High,
+      Normal,
+      Bulk,
+    };
+
+    inline constexpr std::size_t WRITE_LANES = 4;
+
+    /** @brief Lane used for a user-facing priority. */
+    constexpr WriteLane lane_of(SendPriority priority) noexcept
+    {
+      switch (priority)
+      {
+      case SendPriority::High:
+        return WriteLane::High;
+      case SendPriority::Bulk:
+        return WriteLane::Bulk;
+      case SendPriority::Normal:
+      default:
+        return WriteLane::Normal;
+      }
+    }
+
+    /**
+     * @brief Bounded, multi-lane queue of outgoing messages with an overflow policy.
+     *
+     * Not synchronized; the session guards it with its write mutex.
+     *
+     * Every lane is a FIFO. pop_batch() always drains Control first and
+     * shares the rest by weighted round robin (High 8, Normal 4, Bulk 1
+     * messages per round), so interactive traffic overtakes bulk data
+     * without starving it. Limits and the overflow policy apply to the
+     * data lanes together; DropOldest sheds from the lowest lane first.
+     * Control frames are never shed or rejected and do not count against
+     * the limits, so a full queue cannot lose a pong or a close.
+     *
+     * push_last() seals the queue with a final Control message, the close
+     * frame: it is written after every message queued before it, never
+     * between the fragments of a message, and later pushes are dropped.
+     *
+     * The newest queued message of every key is indexed by sequence number
+     * within its lane, so push_conflated() finds the entry to overwrite in
+     * constant time.
+     *
+     * @tparam MessageT Message type exposing `std::size_t payload_size() const`
+     *         and a `std::string key` member (empty when not conflatable).
+     */
+    template <typename MessageT>
+    class BasicWriteQueue
+    {
+    public:
+      /** @brief Outcome of push(). */
+      enum class Push
+      {
+        /** @brief Appended to the queue. */
+        Queued,
+
+        /** @brief Appended after older messages were dropped or conflated. */
+        QueuedAfterShedding,
+
+        /** @brief Overwrote the pending message with the same key. */
+        Replaced,
+
+        /** @brief The new message was discarded. */
+        Dropped,
+
+        /** @brief Over the limits; the caller must close the session. */
+        Overflow,
+      };
+
+      /** @brief Messages served per round of the weighted scheduler. */
+      static constexpr std::array<std::uint32_t, WRITE_LANES> LANE_WEIGHTS = {0, 8, 4, 1};
+
+      BasicWriteQueue() = default;
+
+      explicit BasicWriteQueue(const BackpressureOptions &options)
+          : options_(options)
+      {
+      }
+
+      /** @brief Replace the limits and policy; queued messages stay. */
+      void set_options(const BackpressureOptions &options) noexcept
+      {
+        options_ = options;
+      }
+
+      /** @brief Current limits and policy. */
+      const BackpressureOptions &options() const noexcept
+      {
+        return options_;
+      }
+
+      /**
+       * @brief Queue @p message on @p lane, applying the policy if it does not fit.
+       */
+      Push push(MessageT &&message, WriteLane lane = WriteLane::Normal)
+      {
+        if (sealed_)
+        {
+          ++stats_.dropped;
+          return Push::Dropped;
+        }
+
+        Lane &l = lanes_[index_of(lane)];
+        const std::size_t size = message.payload_size();
+
+        if (lane == WriteLane::Control || fits(size))
+        {
+          append(l, std::move(message), size);
+          return Push::Queued;
+        }
+
+        switch (options_.policy)
+        {
+        case BackpressurePolicy::DropNewest:
+          ++stats_.dropped;
+          return Push::Dropped;
+
+        case BackpressurePolicy::DropOldest:
+          // A message larger than the whole budget can never fit.
+          if (size > options_.maxBytes || options_.maxMessages == 0)
+          {
+            ++stats_.dropped;
+            return Push::Dropped;
+          }
+
+          for (std::size_t i = WRITE_LANES; i-- > 1 && !fits(size);)
+          {
+            while (!lanes_[i].queue.empty() && !fits(size))
+            {
+              pop_front(lanes_[i]);
+              ++stats_.dropped;
+            }
+          }
+
+          append(l, std::move(message), size);
+          return Push::QueuedAfterShedding;
+
+        case BackpressurePolicy::ConflateByKey:
+          if (!message.key.empty() && replace_same_key(l, message, size))
+          {
+            compact_keys();
+            return within_limits() ? Push::QueuedAfterShedding : Push::Overflow;
+          }
+
+          compact_keys();
+
+          if (fits(size))
+          {
+            append(l, std::move(message), size);
+            return Push::QueuedAfterShedding;
+          }
+
+          return Push::Overflow;
+
+        case BackpressurePolicy::Close:
+        default:
+          return Push::Overflow;
+        }
+      }
+
+      /**
+       * @brief Queue @p message, replacing the pending one with its key.
+       *
+       * The replacement keeps the position of the message it overwrites, so
+       * a slow reader gets the freshest value without the queue growing.
+       * Keys are per lane. Without a pending message for the key, or on
+       * the Control lane, this is push().
+       */
+      Push push_conflated(MessageT &&message, WriteLane lane = WriteLane::Normal)
+      {
+        if (message.key.empty() || lane == WriteLane::Control || sealed_)
+        {
+          return push(std::move(message), lane);
+        }
+
+        Lane &l = lanes_[index_of(lane)];
+        const auto it = l.latest.find(std::string_view(message.key));
+        if (it == l.latest.end())
+        {
+          return push(std::move(message), lane);
+        }
+
+        MessageT &pending = l.queue[static_cast<std::size_t>(it->second - l.frontSeq)];
+        const std::size_t size = message.payload_size();
+        const std::size_t after = bytes_ - std::min(bytes_, pending.payload_size()) + size;
+        if (after - controlBytes_ > options_.maxBytes)
+        {
+          return push(std::move(message), lane);
+        }
+
+        pending = std::move(message);
+        bytes_ = after;
+        ++stats_.conflated;
+        stats_.highWaterBytes = std::max(stats_.highWaterBytes, bytes_);
+        return Push::Replaced;
+      }
+
+      /**
+       * @brief Queue the last message of the stream on the Control lane.
+       *
+       * It bypasses the limits and is popped only once everything queued
+       * before it is gone. Further pushes are dropped until clear().
+       *
+       * @return False if the queue was already sealed.
+       */
+      bool push_last(MessageT &&message)
+      {
+        if (sealed_)
+        {
+          return false;
+        }
+
+        const std::size_t size = message.payload_size();
+        append(lanes_[0], std::move(message), size);
+        sealed_ = true;
+        return true;
+      }
+
+      /** @brief True once push_last() queued the final message. */
+      bool sealed() const noexcept
+      {
+        return sealed_;
+      }
+
+      /**
+       * @brief Move the next batch into @p out, in scheduler order.
+       *
+       * The first message is always taken, even if it alone exceeds
+       * @p maxBytes. The batch ends after a message larger than
+       * @p splitAbove, so a message that will be fragmented comes last.
+       *
+       * @return Payload bytes moved.
+       */
+      std::size_t pop_batch(
+          std::vector<MessageT> &out,
+          std::size_t maxMessages,
+          std::size_t maxBytes,
+          std::size_t splitAbove = static_cast<std::size_t>(-1))
+      {
+        std::size_t batchBytes = 0;
+        const std::size_t first = out.size();
+
+        while (count_ != 0 && out.size() - first < maxMessages)
+        {
+          const std::size_t lane = next_lane();
+          Lane &l = lanes_[lane];
+
+          const std::size_t size = l.queue.front().payload_size();
+          if (out.size() != first && batchBytes + size > maxBytes)
+          {
+            break;
+          }
+
+          if (lane != 0)
+          {
+            --credits_[lane];
+          }
+
+          batchBytes += size;
+          take_front(l, out);
+
+          if (size > splitAbove)
+          {
+            break;
+          }
+        }
+
+        return batchBytes;
+      }
+
+      /**
+       * @brief Move every queued control frame into @p out.
+       *
+       * Control frames may be written between the fragments of a message;
+       * the final message of push_last() is left for pop_batch().
+       */
+      void pop_control(std::vector<MessageT> &out)
+      {
+        Lane &l = lanes_[0];
+        while (l.queue.size() > (sealed_ ? 1u : 0u))
+        {
+          take_front(l, out);
+        }
+      }
+
+      /** @brief Drop every queued message. */
+      void clear() noexcept
+      {
+        for (Lane &l : lanes_)
+        {
+          l.queue.clear();
+          l.latest.clear();
+          l.frontSeq = 0;
+        }
+        count_ = 0;
+        bytes_ = 0;
+        controlBytes_ = 0;
+        sealed_ = false;
+      }
+
+      bool empty() const noexcept
+      {
+        return count_ == 0;
+      }
+
+      std::size_t size() const noexcept
+      {
+        return count_;
+      }
+
+      /** @brief Messages queued on @p lane. */
+      std::size_t size(WriteLane lane) const noexcept
+      {
+        return lanes_[index_of(lane)].queue.size();
+      }
+
+      /** @brief Queued payload bytes. */
+      std::size_t bytes() const noexcept
+      {
+        return bytes_;
+      }
+
+      /** @brief Depth, high-water marks and shedding counters. */
+      WriteQueueStats stats() const noexcept
+      {
+        WriteQueueStats out = stats_;
+        out.messages = count_;
+        out.bytes = bytes_;
+        return out;
+      }
+
+    private:
+      /** @brief Lets key indexes be searched with a string_view. */
+      struct KeyHash
+      {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view key) const noexcept
+        {
+          return std::hash<std::string_view>{}(key);
+        }
+      };
+
+      struct Lane
+      {
+        std::deque<MessageT> queue{};
+
+        /** @brief Sequence number of queue.front(). */
+        std::uint64_t frontSeq{0};
+
+        /** @brief Key to sequence number of its newest queued message. */
+        std::unordered_map<std::string, std::uint64_t, KeyHash, std::equal_to<>> latest{};
+      };
+
+      static constexpr std::size_t index_of(WriteLane lane) noexcept
+      {
+        return static_cast<std::size_t>(lane);
+      }
+
+      /** @brief Whether a data message of @p size fits; Control is not counted. */
+      bool fits(std::size_t size) const noexcept
+      {
+        return count_ - lanes_[0].queue.size() < options_.maxMessages &&
+               bytes_ - controlBytes_ + size <= options_.maxBytes;
+      }
+
+      bool within_limits() const noexcept
+      {
+        return count_ - lanes_[0].queue.size() <= options_.maxMessages &&
+               bytes_ - controlBytes_ <= options_.maxBytes;
+      }
+
+      /** @brief True while the final message waits behind other messages. */
+      bool holding_last() const noexcept
+      {
+        return sealed_ && lanes_[0].queue.size() == 1 && count_ > 1;
+      }
+
+      /** @brief Lane of the next message; Control first, then by credit. */
+      std::size_t next_lane() noexcept
+      {
+        if (!lanes_[0].queue.empty() && !holding_last())
+        {
+          return 0;
+        }
+
+        for (int round = 0; round < 2; ++round)
+        {
+          for (std::size_t i = 1; i < WRITE_LANES; ++i)
+          {
+            if (!lanes_[i].queue.empty() && credits_[i] != 0)
+            {
+              return i;
+            }
+          }
+
+          credits_ = LANE_WEIGHTS;
+        }
+
+        // Unreachable while count_ != 0: a refill gives every lane credit.
+        return 1;
+      }
+
+      void append(Lane &l, MessageT &&message, std::size_t size)
+      {
+        if (!message.key.empty())
+        {
+          index(l, message.key, l.frontSeq + l.queue.size());
+        }
+
+        l.queue.push_back(std::move(message));
+        ++count_;
+        bytes_ += size;
+        if (&l == &lanes_[0])
+        {
+          controlBytes_ += size;
+        }
+
+        stats_.highWaterMessages = std::max(stats_.highWaterMessages, count_);
+        stats_.highWaterBytes = std::max(stats_.highWaterBytes, bytes_);
+      }
+
+      void take_front(Lane &l, std::vector<MessageT> &out)
+      {
+        release_bytes(l, l.queue.front().payload_size());
+        unindex_front(l);
+        out.push_back(std::move(l.queue.front()));
+        l.queue.pop_front();
+        ++l.frontSeq;
+        --count_;
+      }
+
+      void pop_front(Lane &l)
+      {
+        release_bytes(l, l.queue.front().payload_size());
+        unindex_front(l);
+        l.queue.pop_front();
+        ++l.frontSeq;
+        --count_;
+      }
+
+      void release_bytes(const Lane &l, std::size_t size) noexcept
+      {
+        bytes_ -= std::min(bytes_, size);
+        if (&l == &lanes_[0])
+        {
+          controlBytes_ -= std::min(controlBytes_, size);
+        }
+      }
+
+      static void index(Lane &l, const std::string &key, std::uint64_t seq)
+      {
+        const auto it = l.latest.find(std::string_view(key));
+        if (it != l.latest.end())
+        {
+          it->second = seq;
+          return;
+        }
+
+        l.latest.emplace(key, seq);
+      }
+
+      /** @brief Forget the front message if it is the newest of its key. */
+      static void unindex_front(Lane &l)
+      {
+        const std::string &key = l.queue.front().key;
+        if (key.empty())
+        {
+          return;
+        }
+
+        const auto it = l.latest.find(std::string_view(key));
+        if (it != l.latest.end() && it->second == l.frontSeq)
+        {
+          l.latest.erase(it);
+        }
+      }
+
+      /** @brief Overwrite the newest message on @p l sharing @p message's key. */
+      bool replace_same_key(Lane &l, MessageT &message, std::size_t size)
+      {
+        const auto it = l.latest.find(std::string_view(message.key));
+        if (it == l.latest.end())
+        {
+          return false;
+        }
+
+        MessageT &pending = l.queue[static_cast<std::size_t>(it->second - l.frontSeq)];
+        bytes_ = bytes_ - std::min(bytes_, pending.payload_size()) + size;
+        pending = std::move(message);
+        ++stats_.conflated;
+        stats_.highWaterBytes = std::max(stats_.highWaterBytes, bytes_);
+        return true;
+      }
+
+      /** @brief Erase every keyed message superseded by a later one in its lane. */
+      void compact_keys()
+      {
+        for (std::size_t lane = 1; lane < WRITE_LANES; ++lane)
+        {
+          Lane &l = lanes_[lane];
+          if (l.latest.empty())
+          {
+            continue;
+          }
+
+          std::unordered_set<std::string_view> seen;
+          std::deque<MessageT> kept;
+
+          // Walk newest to oldest so the latest message per key survives.
+          for (auto it = l.queue.rbegin(); it != l.queue.rend(); ++it)
+          {
+            if (!it->key.empty() && seen.contains(it->key))
+            {
+              bytes_ -= std::min(bytes_, it->payload_size());
+              --count_;
+              ++stats_.conflated;
+              continue;
+            }
+
+            kept.push_front(std::move(*it));
+            if (!kept.front().key.empty())
+            {
+              seen.insert(kept.front().key);
+            }
+          }
+
+          l.queue.swap(kept);
+
+          l.latest.clear();
+          for (std::size_t i = 0; i < l.queue.size(); ++i)
+          {
+            if (!l.queue[i].key.empty())
+            {
+              index(l, l.queue[i].key, l.frontSeq + i);
+            }
+          }
+        }
+      }
+
+      BackpressureOptions options_{};
+      std::array<Lane, WRITE_LANES> lanes_{};
+      std::array<std::uint32_t, WRITE_LANES> credits_ = LANE_WEIGHTS;
+      std::size_t count_{0};
+      std::size_t bytes_{0};
+
+      /** @brief Part of bytes_ queued on the Control lane. */
+      std::size_t controlBytes_{0};
+
+      /** @brief Set by push_last(); the back of the Control lane is final. */
+      bool sealed_{false};
+      WriteQueueStats stats_{};
+    };
+  } // namespace detail
+
+} // namespace vix::websocket
+
+#endif // VIX_WEBSOCKET_WRITE_QUEUE_HPP
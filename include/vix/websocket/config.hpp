@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include <vix/config/Config.hpp>
+#include <vix/websocket/WriteQueue.hpp>
 
 namespace vix::websocket
 {
@@ -39,12 +40,69 @@ namespace vix::websocket
     /** @brief Enable per-message deflate compression. */
     bool enablePerMessageDeflate = true;
 
+    /** @brief Outgoing messages smaller than this are sent uncompressed. */
+    std::size_t deflateMinSize = 256;
+
+    /** @brief Reset the compressor after every message (less memory, lower ratio). */
+    bool deflateServerNoContextTakeover = false;
+
+    /** @brief Upper bound on the compressor LZ77 window, 9..15. */
+    int deflateServerMaxWindowBits = 15;
+
     /** @brief Automatically handle ping/pong frames. */
     bool autoPingPong = true;
 
     /** @brief Interval at which ping frames are sent. */
     std::chrono::seconds pingInterval{30};
 
+    /**
+     * @brief Longest a graceful close waits for queued frames; 0 waits forever.
+     *
+     * When it expires the stream is closed without the remaining frames.
+     */
+    std::chrono::seconds closeTimeout{5};
+
+    /** @brief Maximum number of queued messages written in one flush. */
+    std::size_t writeBatchMaxMessages = 64;
+
+    /** @brief Maximum payload bytes drained into one flush (first message always goes). */
+    std::size_t writeBatchMaxBytes = 256 * 1024;
+
+    /**
+     * @brief Largest frame written for an outgoing data message; 0 disables.
+     *
+     * Longer messages are sent as fragments, and queued ping, pong and close
+     * frames are written between them instead of waiting for the whole
+     * message. Clients must support fragmented messages.
+     */
+    std::size_t writeFragmentSize = 0;
+
+    /**
+     * @brief Number of SO_REUSEPORT acceptors, each with its own IO thread.
+     *
+     * With more than one, sessions stay on the thread that accepted them.
+     * Values above 1 need a fixed port and a build with
+     * VIX_WEBSOCKET_REUSE_PORT; otherwise the engine refuses to start.
+     */
+    std::size_t acceptorThreads = 1;
+
+    /**
+     * @brief Keep session and room ownership on the accepting core.
+     *
+     * Each IO shard tracks its own sessions and room members without locks;
+     * broadcasts are handed to every shard through a lock-free queue and
+     * fanned out there. Needs acceptorThreads > 1: the cores are the
+     * acceptor shards, and the engine refuses to start with a single one.
+     */
+    bool sharedNothing = false;
+
+    /**
+     * @brief Default write queue limits and overflow policy of new sessions.
+     *
+     * Session::set_backpressure() overrides them for one session.
+     */
+    BackpressureOptions backpressure{};
+
     /**
      * @brief Build a WebSocket config from the core application config.
      */
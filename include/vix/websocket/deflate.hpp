@@ -0,0 +1,141 @@
+/**
+ *
+ *  @file deflate.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_DEFLATE_HPP
+#define VIX_WEBSOCKET_DEFLATE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief permessage-deflate parameters (RFC 7692 section 7.1).
+   *
+   * "server" parameters describe the compressor on our side, "client"
+   * parameters the compressor of the peer.
+   */
+  struct DeflateParams
+  {
+    /** @brief Reset our compressor after every message. */
+    bool serverNoContextTakeover{false};
+
+    /** @brief The peer resets its compressor after every message. */
+    bool clientNoContextTakeover{false};
+
+    /** @brief LZ77 window used by our compressor (9..15). */
+    int serverMaxWindowBits{15};
+
+    /** @brief LZ77 window used by the peer compressor (8..15). */
+    int clientMaxWindowBits{15};
+  };
+
+  /**
+   * @brief Result of a successful permessage-deflate negotiation.
+   */
+  struct DeflateNegotiation
+  {
+    /** @brief Parameters in effect for the connection. */
+    DeflateParams params{};
+
+    /** @brief Value for the Sec-WebSocket-Extensions response header. */
+    std::string responseHeader{};
+  };
+
+  /**
+   * @brief Pick the first acceptable permessage-deflate offer.
+   *
+   * @param offers Value of the client Sec-WebSocket-Extensions header.
+   * @param policy Server-side preferences: serverNoContextTakeover and
+   *        serverMaxWindowBits act as upper bounds on what is accepted.
+   * @return The accepted parameters and response header, or std::nullopt
+   *         if no offer can be accepted (the connection then proceeds
+   *         without compression).
+   */
+  std::optional<DeflateNegotiation> negotiate_permessage_deflate(
+      std::string_view offers,
+      const DeflateParams &policy);
+
+  /**
+   * @brief Per-connection permessage-deflate codec.
+   *
+   * Owns one raw-deflate compressor and one inflater. Both zlib streams are
+   * created lazily on first use, so connections that only exchange small
+   * messages do not pay for the compression window.
+   */
+  class PerMessageDeflate
+  {
+  public:
+    explicit PerMessageDeflate(const DeflateParams &params);
+    ~PerMessageDeflate();
+
+    PerMessageDeflate(const PerMessageDeflate &) = delete;
+    PerMessageDeflate &operator=(const PerMessageDeflate &) = delete;
+
+    /**
+     * @brief Compress one whole message.
+     *
+     * @param in Uncompressed message payload.
+     * @param out Replaced with the compressed payload, without the
+     *        trailing 0x00 0x00 0xff 0xff of the sync flush.
+     */
+    void compress(std::span<const std::byte> in, std::string &out);
+
+    /**
+     * @brief Inflate one chunk of a compressed message.
+     *
+     * Chunks of a message may be fed one at a time; set @p lastChunk on the
+     * final one so the flush trailer is appended and per-message state is
+     * reset.
+     *
+     * @param in Compressed bytes.
+     * @param lastChunk True for the final chunk of the message.
+     * @param out Decompressed bytes are appended here.
+     * @param maxMessageSize Upper bound on the decompressed message size.
+     *
+     * @throws std::runtime_error on corrupt input or when the message
+     *         inflates beyond @p maxMessageSize.
+     */
+    void decompress(
+        std::span<const std::byte> in,
+        bool lastChunk,
+        std::string &out,
+        std::size_t maxMessageSize);
+
+    /** @brief Negotiated parameters. */
+    const DeflateParams &params() const noexcept
+    {
+      return params_;
+    }
+
+  private:
+    struct Streams;
+
+    void inflate_into(
+        const unsigned char *data,
+        std::size_t size,
+        std::string &out,
+        std::size_t maxMessageSize);
+
+    DeflateParams params_;
+    std::unique_ptr<Streams> streams_;
+    std::size_t inflatedSize_{0};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_DEFLATE_HPP
@@ -0,0 +1,102 @@
+/**
+ *
+ *  @file handshake.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_HANDSHAKE_HPP
+#define VIX_WEBSOCKET_HANDSHAKE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief SHA-1 kernels used to compute the Sec-WebSocket-Accept key.
+   *
+   * Every handshake hashes the client key plus the RFC 6455 GUID, so
+   * reconnect storms are bound by this path.
+   */
+  enum class Sha1Kernel : std::uint8_t
+  {
+    /** @brief Portable kernel with a 16-word rolling message schedule. */
+    Scalar,
+    /** @brief Intel SHA extensions (x86, runtime detected). */
+    ShaNi,
+    /** @brief ARMv8 SHA1 instructions (AArch64 built with +crypto/+sha2). */
+    ArmSha,
+  };
+
+  /** @brief SHA-1 digest size in bytes. */
+  inline constexpr std::size_t SHA1_DIGEST_SIZE = 20;
+
+  /** @brief Length of a Sec-WebSocket-Accept value (base64 of a SHA-1 digest). */
+  inline constexpr std::size_t ACCEPT_KEY_SIZE = 28;
+
+  using Sha1Digest = std::array<unsigned char, SHA1_DIGEST_SIZE>;
+  using AcceptKey = std::array<char, ACCEPT_KEY_SIZE>;
+
+  /**
+   * @brief Return a stable lower-case name for a SHA-1 kernel.
+   */
+  const char *sha1_kernel_name(Sha1Kernel kernel) noexcept;
+
+  /**
+   * @brief Return true if @p kernel can run on the current CPU.
+   */
+  bool sha1_kernel_supported(Sha1Kernel kernel) noexcept;
+
+  /**
+   * @brief Return the kernel selected by runtime dispatch.
+   */
+  Sha1Kernel active_sha1_kernel() noexcept;
+
+  /**
+   * @brief SHA-1 of @p len bytes at @p data, without heap allocation.
+   */
+  Sha1Digest sha1_digest(const unsigned char *data, std::size_t len) noexcept;
+
+  /**
+   * @brief Same as sha1_digest(), but forces a specific kernel.
+   *
+   * Falls back to the scalar kernel if @p kernel is not supported.
+   */
+  Sha1Digest sha1_digest_with(
+      Sha1Kernel kernel,
+      const unsigned char *data,
+      std::size_t len) noexcept;
+
+  /** @brief Number of characters base64_encode_to() writes for @p len bytes. */
+  constexpr std::size_t base64_encoded_size(std::size_t len) noexcept
+  {
+    return ((len + 2) / 3) * 4;
+  }
+
+  /**
+   * @brief Base64-encode @p len bytes into @p out (padded, no terminator).
+   *
+   * @p out must have room for base64_encoded_size(@p len) characters.
+   */
+  void base64_encode_to(const unsigned char *data, std::size_t len, char *out) noexcept;
+
+  /**
+   * @brief Compute the Sec-WebSocket-Accept value for @p clientKey.
+   *
+   * Runs entirely on the stack: a conforming 24-character key plus the
+   * GUID is 60 bytes, which always hashes as exactly two blocks.
+   */
+  AcceptKey websocket_accept_key(std::string_view clientKey) noexcept;
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_HANDSHAKE_HPP
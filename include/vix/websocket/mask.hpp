@@ -0,0 +1,96 @@
+/**
+ *
+ *  @file mask.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_MASK_HPP
+#define VIX_WEBSOCKET_MASK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief Masking kernels available to the WebSocket frame codec.
+   *
+   * Every client-to-server frame is masked (RFC 6455 section 5.3), so
+   * unmasking sits on the hot ingress path. The best supported kernel is
+   * selected once at runtime; the others stay reachable for tests and
+   * benchmarks.
+   */
+  enum class MaskKernel : std::uint8_t
+  {
+    /** @brief Reference byte-at-a-time loop. */
+    Bytewise,
+    /** @brief Portable 64-bit word-at-a-time loop. */
+    Scalar64,
+    /** @brief 16-byte SSE2 loop (x86/x86-64). */
+    Sse2,
+    /** @brief 32-byte AVX2 loop (x86-64, runtime detected). */
+    Avx2,
+    /** @brief 16-byte NEON loop (ARMv7 with NEON, AArch64). */
+    Neon,
+  };
+
+  /**
+   * @brief Return a stable lower-case name for a masking kernel.
+   */
+  const char *mask_kernel_name(MaskKernel kernel) noexcept;
+
+  /**
+   * @brief Return true if @p kernel can run on the current CPU.
+   */
+  bool mask_kernel_supported(MaskKernel kernel) noexcept;
+
+  /**
+   * @brief Return the kernel selected by runtime dispatch.
+   */
+  MaskKernel active_mask_kernel() noexcept;
+
+  /**
+   * @brief XOR @p size bytes at @p data with a WebSocket mask key, in place.
+   *
+   * @p phase is the position inside the 4-byte key of the first byte, which
+   * lets a payload be unmasked chunk by chunk as it arrives. The return
+   * value is the phase for the byte following the last processed one.
+   *
+   * Unaligned head and tail bytes are handled internally; @p data has no
+   * alignment requirement.
+   *
+   * @param data Buffer to transform.
+   * @param size Number of bytes to transform.
+   * @param key Mask key from the frame header.
+   * @param phase Key offset of data[0], in [0, 3].
+   * @return Key offset for the next byte of the same payload.
+   */
+  std::size_t apply_mask(
+      std::byte *data,
+      std::size_t size,
+      const std::array<std::byte, 4> &key,
+      std::size_t phase = 0) noexcept;
+
+  /**
+   * @brief Same as apply_mask(), but forces a specific kernel.
+   *
+   * Falls back to the scalar kernel if @p kernel is not supported.
+   */
+  std::size_t apply_mask_with(
+      MaskKernel kernel,
+      std::byte *data,
+      std::size_t size,
+      const std::array<std::byte, 4> &key,
+      std::size_t phase = 0) noexcept;
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_MASK_HPP
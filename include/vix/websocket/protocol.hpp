@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -30,6 +31,8 @@
 
 #include <nlohmann/json.hpp>
 #include <vix/json/Simple.hpp>
+#include <vix/websocket/handshake.hpp>
+#include <vix/websocket/mask.hpp>
 
 namespace vix::websocket
 {
@@ -45,6 +48,65 @@ namespace vix::websocket
       Pong = 0xA,
     };
 
+    /** @brief True for Close, Ping and Pong (and reserved 0xB-0xF). */
+    inline bool is_control_opcode(Opcode opcode) noexcept
+    {
+      return (static_cast<std::uint8_t>(opcode) & 0x08) != 0;
+    }
+
+    /** @brief True for the opcodes defined by RFC 6455. */
+    inline bool is_known_opcode(Opcode opcode) noexcept
+    {
+      switch (opcode)
+      {
+      case Opcode::Continuation:
+      case Opcode::Text:
+      case Opcode::Binary:
+      case Opcode::Close:
+      case Opcode::Ping:
+      case Opcode::Pong:
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    /** @brief Close status codes used by the server (RFC 6455 section 7.4.1). */
+    enum class CloseCode : std::uint16_t
+    {
+      Normal = 1000,
+      GoingAway = 1001,
+      ProtocolError = 1002,
+      InvalidPayload = 1007,
+      PolicyViolation = 1008,
+      MessageTooBig = 1009,
+      InternalError = 1011,
+    };
+
+    /**
+     * @brief Error that ends the session with a specific close code.
+     *
+     * Thrown from the read path; the session answers with a Close frame
+     * carrying code() before dropping the connection.
+     */
+    class CloseError : public std::runtime_error
+    {
+    public:
+      CloseError(CloseCode code, const std::string &what)
+          : std::runtime_error(what),
+            code_(code)
+      {
+      }
+
+      CloseCode code() const noexcept
+      {
+        return code_;
+      }
+
+    private:
+      CloseCode code_;
+    };
+
     struct Frame
     {
       bool fin{true};
@@ -61,11 +123,40 @@ namespace vix::websocket
       }
     };
 
+    /**
+     * @brief Non-owning decoded frame whose payload lives in a receive buffer.
+     *
+     * The payload has already been unmasked in place. The view is only
+     * valid until the owning buffer is written to again.
+     */
+    struct FrameView
+    {
+      bool fin{true};
+      Opcode opcode{Opcode::Text};
+      bool masked{false};
+      bool rsv1{false};
+      std::span<std::byte> payload{};
+
+      std::string_view text_view() const noexcept
+      {
+        return std::string_view(
+            reinterpret_cast<const char *>(payload.data()),
+            payload.size());
+      }
+
+      std::string text() const
+      {
+        return std::string(text_view());
+      }
+    };
+
     struct FrameHeader
     {
       bool fin{true};
       Opcode opcode{Opcode::Text};
       bool masked{false};
+      /** @brief RSV1, set on the first frame of a compressed message (RFC 7692). */
+      bool rsv1{false};
       std::array<std::byte, 4> mask_key{};
       std::size_t payload_length{0};
       std::size_t header_size{0};
@@ -128,10 +219,7 @@ namespace vix::websocket
         std::vector<std::byte> &payload,
         const std::array<std::byte, 4> &mask_key)
     {
-      for (std::size_t i = 0; i < payload.size(); ++i)
-      {
-        payload[i] = payload[i] ^ mask_key[i % 4];
-      }
+      apply_mask(payload.data(), payload.size(), mask_key);
     }
 
     inline std::string trim_copy(std::string s)
@@ -225,174 +313,22 @@ namespace vix::websocket
       return false;
     }
 
-    inline std::uint32_t rol32(std::uint32_t value, std::uint32_t bits) noexcept
-    {
-      return (value << bits) | (value >> (32u - bits));
-    }
-
     inline std::array<unsigned char, 20> sha1_bytes(const unsigned char *data, std::size_t len)
     {
-      std::uint32_t h0 = 0x67452301u;
-      std::uint32_t h1 = 0xEFCDAB89u;
-      std::uint32_t h2 = 0x98BADCFEu;
-      std::uint32_t h3 = 0x10325476u;
-      std::uint32_t h4 = 0xC3D2E1F0u;
-
-      const std::uint64_t bit_len = static_cast<std::uint64_t>(len) * 8ull;
-
-      std::vector<unsigned char> msg(data, data + len);
-      msg.push_back(0x80u);
-
-      while ((msg.size() % 64u) != 56u)
-      {
-        msg.push_back(0x00u);
-      }
-
-      for (int i = 7; i >= 0; --i)
-      {
-        msg.push_back(static_cast<unsigned char>((bit_len >> (i * 8)) & 0xFFu));
-      }
-
-      for (std::size_t chunk = 0; chunk < msg.size(); chunk += 64)
-      {
-        std::uint32_t w[80]{};
-
-        for (int i = 0; i < 16; ++i)
-        {
-          const std::size_t j = chunk + static_cast<std::size_t>(i) * 4u;
-          w[i] = (static_cast<std::uint32_t>(msg[j]) << 24) |
-                 (static_cast<std::uint32_t>(msg[j + 1]) << 16) |
-                 (static_cast<std::uint32_t>(msg[j + 2]) << 8) |
-                 static_cast<std::uint32_t>(msg[j + 3]);
-        }
-
-        for (int i = 16; i < 80; ++i)
-        {
-          w[i] = rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
-        }
-
-        std::uint32_t a = h0;
-        std::uint32_t b = h1;
-        std::uint32_t c = h2;
-        std::uint32_t d = h3;
-        std::uint32_t e = h4;
-
-        for (int i = 0; i < 80; ++i)
-        {
-          std::uint32_t f = 0;
-          std::uint32_t k = 0;
-
-          if (i < 20)
-          {
-            f = (b & c) | ((~b) & d);
-            k = 0x5A827999u;
-          }
-          else if (i < 40)
-          {
-            f = b ^ c ^ d;
-            k = 0x6ED9EBA1u;
-          }
-          else if (i < 60)
-          {
-            f = (b & c) | (b & d) | (c & d);
-            k = 0x8F1BBCDCu;
-          }
-          else
-          {
-            f = b ^ c ^ d;
-            k = 0xCA62C1D6u;
-          }
-
-          const std::uint32_t temp = rol32(a, 5) + f + e + k + w[i];
-          e = d;
-          d = c;
-          c = rol32(b, 30);
-          b = a;
-          a = temp;
-        }
-
-        h0 += a;
-        h1 += b;
-        h2 += c;
-        h3 += d;
-        h4 += e;
-      }
-
-      std::array<unsigned char, 20> out{};
-      const std::uint32_t hs[5] = {h0, h1, h2, h3, h4};
-
-      for (std::size_t i = 0; i < 5; ++i)
-      {
-        out[i * 4 + 0] = static_cast<unsigned char>((hs[i] >> 24) & 0xFFu);
-        out[i * 4 + 1] = static_cast<unsigned char>((hs[i] >> 16) & 0xFFu);
-        out[i * 4 + 2] = static_cast<unsigned char>((hs[i] >> 8) & 0xFFu);
-        out[i * 4 + 3] = static_cast<unsigned char>(hs[i] & 0xFFu);
-      }
-
-      return out;
+      return sha1_digest(data, len);
     }
 
     inline std::string base64_encode(const unsigned char *data, std::size_t len)
     {
-      static constexpr char table[] =
-          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-      std::string out;
-      out.reserve(((len + 2u) / 3u) * 4u);
-
-      std::size_t i = 0;
-      while (i + 3u <= len)
-      {
-        const std::uint32_t n =
-            (static_cast<std::uint32_t>(data[i]) << 16) |
-            (static_cast<std::uint32_t>(data[i + 1]) << 8) |
-            static_cast<std::uint32_t>(data[i + 2]);
-
-        out.push_back(table[(n >> 18) & 0x3F]);
-        out.push_back(table[(n >> 12) & 0x3F]);
-        out.push_back(table[(n >> 6) & 0x3F]);
-        out.push_back(table[n & 0x3F]);
-
-        i += 3u;
-      }
-
-      const std::size_t rem = len - i;
-      if (rem == 1u)
-      {
-        const std::uint32_t n =
-            static_cast<std::uint32_t>(data[i]) << 16;
-
-        out.push_back(table[(n >> 18) & 0x3F]);
-        out.push_back(table[(n >> 12) & 0x3F]);
-        out.push_back('=');
-        out.push_back('=');
-      }
-      else if (rem == 2u)
-      {
-        const std::uint32_t n =
-            (static_cast<std::uint32_t>(data[i]) << 16) |
-            (static_cast<std::uint32_t>(data[i + 1]) << 8);
-
-        out.push_back(table[(n >> 18) & 0x3F]);
-        out.push_back(table[(n >> 12) & 0x3F]);
-        out.push_back(table[(n >> 6) & 0x3F]);
-        out.push_back('=');
-      }
-
+      std::string out(base64_encoded_size(len), '\0');
+      base64_encode_to(data, len, out.data());
       return out;
     }
 
-    inline std::string websocket_accept_from_key(const std::string &client_key)
+    inline std::string websocket_accept_from_key(std::string_view client_key)
     {
-      static constexpr const char *GUID =
-          "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-
-      const std::string input = client_key + GUID;
-      const auto digest = sha1_bytes(
-          reinterpret_cast<const unsigned char *>(input.data()),
-          input.size());
-
-      return base64_encode(digest.data(), digest.size());
+      const AcceptKey accept = websocket_accept_key(client_key);
+      return std::string(accept.data(), accept.size());
     }
 
     inline std::string generate_websocket_key()
@@ -444,75 +380,161 @@ namespace vix::websocket
       }
     }
 
-    inline std::vector<std::byte> build_frame(
+    /**
+     * @brief Encoded WebSocket frame header (at most 14 bytes).
+     *
+     * Produced by encode_frame_header() so that a frame can be written as
+     * header + caller-owned payload without copying the payload.
+     */
+    struct FrameHeaderBytes
+    {
+      std::array<std::byte, 14> bytes{};
+      std::size_t size{0};
+
+      std::span<const std::byte> view() const noexcept
+      {
+        return std::span<const std::byte>(bytes.data(), size);
+      }
+    };
+
+    /**
+     * @brief Encode only the header of a frame carrying @p payload_length bytes.
+     *
+     * When @p mask_key is provided the MASK bit is set and the key is
+     * appended; the caller is then responsible for masking the payload.
+     * @p rsv1 marks the payload as permessage-deflate compressed.
+     */
+    inline FrameHeaderBytes encode_frame_header(
         Opcode opcode,
-        const std::vector<std::byte> &payload,
+        std::size_t payload_length,
         bool fin,
-        bool masked)
+        const std::array<std::byte, 4> *mask_key = nullptr,
+        bool rsv1 = false) noexcept
     {
-      std::vector<std::byte> out;
-      out.reserve(14 + payload.size());
+      FrameHeaderBytes h;
+      std::size_t pos = 0;
 
-      const std::uint8_t b0 =
+      h.bytes[pos++] = to_byte(
           static_cast<std::uint8_t>((fin ? 0x80 : 0x00) |
-                                    (static_cast<std::uint8_t>(opcode) & 0x0F));
-      out.push_back(to_byte(b0));
+                                    (rsv1 ? 0x40 : 0x00) |
+                                    (static_cast<std::uint8_t>(opcode) & 0x0F)));
 
-      const std::size_t len = payload.size();
-      std::uint8_t b1 = masked ? 0x80 : 0x00;
+      const std::uint8_t mask_bit = mask_key ? 0x80 : 0x00;
 
-      if (len <= 125)
+      if (payload_length <= 125)
       {
-        b1 |= static_cast<std::uint8_t>(len);
-        out.push_back(to_byte(b1));
+        h.bytes[pos++] = to_byte(
+            static_cast<std::uint8_t>(mask_bit | payload_length));
       }
-      else if (len <= 0xFFFF)
+      else if (payload_length <= 0xFFFF)
       {
-        b1 |= 126;
-        out.push_back(to_byte(b1));
-        append_u16_be(out, static_cast<std::uint16_t>(len));
+        h.bytes[pos++] = to_byte(static_cast<std::uint8_t>(mask_bit | 126));
+        h.bytes[pos++] = to_byte(static_cast<std::uint8_t>((payload_length >> 8) & 0xFF));
+        h.bytes[pos++] = to_byte(static_cast<std::uint8_t>(payload_length & 0xFF));
       }
       else
       {
-        b1 |= 127;
-        out.push_back(to_byte(b1));
-        append_u64_be(out, static_cast<std::uint64_t>(len));
+        h.bytes[pos++] = to_byte(static_cast<std::uint8_t>(mask_bit | 127));
+        const auto len64 = static_cast<std::uint64_t>(payload_length);
+        for (int i = 7; i >= 0; --i)
+        {
+          h.bytes[pos++] = to_byte(static_cast<std::uint8_t>((len64 >> (i * 8)) & 0xFF));
+        }
       }
 
-      std::vector<std::byte> body = payload;
-
-      if (masked)
+      if (mask_key)
       {
-        const auto key = random_mask_key();
-        out.insert(out.end(), key.begin(), key.end());
-        apply_mask_in_place(body, key);
+        for (std::byte b : *mask_key)
+        {
+          h.bytes[pos++] = b;
+        }
       }
 
-      out.insert(out.end(), body.begin(), body.end());
-      return out;
+      h.size = pos;
+      return h;
     }
 
-    inline std::vector<std::byte> build_text_frame(std::string_view text, bool masked)
+    /**
+     * @brief View the bytes of a string payload without copying.
+     */
+    inline std::span<const std::byte> as_byte_span(std::string_view s) noexcept
     {
-      std::vector<std::byte> payload;
-      payload.reserve(text.size());
+      return std::span<const std::byte>(
+          reinterpret_cast<const std::byte *>(s.data()),
+          s.size());
+    }
 
-      for (char ch : text)
+    inline std::vector<std::byte> build_frame(
+        Opcode opcode,
+        std::span<const std::byte> payload,
+        bool fin,
+        bool masked)
+    {
+      std::array<std::byte, 4> key{};
+      if (masked)
       {
-        payload.push_back(static_cast<std::byte>(static_cast<unsigned char>(ch)));
+        key = random_mask_key();
       }
 
-      return build_frame(Opcode::Text, payload, true, masked);
+      const FrameHeaderBytes h =
+          encode_frame_header(opcode, payload.size(), fin, masked ? &key : nullptr);
+
+      std::vector<std::byte> out;
+      out.reserve(h.size + payload.size());
+      out.insert(out.end(), h.bytes.begin(), h.bytes.begin() + static_cast<std::ptrdiff_t>(h.size));
+      out.insert(out.end(), payload.begin(), payload.end());
+
+      if (masked)
+      {
+        apply_mask(out.data() + h.size, payload.size(), key);
+      }
+
+      return out;
+    }
+
+    inline std::vector<std::byte> build_frame(
+        Opcode opcode,
+        const std::vector<std::byte> &payload,
+        bool fin,
+        bool masked)
+    {
+      return build_frame(
+          opcode,
+          std::span<const std::byte>(payload.data(), payload.size()),
+          fin,
+          masked);
+    }
+
+    inline std::vector<std::byte> build_text_frame(std::string_view text, bool masked)
+    {
+      return build_frame(Opcode::Text, as_byte_span(text), true, masked);
     }
 
     inline std::vector<std::byte> build_ping_frame(bool masked)
     {
-      return build_frame(Opcode::Ping, {}, true, masked);
+      return build_frame(Opcode::Ping, std::span<const std::byte>{}, true, masked);
     }
 
     inline std::vector<std::byte> build_close_frame(bool masked)
     {
-      return build_frame(Opcode::Close, {}, true, masked);
+      return build_frame(Opcode::Close, std::span<const std::byte>{}, true, masked);
+    }
+
+    inline std::vector<std::byte> build_close_frame(bool masked, CloseCode code)
+    {
+      const auto value = static_cast<std::uint16_t>(code);
+      const std::array<std::byte, 2> payload = {
+          static_cast<std::byte>(value >> 8),
+          static_cast<std::byte>(value & 0xFF),
+      };
+      return build_frame(Opcode::Close, payload, true, masked);
+    }
+
+    inline std::vector<std::byte> build_pong_frame(
+        std::span<const std::byte> payload,
+        bool masked)
+    {
+      return build_frame(Opcode::Pong, payload, true, masked);
     }
 
     inline std::vector<std::byte> build_pong_frame(
@@ -522,6 +544,60 @@ namespace vix::websocket
       return build_frame(Opcode::Pong, payload, true, masked);
     }
 
+    /**
+     * @brief Immutable, reference-counted server frame.
+     *
+     * Encoded once and shared by every recipient of a broadcast; queuing it
+     * on a session only copies the pointer.
+     */
+    struct SharedFrame
+    {
+      /** @brief Header followed by the (unmasked) payload. */
+      std::shared_ptr<const std::vector<std::byte>> bytes{};
+
+      /** @brief Size of the encoded header at the front of @ref bytes. */
+      std::size_t header_size{0};
+
+      /** @brief Opcode of the frame. */
+      Opcode opcode{Opcode::Text};
+
+      explicit operator bool() const noexcept
+      {
+        return static_cast<bool>(bytes);
+      }
+
+      /** @brief Complete frame as it goes on the wire. */
+      std::span<const std::byte> wire() const noexcept
+      {
+        return bytes ? std::span<const std::byte>(*bytes) : std::span<const std::byte>{};
+      }
+
+      /** @brief Payload part of the frame. */
+      std::span<const std::byte> payload() const noexcept
+      {
+        return wire().subspan(header_size);
+      }
+    };
+
+    /**
+     * @brief Encode a final, unmasked frame once for fan-out to many sessions.
+     */
+    inline SharedFrame make_shared_frame(Opcode opcode, std::span<const std::byte> payload)
+    {
+      const FrameHeaderBytes h = encode_frame_header(opcode, payload.size(), true);
+
+      auto bytes = std::make_shared<std::vector<std::byte>>();
+      bytes->reserve(h.size + payload.size());
+      bytes->insert(bytes->end(), h.bytes.begin(), h.bytes.begin() + static_cast<std::ptrdiff_t>(h.size));
+      bytes->insert(bytes->end(), payload.begin(), payload.end());
+
+      SharedFrame frame;
+      frame.bytes = std::move(bytes);
+      frame.header_size = h.size;
+      frame.opcode = opcode;
+      return frame;
+    }
+
     inline FrameHeader parse_frame_header(const std::byte *data, std::size_t size)
     {
       if (size < 2)
@@ -532,8 +608,14 @@ namespace vix::websocket
       const std::uint8_t b0 = to_u8(data[0]);
       const std::uint8_t b1 = to_u8(data[1]);
 
+      if ((b0 & 0x30) != 0)
+      {
+        throw std::runtime_error("websocket frame uses reserved bits RSV2/RSV3");
+      }
+
       FrameHeader h;
       h.fin = (b0 & 0x80) != 0;
+      h.rsv1 = (b0 & 0x40) != 0;
       h.opcode = static_cast<Opcode>(b0 & 0x0F);
       h.masked = (b1 & 0x80) != 0;
 
@@ -590,6 +672,58 @@ namespace vix::websocket
       return h;
     }
 
+    /**
+     * @brief Full header size implied by the first two header bytes.
+     *
+     * Lets a reader wait for the extended length and mask key before
+     * calling parse_frame_header().
+     */
+    inline std::size_t frame_header_size(const std::byte *first_two) noexcept
+    {
+      const std::uint8_t b1 = to_u8(first_two[1]);
+      const std::uint8_t len7 = static_cast<std::uint8_t>(b1 & 0x7F);
+
+      std::size_t size = 2;
+      if (len7 == 126)
+      {
+        size += 2;
+      }
+      else if (len7 == 127)
+      {
+        size += 8;
+      }
+
+      if ((b1 & 0x80) != 0)
+      {
+        size += 4;
+      }
+
+      return size;
+    }
+
+    /**
+     * @brief Decode a complete frame in place, unmasking its payload.
+     *
+     * @param data Start of the frame; must hold header_size + payload_length bytes.
+     * @param h Header previously parsed from @p data.
+     */
+    inline FrameView decode_frame_in_place(std::byte *data, const FrameHeader &h) noexcept
+    {
+      FrameView f;
+      f.fin = h.fin;
+      f.opcode = h.opcode;
+      f.masked = h.masked;
+      f.rsv1 = h.rsv1;
+      f.payload = std::span<std::byte>(data + h.header_size, h.payload_length);
+
+      if (f.masked)
+      {
+        apply_mask(f.payload.data(), f.payload.size(), h.mask_key);
+      }
+
+      return f;
+    }
+
     inline Frame decode_frame(const std::vector<std::byte> &bytes)
     {
       if (bytes.size() < 2)
@@ -14,8 +14,11 @@
 #ifndef VIX_WEBSOCKET_ROUTER_HPP
 #define VIX_WEBSOCKET_ROUTER_HPP
 
+#include <cstddef>
 #include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace vix::websocket
@@ -37,6 +40,10 @@ namespace vix::websocket
     using CloseHandler = std::function<void(Session &)>;
     using ErrorHandler = std::function<void(Session &, const std::string &)>;
     using MessageHandler = std::function<void(Session &, std::string)>;
+    using MessageChunkHandler =
+        std::function<void(Session &, std::string_view chunk, bool isBinary, bool last)>;
+    using BinaryMessageHandler =
+        std::function<void(Session &, std::span<const std::byte> payload)>;
 
     Router() = default;
 
@@ -52,6 +59,25 @@ namespace vix::websocket
     /** @brief Register callback invoked on incoming text message. */
     void on_message(MessageHandler cb) { messageHandler_ = std::move(cb); }
 
+    /**
+     * @brief Register callback receiving data messages as a stream of chunks.
+     *
+     * When set, sessions switch to streaming mode: payload bytes are handed
+     * over as they arrive (possibly several chunks per frame) and the last
+     * chunk of a message has @p last set. Messages are never reassembled
+     * in memory and the on_message handler is not invoked.
+     */
+    void on_message_chunk(MessageChunkHandler cb) { messageChunkHandler_ = std::move(cb); }
+
+    /**
+     * @brief Register callback invoked on incoming binary message.
+     *
+     * The payload is a view into the session's receive buffer (or its
+     * reassembly/inflate buffer) and is only valid during the call. When
+     * set, binary messages no longer reach the on_message handler.
+     */
+    void on_binary_message(BinaryMessageHandler cb) { binaryMessageHandler_ = std::move(cb); }
+
     /** @brief Dispatch open event to the registered handler. */
     void handle_open(Session &session) const
     {
@@ -88,6 +114,28 @@ namespace vix::websocket
       }
     }
 
+    /** @brief Dispatch binary message event to the registered handler. */
+    void handle_binary_message(Session &session, std::span<const std::byte> payload) const
+    {
+      if (binaryMessageHandler_)
+      {
+        binaryMessageHandler_(session, payload);
+      }
+    }
+
+    /** @brief Dispatch one message chunk to the registered chunk handler. */
+    void handle_message_chunk(
+        Session &session,
+        std::string_view chunk,
+        bool isBinary,
+        bool last) const
+    {
+      if (messageChunkHandler_)
+      {
+        messageChunkHandler_(session, chunk, isBinary, last);
+      }
+    }
+
     /** @brief Return true if an open handler is registered. */
     bool has_open_handler() const noexcept
     {
@@ -112,11 +160,25 @@ namespace vix::websocket
       return static_cast<bool>(messageHandler_);
     }
 
+    /** @brief Return true if a binary message handler is registered. */
+    bool has_binary_message_handler() const noexcept
+    {
+      return static_cast<bool>(binaryMessageHandler_);
+    }
+
+    /** @brief Return true if a message chunk handler is registered. */
+    bool has_message_chunk_handler() const noexcept
+    {
+      return static_cast<bool>(messageChunkHandler_);
+    }
+
   private:
     OpenHandler openHandler_{};
     CloseHandler closeHandler_{};
     ErrorHandler errorHandler_{};
     MessageHandler messageHandler_{};
+    MessageChunkHandler messageChunkHandler_{};
+    BinaryMessageHandler binaryMessageHandler_{};
   };
 
 } // namespace vix::websocket
@@ -33,7 +33,9 @@
 #include <vix/executor/RuntimeExecutor.hpp>
 #include <vix/json/Simple.hpp>
 #include <vix/utils/Logger.hpp>
+#include <vix/websocket/CoreGroup.hpp>
 #include <vix/websocket/LongPollingBridge.hpp>
+#include <vix/websocket/SessionRegistry.hpp>
 #include <vix/websocket/protocol.hpp>
 #include <vix/websocket/router.hpp>
 #include <vix/websocket/session.hpp>
@@ -50,6 +52,10 @@ namespace vix::websocket
    *
    * This Vix version is independent of Boost and uses the generic executor
    * abstraction so it can run on different executor implementations. :contentReference[oaicite:0]{index=0}
+   *
+   * With websocket.shared_nothing enabled, room membership and broadcasts
+   * are owned per IO shard (see detail::BasicCoreGroup) instead of going
+   * through the shared registry. It needs websocket.acceptor_threads > 1.
    */
   class Server
   {
@@ -62,6 +68,10 @@ namespace vix::websocket
     using ErrorHandler = std::function<void(Session &, const std::string &)>;
     /** @brief Called on raw text frames. */
     using MessageHandler = std::function<void(Session &, const std::string &)>;
+    /** @brief Called with consecutive chunks of a streamed data message. */
+    using MessageChunkHandler = Router::MessageChunkHandler;
+    /** @brief Called on binary messages with a view of the payload. */
+    using BinaryMessageHandler = Router::BinaryMessageHandler;
     /** @brief Called on typed {type,payload} JSON messages. */
     using TypedMessageHandler =
         std::function<void(Session &, const std::string &, const vix::json::kvs &)>;
@@ -81,9 +91,8 @@ namespace vix::websocket
           executor_(std::move(executor)),
           router_(std::make_shared<Router>()),
           engine_(cfg_, executor_, router_),
-          sessionsMutex_(),
-          sessions_(),
-          rooms_(),
+          cores_(make_core_group()),
+          registry_(),
           longPollingBridge_(nullptr),
           userOnOpen_(),
           userOnClose_(),
@@ -111,9 +120,7 @@ namespace vix::websocket
       router_->on_close(
           [this](Session &s)
           {
-            auto sp = s.shared_from_this();
-            unregister_session(sp);
-            remove_session_from_all_rooms(sp);
+            unregister_session(s);
 
             if (userOnClose_)
             {
@@ -195,6 +202,30 @@ namespace vix::websocket
       userOnMessage_ = std::move(fn);
     }
 
+    /**
+     * @brief Stream data messages to @p fn chunk by chunk.
+     *
+     * Switches sessions to streaming mode: fragmented and large messages are
+     * delivered as they arrive instead of being reassembled, so on_message
+     * and on_typed_message no longer fire. Must be set before start().
+     */
+    void on_message_chunk(MessageChunkHandler fn)
+    {
+      router_->on_message_chunk(std::move(fn));
+    }
+
+    /**
+     * @brief Set the handler for binary messages.
+     *
+     * @p fn receives a view of the payload without copying it into a
+     * std::string; copy the bytes out to keep them past the call. Binary
+     * messages then bypass on_message. Must be set before start().
+     */
+    void on_binary_message(BinaryMessageHandler fn)
+    {
+      router_->on_binary_message(std::move(fn));
+    }
+
     /**
      * @brief Set the typed message handler for the {type,payload} JSON convention.
      *
@@ -226,21 +257,7 @@ namespace vix::websocket
      */
     void stop_async()
     {
-      std::vector<std::shared_ptr<Session>> live_sessions;
-
-      {
-        std::lock_guard<std::mutex> lock(sessionsMutex_);
-        cleanup_sessions_locked();
-
-        live_sessions.reserve(sessions_.size());
-        for (auto &weak : sessions_)
-        {
-          if (auto s = weak.lock())
-          {
-            live_sessions.push_back(std::move(s));
-          }
-        }
-      }
+      std::vector<std::shared_ptr<Session>> live_sessions = registry_.sessions();
 
       for (auto &session : live_sessions)
       {
@@ -303,15 +320,13 @@ namespace vix::websocket
     /**
      * @brief Return the current number of active WebSocket sessions.
      *
-     * Expired sessions are removed before counting.
+     * Sessions are counted from open until close.
      *
      * @return Number of currently alive sessions.
      */
     std::size_t active_session_count()
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-      cleanup_sessions_locked();
-      return sessions_.size();
+      return registry_.size();
     }
 
     /**
@@ -321,16 +336,43 @@ namespace vix::websocket
      */
     void broadcast_text(const std::string &text)
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-      cleanup_sessions_locked();
+      // Encoded once; each session only queues a reference to the frame.
+      broadcast_frame(
+          detail::make_shared_frame(detail::Opcode::Text, detail::as_byte_span(text)),
+          {});
+    }
 
-      for (auto &weak : sessions_)
-      {
-        if (auto s = weak.lock())
-        {
-          s->send_text(text);
-        }
-      }
+    /**
+     * @brief Broadcast a text frame that supersedes pending ones with @p key.
+     *
+     * Sessions that have not flushed the previous message with this key
+     * replace it in place (see Session::send_text_conflated()), so slow
+     * readers of state updates only get the latest value.
+     *
+     * @param key Conflation key, e.g. a metric or ticker name.
+     * @param text UTF-8 text payload.
+     */
+    void broadcast_text_conflated(const std::string &key, const std::string &text)
+    {
+      broadcast_frame(
+          detail::make_shared_frame(detail::Opcode::Text, detail::as_byte_span(text)),
+          key);
+    }
+
+    /**
+     * @brief Broadcast a typed JSON message conflated by @p key.
+     *
+     * @param key Conflation key.
+     * @param type Logical message type.
+     * @param payloadTokens Payload tokens forwarded to vix::json::kvs.
+     */
+    void broadcast_json_conflated(
+        const std::string &key,
+        const std::string &type,
+        std::initializer_list<vix::json::token> payloadTokens)
+    {
+      vix::json::kvs kv{payloadTokens};
+      broadcast_text_conflated(key, JsonMessage::serialize(type, kv));
     }
 
     /**
@@ -373,27 +415,13 @@ namespace vix::websocket
      */
     void join_room(Session &session, const RoomId &room)
     {
-      auto sp = session.shared_from_this();
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-
-      cleanup_sessions_locked();
-      cleanup_rooms_locked();
-
-      auto &vec = rooms_[room];
-
-      auto it = std::find_if(
-          vec.begin(),
-          vec.end(),
-          [&sp](const std::weak_ptr<Session> &w)
-          {
-            auto wp = w.lock();
-            return wp && wp.get() == sp.get();
-          });
-
-      if (it == vec.end())
+      if (cores_)
       {
-        vec.emplace_back(sp);
+        cores_->join(session.core_index(), session.shared_from_this(), room);
+        return;
       }
+
+      registry_.join(session.shared_from_this(), room);
     }
 
     /**
@@ -404,31 +432,13 @@ namespace vix::websocket
      */
     void leave_room(Session &session, const RoomId &room)
     {
-      auto sp = session.shared_from_this();
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-
-      auto itRoom = rooms_.find(room);
-      if (itRoom == rooms_.end())
+      if (cores_)
       {
+        cores_->leave(session.core_index(), &session, room);
         return;
       }
 
-      auto &vec = itRoom->second;
-      vec.erase(
-          std::remove_if(
-              vec.begin(),
-              vec.end(),
-              [&sp](const std::weak_ptr<Session> &w)
-              {
-                auto wp = w.lock();
-                return !wp || wp.get() == sp.get();
-              }),
-          vec.end());
-
-      if (vec.empty())
-      {
-        rooms_.erase(itRoom);
-      }
+      registry_.leave(&session, room);
     }
 
     /**
@@ -438,9 +448,13 @@ namespace vix::websocket
      */
     void leave_all_rooms(Session &session)
     {
-      auto sp = session.shared_from_this();
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-      remove_session_from_all_rooms_locked(sp);
+      if (cores_)
+      {
+        cores_->leave_all(session.core_index(), &session);
+        return;
+      }
+
+      registry_.leave_all(&session);
     }
 
     /**
@@ -451,25 +465,26 @@ namespace vix::websocket
      */
     void broadcast_room_text(const RoomId &room, const std::string &text)
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-
-      cleanup_sessions_locked();
-      cleanup_rooms_locked();
+      const detail::SharedFrame frame =
+          detail::make_shared_frame(detail::Opcode::Text, detail::as_byte_span(text));
 
-      auto it = rooms_.find(room);
-      if (it == rooms_.end())
+      if (cores_)
       {
+        cores_->broadcast_room(
+            room,
+            [frame](Session &s)
+            {
+              s.send_frame(frame);
+            });
         return;
       }
 
-      auto &vec = it->second;
-      for (auto &weak : vec)
-      {
-        if (auto s = weak.lock())
-        {
-          s->send_text(text);
-        }
-      }
+      registry_.for_each_in_room(
+          room,
+          [&frame](Session &s)
+          {
+            s.send_frame(frame);
+          });
     }
 
     /**
@@ -516,142 +531,108 @@ namespace vix::websocket
     }
 
     /**
-     * @brief Return the currently attached long-polling bridge.
+     * @brief Attach a metrics sink updated by every session.
      *
-     * @return Shared bridge instance, or null if none is attached.
+     * Must be called before start().
+     *
+     * @param metrics Shared metrics instance.
      */
-    std::shared_ptr<LongPollingBridge> long_polling_bridge() const noexcept
+    void attach_metrics(std::shared_ptr<WebSocketMetrics> metrics)
     {
-      return longPollingBridge_;
+      engine_.attach_metrics(std::move(metrics));
     }
 
-  private:
     /**
-     * @brief Track a newly opened session.
+     * @brief Return the currently attached long-polling bridge.
      *
-     * @param s Shared session instance.
+     * @return Shared bridge instance, or null if none is attached.
      */
-    void register_session(std::shared_ptr<Session> s)
+    std::shared_ptr<LongPollingBridge> long_polling_bridge() const noexcept
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-      sessions_.emplace_back(std::move(s));
+      return longPollingBridge_;
     }
 
+  private:
     /**
-     * @brief Remove a session from the tracked session list.
+     * @brief Queue a shared frame on every session.
      *
-     * @param s Shared session instance.
+     * @param frame Pre-encoded frame.
+     * @param key Conflation key; empty for a plain broadcast.
      */
-    void unregister_session(std::shared_ptr<Session> s)
+    void broadcast_frame(const detail::SharedFrame &frame, const std::string &key)
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
+      auto send = [frame, key](Session &s)
+      {
+        if (key.empty())
+        {
+          s.send_frame(frame);
+        }
+        else
+        {
+          s.send_frame_conflated(key, frame);
+        }
+      };
 
-      sessions_.erase(
-          std::remove_if(
-              sessions_.begin(),
-              sessions_.end(),
-              [&s](const std::weak_ptr<Session> &w)
-              {
-                auto sp = w.lock();
-                return !sp || sp.get() == s.get();
-              }),
-          sessions_.end());
-    }
+      if (cores_)
+      {
+        cores_->broadcast(send);
+        return;
+      }
 
-    /**
-     * @brief Drop expired sessions from the global session list.
-     *
-     * Must be called while holding sessionsMutex_.
-     */
-    void cleanup_sessions_locked()
-    {
-      sessions_.erase(
-          std::remove_if(
-              sessions_.begin(),
-              sessions_.end(),
-              [](const std::weak_ptr<Session> &w)
-              {
-                return w.expired();
-              }),
-          sessions_.end());
+      registry_.for_each_session(send);
     }
 
     /**
-     * @brief Drop expired sessions from rooms and remove empty rooms.
+     * @brief Track a newly opened session.
      *
-     * Must be called while holding sessionsMutex_.
+     * @param s Shared session instance.
      */
-    void cleanup_rooms_locked()
+    void register_session(const std::shared_ptr<Session> &s)
     {
-      for (auto it = rooms_.begin(); it != rooms_.end();)
+      registry_.add(s);
+
+      if (cores_)
       {
-        auto &vec = it->second;
-        vec.erase(
-            std::remove_if(
-                vec.begin(),
-                vec.end(),
-                [](const std::weak_ptr<Session> &w)
-                {
-                  return w.expired();
-                }),
-            vec.end());
-
-        if (vec.empty())
-        {
-          it = rooms_.erase(it);
-        }
-        else
-        {
-          ++it;
-        }
+        cores_->add(s->core_index(), s);
       }
     }
 
     /**
-     * @brief Remove a session from all rooms.
-     *
-     * This overload acquires the internal session mutex.
+     * @brief Stop tracking a session and drop it from the rooms it joined.
      *
-     * @param s Shared session instance.
+     * @param s Closing session.
      */
-    void remove_session_from_all_rooms(std::shared_ptr<Session> s)
+    void unregister_session(Session &s)
     {
-      std::lock_guard<std::mutex> lock(sessionsMutex_);
-      remove_session_from_all_rooms_locked(std::move(s));
+      registry_.remove(&s);
+
+      if (cores_)
+      {
+        cores_->remove(s.core_index(), &s);
+      }
     }
 
     /**
-     * @brief Remove a session from all rooms.
+     * @brief Build the per-shard ownership tables in shared-nothing mode.
      *
-     * Requires sessionsMutex_ to already be held.
+     * The engine has already refused a single shard, so there is always
+     * more than one core.
      *
-     * @param s Shared session instance.
+     * @return Core group with one core per IO shard, or null.
      */
-    void remove_session_from_all_rooms_locked(std::shared_ptr<Session> s)
+    std::unique_ptr<detail::BasicCoreGroup<Session>> make_core_group()
     {
-      for (auto it = rooms_.begin(); it != rooms_.end();)
+      if (!engine_.shared_nothing())
       {
-        auto &vec = it->second;
-        vec.erase(
-            std::remove_if(
-                vec.begin(),
-                vec.end(),
-                [&s](const std::weak_ptr<Session> &w)
-                {
-                  auto sp = w.lock();
-                  return !sp || sp.get() == s.get();
-                }),
-            vec.end());
-
-        if (vec.empty())
-        {
-          it = rooms_.erase(it);
-        }
-        else
-        {
-          ++it;
-        }
+        return nullptr;
       }
+
+      return std::make_unique<detail::BasicCoreGroup<Session>>(
+          engine_.shard_count(),
+          [this](std::size_t core, std::function<void()> fn)
+          {
+            engine_.post_to_shard(core, std::move(fn));
+          });
     }
 
   private:
@@ -667,14 +648,11 @@ namespace vix::websocket
     /** @brief Low-level WebSocket server engine. */
     LowLevelServer engine_;
 
-    /** @brief Mutex protecting sessions_ and rooms_. */
-    std::mutex sessionsMutex_;
-
-    /** @brief Weak list of active sessions. */
-    std::vector<std::weak_ptr<Session>> sessions_;
+    /** @brief Per-shard session and room ownership; null unless shared-nothing. */
+    std::unique_ptr<detail::BasicCoreGroup<Session>> cores_;
 
-    /** @brief Room membership table. */
-    std::unordered_map<RoomId, std::vector<std::weak_ptr<Session>>> rooms_;
+    /** @brief Sharded table of active sessions and room memberships. */
+    detail::BasicSessionRegistry<Session> registry_;
 
     /** @brief Optional long-polling bridge receiving typed WebSocket events. */
     std::shared_ptr<LongPollingBridge> longPollingBridge_;
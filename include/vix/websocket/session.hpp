@@ -17,12 +17,12 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <vector>
 #include <atomic>
 
@@ -32,8 +32,17 @@
 #include <vix/async/net/tcp.hpp>
 #include <vix/executor/RuntimeExecutor.hpp>
 #include <vix/utils/Logger.hpp>
+#include <vix/websocket/Metrics.hpp>
 #include <vix/websocket/config.hpp>
+#include <vix/websocket/deflate.hpp>
+#include <vix/websocket/ReadBuffer.hpp>
+#include <vix/websocket/SendCompletion.hpp>
+#include <vix/websocket/TimerWheel.hpp>
+#include <vix/websocket/UpgradeParser.hpp>
+#include <vix/websocket/utf8.hpp>
+#include <vix/websocket/WriteQueue.hpp>
 #include <vix/websocket/protocol.hpp>
+#include <vix/websocket/MessageAssembler.hpp>
 #include <vix/websocket/router.hpp>
 
 namespace vix::websocket
@@ -67,13 +76,21 @@ namespace vix::websocket
      * @param cfg WebSocket runtime configuration.
      * @param router Event router for open, close, message, and error callbacks.
      * @param executor Runtime executor used for async scheduling and continuations.
+     * @param ioc IO context driving this session.
+     * @param metrics Optional metrics sink shared with the server.
+     * @param timers Shared timing wheel driving idle timeout and heartbeat;
+     *        without it neither is enforced.
+     * @param coreIndex IO shard that accepted the session and owns it.
      */
     Session(
         std::unique_ptr<tcp_stream> stream,
         const Config &cfg,
         std::shared_ptr<Router> router,
         std::shared_ptr<vix::executor::RuntimeExecutor> executor,
-        std::shared_ptr<io_context> ioc);
+        std::shared_ptr<io_context> ioc,
+        std::shared_ptr<WebSocketMetrics> metrics = nullptr,
+        std::shared_ptr<detail::TimerWheel> timers = nullptr,
+        std::size_t coreIndex = 0);
 
     ~Session() = default;
 
@@ -88,20 +105,170 @@ namespace vix::websocket
      * @brief Send a text frame to the client.
      *
      * @param text UTF-8 text payload.
+     * @param key Conflation key. When the queue is full under the
+     *        ConflateByKey policy, only the latest message per key is kept.
      */
-    void send_text(std::string_view text);
+    void send_text(std::string_view text, std::string_view key = {});
 
     /**
      * @brief Send a binary frame to the client.
      *
      * @param data Pointer to binary payload.
      * @param size Binary payload size in bytes.
+     * @param key Conflation key. When the queue is full under the
+     *        ConflateByKey policy, only the latest message per key is kept.
      */
-    void send_binary(const void *data, std::size_t size);
+    void send_binary(const void *data, std::size_t size, std::string_view key = {});
+
+    /**
+     * @brief Queue a pre-encoded shared frame.
+     *
+     * Used for broadcasts: the frame is encoded once and every session only
+     * queues a reference to it. If the session negotiated permessage-deflate
+     * and the payload reaches Config::deflateMinSize, the payload is
+     * compressed for this session when it is flushed instead.
+     *
+     * @param frame Frame built with detail::make_shared_frame().
+     * @param key Conflation key. When the queue is full under the
+     *        ConflateByKey policy, only the latest message per key is kept.
+     */
+    void send_frame(detail::SharedFrame frame, std::string_view key = {});
+
+    /**
+     * @brief Send a text frame on the lane of @p priority.
+     *
+     * High-priority messages overtake queued Normal and Bulk ones at the
+     * next flush; see detail::BasicWriteQueue for the weights.
+     *
+     * @param text UTF-8 text payload.
+     * @param priority Scheduling class.
+     */
+    void send_text(std::string_view text, SendPriority priority);
+
+    /**
+     * @brief Send a binary frame on the lane of @p priority.
+     *
+     * @param data Pointer to binary payload.
+     * @param size Binary payload size in bytes.
+     * @param priority Scheduling class.
+     */
+    void send_binary(const void *data, std::size_t size, SendPriority priority);
+
+    /**
+     * @brief Queue a pre-encoded shared frame on the lane of @p priority.
+     *
+     * @param frame Frame built with detail::make_shared_frame().
+     * @param priority Scheduling class.
+     */
+    void send_frame(detail::SharedFrame frame, SendPriority priority);
+
+    /**
+     * @brief Send a text frame and report when it has been written.
+     *
+     * @p onSent runs once on the session's IO context: after the frame was
+     * handed to the socket, or when it was rejected or dropped.
+     *
+     * @param text UTF-8 text payload.
+     * @param onSent Completion callback.
+     * @param priority Scheduling class.
+     */
+    void send_text(
+        std::string_view text,
+        SendCallback onSent,
+        SendPriority priority = SendPriority::Normal);
+
+    /**
+     * @brief Send a binary frame and report when it has been written.
+     *
+     * @param data Pointer to binary payload.
+     * @param size Binary payload size in bytes.
+     * @param onSent Completion callback, see send_text().
+     * @param priority Scheduling class.
+     */
+    void send_binary(
+        const void *data,
+        std::size_t size,
+        SendCallback onSent,
+        SendPriority priority = SendPriority::Normal);
+
+    /**
+     * @brief Queue a text frame; `co_await` the result for its SendReceipt.
+     *
+     * The payload is copied and queued immediately, so sends keep the order
+     * of the calls even if the awaitables are awaited later or not at all.
+     *
+     * @param text UTF-8 text payload.
+     * @param priority Scheduling class.
+     * @return Awaitable completed once the frame is written or discarded.
+     */
+    SendAwaitable async_send_text(
+        std::string_view text,
+        SendPriority priority = SendPriority::Normal);
+
+    /**
+     * @brief Queue a binary frame; `co_await` the result for its SendReceipt.
+     *
+     * @param data Pointer to binary payload.
+     * @param size Binary payload size in bytes.
+     * @param priority Scheduling class.
+     * @return Awaitable completed once the frame is written or discarded.
+     */
+    SendAwaitable async_send_binary(
+        const void *data,
+        std::size_t size,
+        SendPriority priority = SendPriority::Normal);
+
+    /**
+     * @brief Total bytes written to the socket by the write queue.
+     */
+    std::uint64_t bytes_flushed() const noexcept
+    {
+      return bytesFlushed_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Send a text frame that supersedes any pending one with @p key.
+     *
+     * If a message with the same key is still queued, it is overwritten in
+     * place, so a slow reader only receives the latest value per key and
+     * the queue stays bounded by the number of keys.
+     *
+     * @param key Conflation key, e.g. a ticker symbol or metric name.
+     * @param text UTF-8 text payload.
+     */
+    void send_text_conflated(std::string_view key, std::string_view text);
+
+    /**
+     * @brief Queue a shared frame that supersedes any pending one with @p key.
+     *
+     * Broadcast counterpart of send_text_conflated().
+     *
+     * @param key Conflation key.
+     * @param frame Frame built with detail::make_shared_frame().
+     */
+    void send_frame_conflated(std::string_view key, detail::SharedFrame frame);
+
+    /**
+     * @brief Override the write queue limits and overflow policy.
+     *
+     * Applies to messages queued from now on; the defaults come from
+     * Config::backpressure.
+     *
+     * @param options New limits and policy.
+     */
+    void set_backpressure(const BackpressureOptions &options);
+
+    /**
+     * @brief Return the write queue depth, high-water marks and shed counts.
+     */
+    WriteQueueStats write_queue_stats();
 
     /**
      * @brief Close the session with an optional close reason.
      *
+     * The close frame is queued behind every pending frame. If the queue has
+     * not drained within Config::closeTimeout, the stream is closed anyway.
+     *
      * @param reason Optional application-level close reason.
      */
     void close(std::string reason = {});
@@ -116,6 +283,17 @@ namespace vix::websocket
       return open_;
     }
 
+    /**
+     * @brief Return the IO shard that owns this session.
+     *
+     * Session callbacks run on that shard's thread; in shared-nothing mode
+     * its room memberships live on the same core.
+     */
+    std::size_t core_index() const noexcept
+    {
+      return coreIndex_;
+    }
+
     /**
      * @brief Emit an error to the router error handler.
      *
@@ -132,6 +310,33 @@ namespace vix::websocket
     void shutdown_now() noexcept;
 
   private:
+    /**
+     * @brief Pending outgoing message descriptor.
+     */
+    struct PendingMessage
+    {
+      /** @brief True if the payload must be sent as binary. */
+      bool isBinary{false};
+
+      /** @brief Raw payload bytes stored as string. */
+      std::string data{};
+
+      /** @brief Shared pre-encoded frame; when set, @ref data is unused. */
+      detail::SharedFrame frame{};
+
+      /** @brief Conflation key; empty if the message is never superseded. */
+      std::string key{};
+
+      /** @brief Completion of a tracked send; empty for fire-and-forget. */
+      detail::SendCompletion completion{};
+
+      /** @brief Payload size accounted against the queue limits. */
+      std::size_t payload_size() const noexcept
+      {
+        return frame ? frame.payload().size() : data.size();
+      }
+    };
+
     /**
      * @brief Perform the HTTP Upgrade handshake.
      *
@@ -147,22 +352,88 @@ namespace vix::websocket
     task<void> do_read_loop();
 
     /**
-     * @brief Read one WebSocket frame from the stream.
+     * @brief Read and validate the header of the next frame.
+     *
+     * The header bytes stay in the read buffer; read_frame() or
+     * stream_frame_payload() consumes them.
+     *
+     * @return Parsed frame header.
+     */
+    task<detail::FrameHeader> read_frame_header();
+
+    /**
+     * @brief Read the rest of the frame whose header was just parsed.
+     *
+     * The returned view points into the session read buffer and is valid
+     * until the next read.
+     *
+     * @param h Header returned by read_frame_header().
+     * @return Parsed frame with its payload unmasked in place.
+     */
+    task<detail::FrameView> read_frame(const detail::FrameHeader &h);
+
+    /**
+     * @brief Forward a data frame payload to the chunk handler as it arrives.
+     *
+     * The payload is unmasked and dispatched one read at a time, so a frame
+     * never has to be fully buffered.
+     *
+     * @param h Header returned by read_frame_header().
+     * @param isBinary True if the message being streamed is binary.
+     */
+    task<void> stream_frame_payload(const detail::FrameHeader &h, bool isBinary);
+
+    /**
+     * @brief Inflate one complete compressed message.
+     *
+     * @param payload Compressed message payload.
+     * @return Decompressed message.
+     */
+    std::string inflate_message(std::span<const std::byte> payload);
+
+    /**
+     * @brief Feed one piece of an inbound text message to the UTF-8 validator.
+     *
+     * @throws detail::CloseError with code 1007 on invalid UTF-8.
+     */
+    void check_text_chunk(std::string_view chunk, bool last);
+
+    [[noreturn]] static void throw_invalid_utf8();
+
+    /**
+     * @brief Feed one buffered data frame to the reassembler.
      *
-     * @return Parsed frame.
+     * Dispatches the message to the router once its FIN frame arrives.
+     *
+     * @param frame Data frame (Text, Binary or Continuation).
      */
-    task<detail::Frame> read_frame();
+    void on_data_frame(const detail::FrameView &frame);
 
     /**
-     * @brief Arm the idle timeout scope.
+     * @brief Record inbound activity for the idle timeout (one relaxed store).
+     */
+    void note_activity() noexcept;
+
+    /**
+     * @brief Arm the idle timeout on the shared timing wheel.
      */
     void arm_idle_timer();
 
     /**
-     * @brief Cancel the idle timeout scope.
+     * @brief Cancel the idle timeout.
      */
     void cancel_idle_timer();
 
+    /**
+     * @brief Idle timer expiry: close if idle long enough, otherwise re-arm.
+     */
+    void on_idle_timer();
+
+    /**
+     * @brief Heartbeat timer expiry: queue a ping and re-arm.
+     */
+    void on_heartbeat_timer();
+
     /**
      * @brief Handle idle timeout expiry.
      *
@@ -173,10 +444,52 @@ namespace vix::websocket
     /**
      * @brief Enqueue an outgoing message.
      *
-     * @param isBinary True for a binary frame, false for a text frame.
-     * @param payload Frame payload to queue.
+     * @param message Message to queue.
+     * @param conflate Overwrite the pending message with the same key.
+     * @param lane Write queue lane.
      */
-    void do_enqueue_message(bool isBinary, std::string payload);
+    void do_enqueue_message(
+        PendingMessage message,
+        bool conflate = false,
+        detail::WriteLane lane = detail::WriteLane::Normal);
+
+    /**
+     * @brief Queue a close frame behind every pending frame.
+     *
+     * The frame goes last on the Control lane; the flush loop closes the
+     * stream once it is written. The caller holds writeMutex_ and triggers
+     * the flush after releasing it.
+     *
+     * @param code Status code, or none for an empty close frame.
+     * @return False if a close frame was already queued or the stream is down.
+     */
+    bool queue_close_frame(std::optional<detail::CloseCode> code);
+
+    /**
+     * @brief Close without draining, for peers that stopped reading.
+     *
+     * Drops the write queue, writes a close frame unless a write is still
+     * in flight, and closes the stream. Used on backpressure and idle timeout.
+     */
+    void close_now();
+
+    /**
+     * @brief Arm the Config::closeTimeout deadline of a closing session.
+     */
+    void arm_close_timer();
+
+    /**
+     * @brief Close deadline expiry: close the stream.
+     */
+    void on_close_timer();
+
+    /**
+     * @brief Wrap @p onSent so it runs on the session's IO context.
+     *
+     * Completions fire under the write lock or inside the flush loop;
+     * posting keeps callbacks free to send again.
+     */
+    detail::SendCompletion make_completion(SendCallback onSent);
 
     /**
      * @brief Trigger flushing of queued outgoing messages.
@@ -192,11 +505,62 @@ namespace vix::websocket
     task<void> write_raw_frame(const std::vector<std::byte> &frame);
 
     /**
-     * @brief Read one HTTP request head for the Upgrade request.
+     * @brief Write a frame given as an encoded header and a payload view.
+     *
+     * The payload is not copied into an intermediate frame buffer; it must
+     * stay alive until the returned task completes.
      *
-     * @return Raw HTTP request head.
+     * @param header Encoded frame header (see detail::encode_frame_header).
+     * @param payload Unmasked payload bytes.
+     * @return Task representing the write operation.
      */
-    task<std::string> read_http_head();
+    task<void> write_raw_frame(
+        std::span<const std::byte> header,
+        std::span<const std::byte> payload);
+
+    /**
+     * @brief Write a list of byte segments as one logical write.
+     *
+     * Segments up to WRITE_COALESCE_LIMIT are copied into one buffer and
+     * written together; larger ones are written from their own storage.
+     *
+     * @param segments Segments to write, in order.
+     * @return Task representing the write operation.
+     */
+    task<void> write_gather(std::span<const std::span<const std::byte>> segments);
+
+    /**
+     * @brief Encode flushBatch_ into flushSegments_.
+     *
+     * Compresses payloads when permessage-deflate is active. A last data
+     * message above Config::writeFragmentSize becomes the fragmented message
+     * and only its next fragment is encoded.
+     *
+     * @return Messages written in full by this batch; a fragmented message
+     *         counts with its last fragment.
+     */
+    std::size_t encode_write_batch();
+
+    /**
+     * @brief Append the next fragment of the fragmented message to flushSegments_.
+     */
+    void encode_next_fragment();
+
+    /**
+     * @brief Write all bytes to the underlying TCP stream.
+     *
+     * @param bytes Bytes to write.
+     * @return Task representing the write operation.
+     */
+    task<void> write_all(std::span<const std::byte> bytes);
+
+    /**
+     * @brief Read and parse the HTTP head of the Upgrade request.
+     *
+     * @return Views into the read buffer; the head is left unconsumed
+     *         (see UpgradeRequest::headSize).
+     */
+    task<detail::UpgradeRequest> read_http_head();
 
     /**
      * @brief Ensure at least @p n bytes are available in the internal read buffer.
@@ -210,9 +574,12 @@ namespace vix::websocket
      * @brief Send the HTTP Upgrade success response.
      *
      * @param accept_key Computed Sec-WebSocket-Accept value.
+     * @param extensions Negotiated Sec-WebSocket-Extensions value, if any.
      * @return Task representing the response write.
      */
-    task<void> send_upgrade_response(const std::string &accept_key);
+    task<void> send_upgrade_response(
+        std::string_view accept_key,
+        std::string_view extensions);
 
     /**
      * @brief Close only the underlying TCP stream.
@@ -232,7 +599,10 @@ namespace vix::websocket
     void stop_heartbeat();
 
     static task<void> flush_write_loop(std::shared_ptr<Session> self);
-    static task<void> close_sequence(std::shared_ptr<Session> self);
+    static task<void> close_sequence(std::shared_ptr<Session> self, bool closeQueued);
+    static task<void> abort_sequence(std::shared_ptr<Session> self);
+    static task<void> close_deadline_sequence(std::shared_ptr<Session> self);
+    static task<void> idle_timeout_sequence(std::shared_ptr<Session> self);
 
   private:
     /** @brief Accepted native TCP stream owned by this session. */
@@ -251,15 +621,33 @@ namespace vix::websocket
     std::shared_ptr<io_context> ioc_{};
 
     /** @brief Internal read buffer used for HTTP and frame parsing. */
-    std::string readBuffer_{};
+    detail::ReadBuffer readBuffer_{};
+
+    /** @brief Reassembly state for fragmented data messages. */
+    detail::MessageAssembler assembler_;
+
+    /** @brief UTF-8 state of the inbound text message in progress. */
+    detail::Utf8Validator utf8_{};
+
+    /** @brief permessage-deflate codec, set when the extension was negotiated. */
+    std::unique_ptr<detail::PerMessageDeflate> deflate_{};
+
+    /** @brief True while the inbound message in progress is compressed. */
+    bool inboundCompressed_{false};
+
+    /** @brief Reusable buffer for inflated streaming chunks. */
+    std::string inflateScratch_{};
+
+    /** @brief Optional metrics sink. */
+    std::shared_ptr<WebSocketMetrics> metrics_{};
+
+    /** @brief Minimum tail space requested from the read buffer per read. */
+    static constexpr std::size_t READ_CHUNK_SIZE = 8192;
 
     std::atomic<bool> closing_{false};
     std::atomic<bool> open_{false};
     std::atomic<bool> closeNotified_{false};
 
-    /** @brief Cancellation source for idle timeout handling. */
-    cancel_source idleCancel_{};
-
     /** @brief Cancellation source for read operations. */
     cancel_source readCancel_{};
 
@@ -269,34 +657,71 @@ namespace vix::websocket
     /** @brief Cancellation source for close operations. */
     cancel_source closeCancel_{};
 
-    /** @brief Background thread used for heartbeat when enabled. */
-    std::thread heartbeatThread_{};
+    /** @brief Shared timing wheel; declared before the timers it owns. */
+    std::shared_ptr<detail::TimerWheel> timers_{};
 
-    /** @brief Stop flag for the heartbeat thread. */
-    bool heartbeatStop_{false};
+    /** @brief IO shard that accepted the session. */
+    std::size_t coreIndex_{0};
 
-    /**
-     * @brief Pending outgoing message descriptor.
-     */
-    struct PendingMessage
-    {
-      /** @brief True if the payload must be sent as binary. */
-      bool isBinary{false};
+    /** @brief Idle timeout timer. */
+    detail::TimerWheel::Timer idleTimer_{};
 
-      /** @brief Raw payload bytes stored as string. */
-      std::string data{};
-    };
+    /** @brief Heartbeat (server ping) timer. */
+    detail::TimerWheel::Timer heartbeatTimer_{};
+
+    /** @brief Deadline for draining the write queue once closing. */
+    detail::TimerWheel::Timer closeTimer_{};
+
+    /** @brief Wheel tick of the last inbound frame. */
+    std::atomic<std::uint64_t> lastActivityTick_{0};
 
-    /** @brief FIFO queue of pending outgoing messages. */
-    std::deque<PendingMessage> writeQueue_{};
+    /** @brief Bounded FIFO of pending outgoing messages. */
+    detail::BasicWriteQueue<PendingMessage> writeQueue_{};
 
     /** @brief True while a write flush is already in progress. */
     bool writeInProgress_{false};
 
-    std::size_t queuedWriteBytes_{0};
+    /** @brief Reusable buffer used to coalesce small frames into one write. */
+    std::vector<std::byte> writeScratch_{};
+
+    /** @brief Messages drained from writeQueue_ for the current flush. */
+    std::vector<PendingMessage> flushBatch_{};
+
+    /** @brief Encoded frame headers of the current flush. */
+    std::vector<detail::FrameHeaderBytes> flushHeaders_{};
+
+    /** @brief Compressed payloads of the current flush, one slot per message. */
+    std::vector<std::string> flushCompressed_{};
+
+    /** @brief Ordered header/payload segments of the current flush. */
+    std::vector<std::span<const std::byte>> flushSegments_{};
+
+    /** @brief Data message currently written one fragment per flush. */
+    PendingMessage fragmented_{};
+
+    /** @brief Compressed payload of fragmented_ when it was deflated. */
+    std::string fragmentedCompressed_{};
+
+    /** @brief Wire payload of fragmented_. */
+    std::span<const std::byte> fragmentedPayload_{};
+
+    /** @brief Bytes of fragmentedPayload_ already encoded. */
+    std::size_t fragmentedOffset_{0};
+
+    /** @brief Opcode of the first fragment. */
+    detail::Opcode fragmentedOpcode_{detail::Opcode::Text};
+
+    /** @brief True if the first fragment carries RSV1 (compressed). */
+    bool fragmentedRsv1_{false};
+
+    /** @brief True while fragments of fragmented_ remain to be written. */
+    bool fragmenting_{false};
+
+    /** @brief Bytes written by the flush loop since the session started. */
+    std::atomic<std::uint64_t> bytesFlushed_{0};
 
-    static constexpr std::size_t MAX_PENDING_WRITE_MESSAGES = 1024;
-    static constexpr std::size_t MAX_PENDING_WRITE_BYTES = 4 * 1024 * 1024;
+    /** @brief Largest payload coalesced with its header before writing. */
+    static constexpr std::size_t WRITE_COALESCE_LIMIT = 16 * 1024;
 
     /** @brief Protects write queue and write state. */
     std::mutex writeMutex_{};
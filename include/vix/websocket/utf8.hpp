@@ -0,0 +1,127 @@
+/**
+ *
+ *  @file utf8.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_UTF8_HPP
+#define VIX_WEBSOCKET_UTF8_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief UTF-8 validation kernels.
+   *
+   * Text frames must carry valid UTF-8 (RFC 6455 section 8.1), so every
+   * inbound text byte goes through the validator.
+   */
+  enum class Utf8Kernel : std::uint8_t
+  {
+    /** @brief Portable range-check loop with an 8-byte ASCII fast path. */
+    Scalar,
+    /** @brief 16-byte lookup-table kernel (x86, SSE4.1). */
+    Sse4,
+    /** @brief 32-byte lookup-table kernel (x86-64, runtime detected). */
+    Avx2,
+    /** @brief 16-byte lookup-table kernel (AArch64). */
+    Neon,
+  };
+
+  /**
+   * @brief Return a stable lower-case name for a UTF-8 kernel.
+   */
+  const char *utf8_kernel_name(Utf8Kernel kernel) noexcept;
+
+  /**
+   * @brief Return true if @p kernel can run on the current CPU.
+   */
+  bool utf8_kernel_supported(Utf8Kernel kernel) noexcept;
+
+  /**
+   * @brief Return the kernel selected by runtime dispatch.
+   */
+  Utf8Kernel active_utf8_kernel() noexcept;
+
+  /**
+   * @brief Return true if @p data is complete, well-formed UTF-8.
+   *
+   * Overlong forms, surrogates and code points above U+10FFFF are rejected.
+   */
+  bool is_valid_utf8(std::span<const std::byte> data) noexcept;
+
+  /**
+   * @brief Same as is_valid_utf8(), but forces a specific kernel.
+   *
+   * Falls back to the scalar kernel if @p kernel is not supported.
+   */
+  bool is_valid_utf8_with(Utf8Kernel kernel, std::span<const std::byte> data) noexcept;
+
+  inline bool is_valid_utf8(std::string_view text) noexcept
+  {
+    return is_valid_utf8(std::span<const std::byte>(
+        reinterpret_cast<const std::byte *>(text.data()), text.size()));
+  }
+
+  /**
+   * @brief Incremental validator for a message delivered in pieces.
+   *
+   * Code points may straddle piece boundaries: up to three trailing bytes
+   * of an unfinished sequence are carried into the next feed(). Invalid
+   * input is reported as soon as it is seen, including an impossible
+   * prefix at the end of a piece.
+   */
+  class Utf8Validator
+  {
+  public:
+    /**
+     * @brief Validate the next piece of the message.
+     *
+     * @return False once the message is known to be invalid.
+     */
+    bool feed(std::span<const std::byte> data) noexcept;
+
+    bool feed(std::string_view text) noexcept
+    {
+      return feed(std::span<const std::byte>(
+          reinterpret_cast<const std::byte *>(text.data()), text.size()));
+    }
+
+    /**
+     * @brief Finish the message.
+     *
+     * @return True if every piece was valid and no sequence is left open.
+     */
+    bool finish() noexcept
+    {
+      return !failed_ && pendingSize_ == 0;
+    }
+
+    /** @brief Start a new message. */
+    void reset() noexcept
+    {
+      pendingSize_ = 0;
+      failed_ = false;
+    }
+
+  private:
+    std::array<std::uint8_t, 4> pending_{};
+    std::uint8_t pendingSize_{0};
+    bool failed_{false};
+  };
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_UTF8_HPP
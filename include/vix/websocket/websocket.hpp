@@ -15,6 +15,8 @@
 #define VIX_WEBSOCKET_ENGINE_HPP
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -26,10 +28,22 @@
 #include <vix/config/Config.hpp>
 #include <vix/executor/RuntimeExecutor.hpp>
 #include <vix/utils/Logger.hpp>
+#include <vix/websocket/Metrics.hpp>
+#include <vix/websocket/TimerWheel.hpp>
 #include <vix/websocket/config.hpp>
 #include <vix/websocket/router.hpp>
 #include <vix/websocket/session.hpp>
 
+/**
+ * @brief 1 when vix::async can bind listeners with SO_REUSEPORT.
+ *
+ * Set by the VIX_WEBSOCKET_REUSE_PORT CMake option; without it the engine
+ * refuses websocket.acceptor_threads > 1.
+ */
+#ifndef VIX_WEBSOCKET_REUSE_PORT
+#define VIX_WEBSOCKET_REUSE_PORT 0
+#endif
+
 namespace vix::websocket
 {
   using vix::async::core::io_context;
@@ -83,6 +97,18 @@ namespace vix::websocket
      */
     void join_threads();
 
+    /**
+     * @brief Attach a metrics sink shared by all sessions.
+     *
+     * Must be called before run().
+     *
+     * @param metrics Metrics instance, or null to detach.
+     */
+    void attach_metrics(std::shared_ptr<WebSocketMetrics> metrics)
+    {
+      metrics_ = std::move(metrics);
+    }
+
     /**
      * @brief Check whether a stop has been requested.
      *
@@ -93,45 +119,106 @@ namespace vix::websocket
       return stopRequested_.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief Number of IO shards; each is driven by one IO thread.
+     */
+    std::size_t shard_count() const noexcept
+    {
+      return shards_.size();
+    }
+
+    /**
+     * @brief Check whether sessions and rooms are owned per shard.
+     */
+    bool shared_nothing() const noexcept
+    {
+      return wsConfig_.sharedNothing;
+    }
+
+    /**
+     * @brief Run @p fn on the IO thread of shard @p index.
+     *
+     * @param index Shard index, below shard_count().
+     * @param fn Work to post.
+     */
+    void post_to_shard(std::size_t index, std::function<void()> fn)
+    {
+      shards_[index].ioc->post(std::move(fn));
+    }
+
+    /**
+     * @brief Number of connections accepted by shard @p index so far.
+     *
+     * @param index Shard index, below shard_count().
+     */
+    std::uint64_t accepted_count(std::size_t index) const noexcept
+    {
+      return accepted_[index].load(std::memory_order_relaxed);
+    }
+
   private:
     /**
-     * @brief Initialize the native Vix TCP listener on the configured port.
+     * @brief One IO context with its listener, accept loop and timing wheel.
      *
-     * @param port Port to bind.
+     * With a single acceptor there is one shard driven by every IO thread.
+     * In SO_REUSEPORT mode each shard has its own listening socket and one
+     * IO thread; sessions accepted by a shard live on its context and wheel.
      */
-    task<void> init_listener(unsigned short port);
+    struct IoShard
+    {
+      /** @brief IO context for the listener and the shard's sessions. */
+      std::shared_ptr<io_context> ioc;
+
+      /** @brief Native TCP listener bound to the configured endpoint. */
+      std::unique_ptr<tcp_listener> listener;
+
+      /** @brief Timing wheel for idle timeouts and heartbeats of the shard. */
+      std::shared_ptr<detail::TimerWheel> timers;
+    };
 
     /**
-     * @brief Start the low-level server asynchronously.
+     * @brief Initialize the native Vix TCP listener of @p shard.
      *
-     * @return Task representing startup.
+     * @param shard Shard that owns the listener.
+     * @param port Port to bind.
+     * @param reusePort Bind with SO_REUSEPORT so several shards share the port.
      */
-    task<void> start_server();
+    task<void> init_listener(IoShard &shard, unsigned short port, bool reusePort);
 
     /**
-     * @brief Begin accepting incoming TCP connections.
+     * @brief Start the listener and accept loop of one shard.
+     *
+     * @param index Shard index.
+     * @return Task representing startup.
      */
-    void start_accept();
+    task<void> start_server(std::size_t index);
 
     /**
-     * @brief Native accept loop.
+     * @brief Native accept loop of one shard.
      *
+     * @param index Shard index.
      * @return Task representing the accept loop.
      */
-    task<void> accept_loop();
+    task<void> accept_loop(std::size_t index);
 
     /**
      * @brief Spawn IO worker threads.
      */
     void start_io_threads();
 
+    /**
+     * @brief Start the thread that advances the timing wheels once per tick.
+     */
+    void start_timer_thread();
+
     /**
      * @brief Handle a newly accepted TCP client stream.
      *
      * @param stream Accepted client stream.
+     * @param index Shard that accepted the stream.
      * @return Task representing the client lifecycle.
      */
-    task<void> handle_client(std::unique_ptr<tcp_stream> stream);
+    task<void> handle_client(std::unique_ptr<tcp_stream> stream, std::size_t index);
 
     /**
      * @brief Close a client stream safely.
@@ -143,7 +230,7 @@ namespace vix::websocket
     /**
      * @brief Compute the number of IO threads to run.
      *
-     * @return Number of worker threads.
+     * @return Number of worker threads: one per shard.
      */
     std::size_t compute_io_thread_count() const;
 
@@ -167,15 +254,21 @@ namespace vix::websocket
     /** @brief Shared event router used by all sessions. */
     std::shared_ptr<Router> router_;
 
-    /** @brief Shared asynchronous IO context for listener and sessions. */
-    std::shared_ptr<io_context> ioContext_;
+    /** @brief Optional metrics sink handed to new sessions. */
+    std::shared_ptr<WebSocketMetrics> metrics_{};
 
-    /** @brief Native TCP listener bound to the configured endpoint. */
-    std::unique_ptr<tcp_listener> listener_;
+    /** @brief IO shards; one unless SO_REUSEPORT acceptors are enabled. */
+    std::vector<IoShard> shards_;
 
-    /** @brief Worker threads driving the IO context. */
+    /** @brief Connections accepted per shard. */
+    std::vector<std::atomic<std::uint64_t>> accepted_;
+
+    /** @brief Worker threads driving the IO contexts. */
     std::vector<std::thread> ioThreads_;
 
+    /** @brief Ticker posting wheel advances into the IO contexts. */
+    std::thread timerThread_;
+
     /** @brief Global shutdown flag. */
     std::atomic<bool> stopRequested_{false};
 
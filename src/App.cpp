@@ -14,6 +14,7 @@
 #include <vix/websocket/App.hpp>
 #include <vix/websocket/protocol.hpp>
 
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -43,34 +44,51 @@ namespace vix::websocket
 
   App &App::ws(const std::string &endpoint, TypedHandler handler)
   {
-    routes_.push_back(Route{endpoint, std::move(handler)});
+    routes_.push_back(Route{endpoint, {}, std::move(handler)});
+    install_dispatcher();
+    return *this;
+  }
+
+  App &App::on(const std::string &type, TypedHandler handler)
+  {
+    routes_.push_back(Route{{}, type, std::move(handler)});
     install_dispatcher();
     return *this;
   }
 
   void App::install_dispatcher()
   {
+    auto table = std::make_shared<RouteTable>();
+
+    for (const auto &route : routes_)
+    {
+      if (route.type.empty())
+      {
+        table->add_any(route.handler);
+      }
+      else
+      {
+        table->add(route.type, route.handler);
+      }
+    }
+
+    std::shared_ptr<const RouteTable> snapshot = std::move(table);
     server_.on_typed_message(
-        [this](Session &session,
-               const std::string &type,
-               const vix::json::kvs &payload)
+        [snapshot](Session &session,
+                   const std::string &type,
+                   const vix::json::kvs &payload)
         {
-          dispatch_typed_message(session, type, payload);
+          dispatch_typed_message(*snapshot, session, type, payload);
         });
   }
 
   void App::dispatch_typed_message(
+      const RouteTable &table,
       Session &session,
       const std::string &type,
       const vix::json::kvs &payload)
   {
-    for (auto &route : routes_)
-    {
-      if (route.handler)
-      {
-        route.handler(session, type, payload);
-      }
-    }
+    table.dispatch(type, session, type, payload);
   }
 
   void App::run_blocking()
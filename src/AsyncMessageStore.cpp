@@ -0,0 +1,323 @@
+/**
+ *
+ *  @file AsyncMessageStore.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/AsyncMessageStore.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace vix::websocket
+{
+  namespace
+  {
+    /** @brief Store whose writer_loop() runs on this thread, if any. */
+    thread_local const AsyncMessageStore *current_writer = nullptr;
+
+    template <typename T, typename U>
+    void raise_to(std::atomic<T> &target, U value)
+    {
+      T seen = target.load(std::memory_order_relaxed);
+      while (static_cast<T>(value) > seen &&
+             !target.compare_exchange_weak(seen, static_cast<T>(value), std::memory_order_relaxed))
+      {
+      }
+    }
+  } // namespace
+
+  AsyncMessageStore::AsyncMessageStore(
+      IMessageStore &inner,
+      AsyncStoreOptions options,
+      WebSocketMetrics *metrics)
+      : inner_(inner),
+        options_(options),
+        metrics_(metrics)
+  {
+    options_.capacity = std::max<std::size_t>(1, options_.capacity);
+    writer_ = std::thread([this]()
+                          { writer_loop(); });
+  }
+
+  AsyncMessageStore::~AsyncMessageStore()
+  {
+    // The writer would return into a destroyed store, and ~thread on a
+    // joinable thread calls std::terminate().
+    assert(current_writer != this && "AsyncMessageStore destroyed from a write callback");
+    shutdown();
+  }
+
+  void AsyncMessageStore::append(const JsonMessage &msg)
+  {
+    submit(Write{msg, {}});
+  }
+
+  bool AsyncMessageStore::append(JsonMessage msg, StoreCallback callback)
+  {
+    return submit(Write{std::move(msg), std::move(callback)});
+  }
+
+  std::future<StoreReceipt> AsyncMessageStore::append_future(JsonMessage msg)
+  {
+    auto promise = std::make_shared<std::promise<StoreReceipt>>();
+    std::future<StoreReceipt> future = promise->get_future();
+
+    submit(Write{
+        std::move(msg),
+        [promise](const StoreReceipt &receipt)
+        {
+          promise->set_value(receipt);
+        }});
+
+    return future;
+  }
+
+  bool AsyncMessageStore::submit(Write write)
+  {
+    while (true)
+    {
+      // Reserve a slot first; a shutdown seen after that releases it.
+      const std::size_t position = depth_.fetch_add(1);
+
+      if (stopping_.load())
+      {
+        release_slot();
+        reject(write.callback);
+        return false;
+      }
+
+      if (position < options_.capacity)
+      {
+        raise_to(highWater_, position + 1);
+
+        if (metrics_)
+        {
+          metrics_->store_queue_depth.store(position + 1, std::memory_order_relaxed);
+          raise_to(metrics_->store_queue_high_water, position + 1);
+        }
+
+        write.queuePosition = position;
+        submitted_.fetch_add(1);
+        queue_.push(std::move(write));
+
+        // Pairs with the fence in writer_loop(): either the writer sees
+        // the push or this thread sees it going idle.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_writer();
+        return true;
+      }
+
+      release_slot();
+
+      // Only the writer makes room, so it must not wait for itself.
+      if (!options_.blockWhenFull || current_writer == this)
+      {
+        reject(write.callback);
+        return false;
+      }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      waiters_.fetch_add(1);
+      waitersCv_.wait(lock, [this]()
+                      { return depth_.load() < options_.capacity || stopping_.load(); });
+      waiters_.fetch_sub(1);
+    }
+  }
+
+  void AsyncMessageStore::release_slot()
+  {
+    // The writer or a blocked producer may have seen the reservation.
+    depth_.fetch_sub(1);
+    wake_writer();
+    notify_waiters();
+  }
+
+  void AsyncMessageStore::reject(StoreCallback &callback)
+  {
+    if (metrics_)
+    {
+      metrics_->store_writes_rejected_total.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (callback)
+    {
+      StoreReceipt receipt;
+      receipt.status = StoreWriteStatus::Rejected;
+      receipt.queuePosition = depth_.load(std::memory_order_relaxed);
+      callback(receipt);
+    }
+  }
+
+  void AsyncMessageStore::complete(Write &write)
+  {
+    StoreReceipt receipt;
+    receipt.queuePosition = write.queuePosition;
+
+    try
+    {
+      inner_.append(write.msg);
+      receipt.status = StoreWriteStatus::Stored;
+    }
+    catch (const std::exception &e)
+    {
+      receipt.status = StoreWriteStatus::Failed;
+      receipt.error = e.what();
+    }
+    catch (...)
+    {
+      receipt.status = StoreWriteStatus::Failed;
+      receipt.error = "unknown error";
+    }
+
+    if (metrics_)
+    {
+      metrics_->store_writes_total.fetch_add(1, std::memory_order_relaxed);
+      if (!receipt.ok())
+      {
+        metrics_->store_write_failures_total.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    if (write.callback)
+    {
+      try
+      {
+        write.callback(receipt);
+      }
+      catch (...)
+      {
+      }
+    }
+    write = Write{};
+
+    const std::size_t left = depth_.fetch_sub(1) - 1;
+    completed_.fetch_add(1);
+
+    if (metrics_)
+    {
+      metrics_->store_queue_depth.store(left, std::memory_order_relaxed);
+    }
+
+    notify_waiters();
+  }
+
+  void AsyncMessageStore::writer_loop()
+  {
+    current_writer = this;
+    Write write;
+
+    while (true)
+    {
+      while (queue_.pop(write))
+      {
+        complete(write);
+      }
+
+      // Slots are reserved before the push, so zero means nothing is in
+      // flight and a later submit() will see stopping_.
+      if (stopping_.load() && depth_.load() == 0)
+      {
+        return;
+      }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      writerIdle_.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (!queue_.empty() || (stopping_.load() && depth_.load() == 0))
+      {
+        writerIdle_.store(false);
+        continue;
+      }
+
+      writerCv_.wait(lock, [this]()
+                     { return !writerIdle_.load(); });
+    }
+  }
+
+  void AsyncMessageStore::wake_writer()
+  {
+    if (writerIdle_.exchange(false))
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      writerCv_.notify_one();
+    }
+  }
+
+  void AsyncMessageStore::notify_waiters()
+  {
+    if (waiters_.load() != 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      waitersCv_.notify_all();
+    }
+  }
+
+  void AsyncMessageStore::flush()
+  {
+    const std::uint64_t target = submitted_.load();
+    if (completed_.load() >= target || current_writer == this)
+    {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters_.fetch_add(1);
+    waitersCv_.wait(lock, [this, target]()
+                    { return completed_.load() >= target; });
+    waiters_.fetch_sub(1);
+  }
+
+  void AsyncMessageStore::shutdown()
+  {
+    stopping_.store(true);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      writerIdle_.store(false);
+      writerCv_.notify_one();
+      waitersCv_.notify_all();
+    }
+
+    // From a callback the writer exits on its own once drained.
+    if (current_writer == this)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(shutdownMutex_);
+    if (writer_.joinable())
+    {
+      writer_.join();
+    }
+  }
+
+  std::vector<JsonMessage> AsyncMessageStore::list_by_room(
+      const std::string &room,
+      std::size_t limit,
+      const std::optional<std::string> &before_id)
+  {
+    flush();
+    return inner_.list_by_room(room, limit, before_id);
+  }
+
+  std::vector<JsonMessage> AsyncMessageStore::replay_from(
+      const std::string &start_id,
+      std::size_t limit)
+  {
+    flush();
+    return inner_.replay_from(start_id, limit);
+  }
+
+} // namespace vix::websocket
@@ -0,0 +1,872 @@
+/**
+ *
+ *  @file LogMessageStore.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/LogMessageStore.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <zlib.h>
+
+namespace vix::websocket
+{
+  /*
+   * Record layout, little-endian:
+   *
+   *   u32 bodyLength
+   *   u32 crc32(body)
+   *   body:
+   *     u64 previous record of the same room (all ones if none)
+   *     u16 id, kind, room, type, ts lengths
+   *     u32 payload length
+   *     id, kind, room, type, ts bytes
+   *     payload: binary kvs, see put_kvs()
+   */
+
+  namespace
+  {
+    constexpr std::size_t RECORD_HEADER = 8;
+    constexpr std::size_t BODY_FIXED = 8 + 5 * 2 + 4;
+    constexpr int MAX_PAYLOAD_DEPTH = 64;
+
+    enum class Tag : std::uint8_t
+    {
+      Null,
+      False,
+      True,
+      Int,
+      Double,
+      String,
+      Array,
+      Object,
+    };
+
+    void put_u8(std::vector<std::byte> &out, std::uint8_t v)
+    {
+      out.push_back(static_cast<std::byte>(v));
+    }
+
+    template <typename T>
+    void put_le(std::vector<std::byte> &out, T v)
+    {
+      for (std::size_t i = 0; i < sizeof(T); ++i)
+      {
+        out.push_back(static_cast<std::byte>((static_cast<std::uint64_t>(v) >> (8 * i)) & 0xFFu));
+      }
+    }
+
+    template <typename T>
+    void patch_le(std::byte *at, T v)
+    {
+      for (std::size_t i = 0; i < sizeof(T); ++i)
+      {
+        at[i] = static_cast<std::byte>((static_cast<std::uint64_t>(v) >> (8 * i)) & 0xFFu);
+      }
+    }
+
+    template <typename T>
+    T get_le(const std::byte *at)
+    {
+      std::uint64_t v = 0;
+      for (std::size_t i = 0; i < sizeof(T); ++i)
+      {
+        v |= static_cast<std::uint64_t>(at[i]) << (8 * i);
+      }
+      return static_cast<T>(v);
+    }
+
+    void put_bytes(std::vector<std::byte> &out, std::string_view s)
+    {
+      const auto *p = reinterpret_cast<const std::byte *>(s.data());
+      out.insert(out.end(), p, p + s.size());
+    }
+
+    void put_kvs(std::vector<std::byte> &out, const vix::json::kvs &list);
+
+    void put_token(std::vector<std::byte> &out, const vix::json::token &t)
+    {
+      std::visit(
+          [&](auto &&val)
+          {
+            using T = std::decay_t<decltype(val)>;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+              put_u8(out, static_cast<std::uint8_t>(val ? Tag::True : Tag::False));
+            }
+            else if constexpr (std::is_same_v<T, long long>)
+            {
+              put_u8(out, static_cast<std::uint8_t>(Tag::Int));
+              put_le<std::uint64_t>(out, static_cast<std::uint64_t>(val));
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+              std::uint64_t bits = 0;
+              std::memcpy(&bits, &val, sizeof(bits));
+              put_u8(out, static_cast<std::uint8_t>(Tag::Double));
+              put_le<std::uint64_t>(out, bits);
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+              put_u8(out, static_cast<std::uint8_t>(Tag::String));
+              put_le<std::uint32_t>(out, static_cast<std::uint32_t>(val.size()));
+              put_bytes(out, val);
+            }
+            else if constexpr (std::is_same_v<T, std::shared_ptr<vix::json::array_t>>)
+            {
+              if (!val)
+              {
+                put_u8(out, static_cast<std::uint8_t>(Tag::Null));
+                return;
+              }
+
+              put_u8(out, static_cast<std::uint8_t>(Tag::Array));
+              put_le<std::uint32_t>(out, static_cast<std::uint32_t>(val->elems.size()));
+              for (const auto &el : val->elems)
+              {
+                put_token(out, el);
+              }
+            }
+            else if constexpr (std::is_same_v<T, std::shared_ptr<vix::json::kvs>>)
+            {
+              if (!val)
+              {
+                put_u8(out, static_cast<std::uint8_t>(Tag::Null));
+                return;
+              }
+
+              put_u8(out, static_cast<std::uint8_t>(Tag::Object));
+              put_kvs(out, *val);
+            }
+            else
+            {
+              put_u8(out, static_cast<std::uint8_t>(Tag::Null));
+            }
+          },
+          t.v);
+    }
+
+    /** Flat key/value list: u32 count, then count tokens. */
+    void put_kvs(std::vector<std::byte> &out, const vix::json::kvs &list)
+    {
+      put_le<std::uint32_t>(out, static_cast<std::uint32_t>(list.flat.size()));
+      for (const auto &t : list.flat)
+      {
+        put_token(out, t);
+      }
+    }
+
+    struct Reader
+    {
+      const std::byte *p;
+      const std::byte *end;
+
+      bool has(std::size_t n) const noexcept
+      {
+        return static_cast<std::size_t>(end - p) >= n;
+      }
+    };
+
+    bool get_kvs(Reader &r, vix::json::kvs &out, int depth);
+
+    bool get_token(Reader &r, vix::json::token &out, int depth)
+    {
+      if (depth > MAX_PAYLOAD_DEPTH || !r.has(1))
+      {
+        return false;
+      }
+
+      const auto tag = static_cast<Tag>(*r.p++);
+      switch (tag)
+      {
+      case Tag::Null:
+        out = vix::json::token{};
+        return true;
+
+      case Tag::False:
+      case Tag::True:
+        out = vix::json::token{tag == Tag::True};
+        return true;
+
+      case Tag::Int:
+        if (!r.has(8))
+          return false;
+        out = vix::json::token{static_cast<long long>(get_le<std::uint64_t>(r.p))};
+        r.p += 8;
+        return true;
+
+      case Tag::Double:
+      {
+        if (!r.has(8))
+          return false;
+        const std::uint64_t bits = get_le<std::uint64_t>(r.p);
+        double value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        out = vix::json::token{value};
+        r.p += 8;
+        return true;
+      }
+
+      case Tag::String:
+      {
+        if (!r.has(4))
+          return false;
+        const std::uint32_t n = get_le<std::uint32_t>(r.p);
+        r.p += 4;
+        if (!r.has(n))
+          return false;
+        out = vix::json::token{std::string(reinterpret_cast<const char *>(r.p), n)};
+        r.p += n;
+        return true;
+      }
+
+      case Tag::Array:
+      {
+        if (!r.has(4))
+          return false;
+        const std::uint32_t n = get_le<std::uint32_t>(r.p);
+        r.p += 4;
+
+        auto array = std::make_shared<vix::json::array_t>();
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+          vix::json::token el;
+          if (!get_token(r, el, depth + 1))
+            return false;
+          array->elems.push_back(std::move(el));
+        }
+        out = vix::json::token{};
+        out.v = std::move(array);
+        return true;
+      }
+
+      case Tag::Object:
+      {
+        auto object = std::make_shared<vix::json::kvs>();
+        if (!get_kvs(r, *object, depth + 1))
+          return false;
+        out = vix::json::token{};
+        out.v = std::move(object);
+        return true;
+      }
+      }
+
+      return false;
+    }
+
+    bool get_kvs(Reader &r, vix::json::kvs &out, int depth)
+    {
+      if (!r.has(4))
+        return false;
+      const std::uint32_t n = get_le<std::uint32_t>(r.p);
+      r.p += 4;
+
+      out.flat.reserve(std::min<std::size_t>(n, static_cast<std::size_t>(r.end - r.p)));
+      for (std::uint32_t i = 0; i < n; ++i)
+      {
+        vix::json::token t;
+        if (!get_token(r, t, depth))
+          return false;
+        out.flat.push_back(std::move(t));
+      }
+      return true;
+    }
+
+    std::uint32_t crc_of(const std::byte *data, std::size_t size)
+    {
+      return static_cast<std::uint32_t>(
+          crc32(0L, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(size)));
+    }
+
+    std::string utc_timestamp()
+    {
+      using clock = std::chrono::system_clock;
+      auto tt = clock::to_time_t(clock::now());
+      std::tm tm{};
+#if defined(_WIN32)
+      gmtime_s(&tm, &tt);
+#else
+      gmtime_r(&tt, &tm);
+#endif
+      char buf[64];
+      std::snprintf(
+          buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02dZ",
+          tm.tm_year + 1900,
+          tm.tm_mon + 1,
+          tm.tm_mday,
+          tm.tm_hour,
+          tm.tm_min,
+          tm.tm_sec);
+      return buf;
+    }
+
+    [[noreturn]] void throw_errno(const std::string &what)
+    {
+      throw std::system_error(errno, std::generic_category(), "[LogMessageStore] " + what);
+    }
+
+    std::string segment_name(std::uint32_t number)
+    {
+      char buf[32];
+      std::snprintf(buf, sizeof(buf), "%010u.log", number);
+      return buf;
+    }
+  } // namespace
+
+  struct LogMessageStore::RecordView
+  {
+    Location previousInRoom{NO_LOCATION};
+    std::string_view id;
+    std::string_view kind;
+    std::string_view room;
+    std::string_view type;
+    std::string_view ts;
+    std::span<const std::byte> payload;
+
+    /** @brief Record size including its header. */
+    std::size_t bytes{0};
+  };
+
+#if !defined(_WIN32)
+
+  struct LogMessageStore::Segment
+  {
+    std::string path;
+    int fd{-1};
+    const std::byte *map{nullptr};
+
+    /** @brief File and mapping size. */
+    std::size_t capacity{0};
+
+    /** @brief Bytes of valid records. */
+    std::size_t size{0};
+
+    ~Segment()
+    {
+      if (map)
+      {
+        ::munmap(const_cast<std::byte *>(map), capacity);
+      }
+      if (fd >= 0)
+      {
+        ::close(fd);
+      }
+    }
+  };
+
+  LogMessageStore::LogMessageStore(const std::string &directory, LogStoreOptions options)
+      : directory_(directory),
+        options_(options)
+  {
+    // Offsets are 32-bit within a segment.
+    options_.segmentBytes = std::clamp<std::size_t>(options_.segmentBytes, 4096, 0xFFFFFFFFu);
+    options_.indexInterval = std::max<std::size_t>(1, options_.indexInterval);
+
+    std::filesystem::create_directories(directory_);
+    open_segments();
+  }
+
+  LogMessageStore::~LogMessageStore()
+  {
+    try
+    {
+      flush();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void LogMessageStore::open_segments()
+  {
+    std::vector<std::uint32_t> numbers;
+    for (const auto &entry : std::filesystem::directory_iterator(directory_))
+    {
+      const std::string name = entry.path().filename().string();
+      if (name.size() != 14 || name.compare(10, 4, ".log") != 0)
+      {
+        continue;
+      }
+
+      numbers.push_back(static_cast<std::uint32_t>(std::stoul(name.substr(0, 10))));
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+    {
+      if (numbers[i] != i)
+      {
+        throw std::runtime_error(
+            "[LogMessageStore] missing segment " + segment_name(static_cast<std::uint32_t>(i)) +
+            " in " + directory_);
+      }
+
+      Segment &segment = open_segment(numbers[i], false, 0);
+
+      // Until the scan ends, records are bounded by the file only.
+      segment.size = segment.capacity;
+      Location location = static_cast<Location>(i) << 32;
+      std::size_t end = 0;
+
+      while (const auto record = read(location, true))
+      {
+        index(location, record->id, record->room);
+        ids_.observe(detail::MonotonicIdGenerator::parse(record->id).value_or(0));
+        end += record->bytes;
+        location += record->bytes;
+      }
+
+      // A zero length or a torn record ends the segment.
+      segment.size = end;
+    }
+  }
+
+  LogMessageStore::Segment &LogMessageStore::open_segment(
+      std::uint32_t number,
+      bool create,
+      std::size_t bytes)
+  {
+    auto segment = std::make_unique<Segment>();
+    segment->path = (std::filesystem::path(directory_) / segment_name(number)).string();
+
+    segment->fd = ::open(
+        segment->path.c_str(),
+        O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0),
+        0644);
+    if (segment->fd < 0)
+    {
+      throw_errno("open " + segment->path);
+    }
+
+    if (create)
+    {
+      if (::ftruncate(segment->fd, static_cast<off_t>(bytes)) != 0)
+      {
+        throw_errno("size " + segment->path);
+      }
+      segment->capacity = bytes;
+    }
+    else
+    {
+      struct stat st{};
+      if (::fstat(segment->fd, &st) != 0)
+      {
+        throw_errno("stat " + segment->path);
+      }
+      segment->capacity = std::min<std::size_t>(static_cast<std::size_t>(st.st_size), 0xFFFFFFFFu);
+    }
+
+    if (segment->capacity != 0)
+    {
+      void *map = ::mmap(nullptr, segment->capacity, PROT_READ, MAP_SHARED, segment->fd, 0);
+      if (map == MAP_FAILED)
+      {
+        throw_errno("map " + segment->path);
+      }
+      segment->map = static_cast<const std::byte *>(map);
+    }
+
+    segments_.push_back(std::move(segment));
+    return *segments_.back();
+  }
+
+  LogMessageStore::Segment &LogMessageStore::writable_segment(std::size_t recordBytes)
+  {
+    if (!segments_.empty())
+    {
+      Segment &active = *segments_.back();
+      if (active.capacity - active.size >= recordBytes)
+      {
+        return active;
+      }
+
+      // Seal the full segment before the log moves on.
+      if (::fdatasync(active.fd) != 0)
+      {
+        throw_errno("sync " + active.path);
+      }
+    }
+
+    if (recordBytes > 0xFFFFFFFFu)
+    {
+      throw std::length_error("[LogMessageStore] record larger than 4 GiB");
+    }
+
+    return open_segment(
+        static_cast<std::uint32_t>(segments_.size()),
+        true,
+        std::max(options_.segmentBytes, recordBytes));
+  }
+
+  void LogMessageStore::append(const JsonMessage &msg)
+  {
+    std::string id = msg.id;
+    const std::string_view kind = msg.kind.empty() ? std::string_view("event") : std::string_view(msg.kind);
+    const std::string ts = msg.ts.empty() ? utc_timestamp() : msg.ts;
+
+    for (std::size_t length : {id.size(), kind.size(), msg.room.size(), msg.type.size(), ts.size()})
+    {
+      if (length > 0xFFFFu)
+      {
+        throw std::length_error("[LogMessageStore] id, kind, room, type or ts longer than 65535 bytes");
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    // Generated under the lock, so ids sort in log order as the sparse
+    // indexes require.
+    if (id.empty())
+    {
+      id = ids_.next();
+    }
+
+    Location previous = NO_LOCATION;
+    if (!msg.room.empty())
+    {
+      if (const auto it = rooms_.find(msg.room); it != rooms_.end())
+      {
+        previous = it->second.last;
+      }
+    }
+
+    std::vector<std::byte> &out = scratch_;
+    out.clear();
+    out.resize(RECORD_HEADER);
+    put_le<std::uint64_t>(out, previous);
+    put_le<std::uint16_t>(out, static_cast<std::uint16_t>(id.size()));
+    put_le<std::uint16_t>(out, static_cast<std::uint16_t>(kind.size()));
+    put_le<std::uint16_t>(out, static_cast<std::uint16_t>(msg.room.size()));
+    put_le<std::uint16_t>(out, static_cast<std::uint16_t>(msg.type.size()));
+    put_le<std::uint16_t>(out, static_cast<std::uint16_t>(ts.size()));
+    const std::size_t payloadLengthAt = out.size();
+    put_le<std::uint32_t>(out, 0);
+    put_bytes(out, id);
+    put_bytes(out, kind);
+    put_bytes(out, msg.room);
+    put_bytes(out, msg.type);
+    put_bytes(out, ts);
+
+    const std::size_t payloadAt = out.size();
+    put_kvs(out, msg.payload);
+    patch_le<std::uint32_t>(out.data() + payloadLengthAt, static_cast<std::uint32_t>(out.size() - payloadAt));
+
+    const std::size_t body = out.size() - RECORD_HEADER;
+    patch_le<std::uint32_t>(out.data(), static_cast<std::uint32_t>(body));
+    patch_le<std::uint32_t>(out.data() + 4, crc_of(out.data() + RECORD_HEADER, body));
+
+    Segment &segment = writable_segment(out.size());
+
+    std::size_t written = 0;
+    while (written < out.size())
+    {
+      const ssize_t n = ::pwrite(
+          segment.fd,
+          out.data() + written,
+          out.size() - written,
+          static_cast<off_t>(segment.size + written));
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        throw_errno("write " + segment.path);
+      }
+      written += static_cast<std::size_t>(n);
+    }
+
+    if (options_.syncEveryAppend && ::fdatasync(segment.fd) != 0)
+    {
+      throw_errno("sync " + segment.path);
+    }
+
+    const Location location = (static_cast<Location>(segments_.size() - 1) << 32) | segment.size;
+    segment.size += out.size();
+    index(location, id, msg.room);
+  }
+
+  void LogMessageStore::flush()
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!segments_.empty() && ::fdatasync(segments_.back()->fd) != 0)
+    {
+      throw_errno("sync " + segments_.back()->path);
+    }
+  }
+
+  std::optional<LogMessageStore::RecordView> LogMessageStore::read(Location location, bool verify) const
+  {
+    const std::size_t number = static_cast<std::size_t>(location >> 32);
+    const std::size_t offset = static_cast<std::size_t>(location & 0xFFFFFFFFu);
+    if (number >= segments_.size())
+    {
+      return std::nullopt;
+    }
+
+    const Segment &segment = *segments_[number];
+    if (segment.size < RECORD_HEADER || offset > segment.size - RECORD_HEADER)
+    {
+      return std::nullopt;
+    }
+
+    const std::byte *at = segment.map + offset;
+    const std::size_t body = get_le<std::uint32_t>(at);
+    if (body < BODY_FIXED || body > segment.size - offset - RECORD_HEADER)
+    {
+      return std::nullopt;
+    }
+
+    const std::byte *p = at + RECORD_HEADER;
+    if (verify && get_le<std::uint32_t>(at + 4) != crc_of(p, body))
+    {
+      return std::nullopt;
+    }
+
+    RecordView record;
+    record.bytes = RECORD_HEADER + body;
+    record.previousInRoom = get_le<std::uint64_t>(p);
+
+    std::size_t lengths[5];
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      lengths[i] = get_le<std::uint16_t>(p + 8 + 2 * i);
+    }
+    const std::size_t payloadLength = get_le<std::uint32_t>(p + 18);
+
+    std::size_t total = BODY_FIXED + payloadLength;
+    for (std::size_t length : lengths)
+    {
+      total += length;
+    }
+    if (total != body)
+    {
+      return std::nullopt;
+    }
+
+    const char *s = reinterpret_cast<const char *>(p + BODY_FIXED);
+    std::string_view *fields[5] = {&record.id, &record.kind, &record.room, &record.type, &record.ts};
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      *fields[i] = std::string_view(s, lengths[i]);
+      s += lengths[i];
+    }
+    record.payload = std::span<const std::byte>(reinterpret_cast<const std::byte *>(s), payloadLength);
+
+    return record;
+  }
+
+  LogMessageStore::Location LogMessageStore::next(Location location, const RecordView &record) const
+  {
+    const std::size_t number = static_cast<std::size_t>(location >> 32);
+    const Location following = location + record.bytes;
+
+    if ((following & 0xFFFFFFFFu) >= segments_[number]->size && number + 1 < segments_.size())
+    {
+      return static_cast<Location>(number + 1) << 32;
+    }
+    return following;
+  }
+
+  void LogMessageStore::index(Location location, std::string_view id, std::string_view room)
+  {
+    if (records_ % options_.indexInterval == 0)
+    {
+      sparse_.push_back(IndexEntry{std::string(id), location});
+    }
+    ++records_;
+
+    if (room.empty())
+    {
+      return;
+    }
+
+    RoomIndex &r = rooms_[std::string(room)];
+    if (r.count % options_.indexInterval == 0)
+    {
+      r.sparse.push_back(IndexEntry{std::string(id), location});
+    }
+    ++r.count;
+    r.last = location;
+  }
+
+  JsonMessage LogMessageStore::to_message(const RecordView &record)
+  {
+    JsonMessage m;
+    m.id = std::string(record.id);
+    m.kind = std::string(record.kind);
+    m.room = std::string(record.room);
+    m.type = std::string(record.type);
+    m.ts = std::string(record.ts);
+
+    Reader reader{record.payload.data(), record.payload.data() + record.payload.size()};
+    if (!get_kvs(reader, m.payload, 0))
+    {
+      m.payload = vix::json::kvs{};
+    }
+    return m;
+  }
+
+  std::vector<JsonMessage> LogMessageStore::list_by_room(
+      const std::string &room,
+      std::size_t limit,
+      const std::optional<std::string> &before_id)
+  {
+    std::vector<JsonMessage> out;
+    if (limit == 0)
+      return out;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    const auto it = rooms_.find(room);
+    if (it == rooms_.end())
+    {
+      return out;
+    }
+
+    Location location = it->second.last;
+
+    if (before_id.has_value())
+    {
+      // Start at the oldest indexed record not below the cursor; at most
+      // indexInterval records are skipped walking back from it.
+      const auto &sparse = it->second.sparse;
+      const auto entry = std::lower_bound(
+          sparse.begin(), sparse.end(), *before_id,
+          [](const IndexEntry &e, const std::string &id)
+          { return e.id < id; });
+      if (entry != sparse.end())
+      {
+        location = entry->location;
+      }
+    }
+
+    out.reserve(std::min<std::size_t>(limit, it->second.count));
+    while (location != NO_LOCATION && out.size() < limit)
+    {
+      const auto record = read(location);
+      if (!record)
+      {
+        break;
+      }
+
+      if (!before_id.has_value() || record->id < *before_id)
+      {
+        out.push_back(to_message(*record));
+      }
+      location = record->previousInRoom;
+    }
+
+    return out;
+  }
+
+  std::vector<JsonMessage> LogMessageStore::replay_from(
+      const std::string &start_id,
+      std::size_t limit)
+  {
+    std::vector<JsonMessage> out;
+    if (limit == 0)
+      return out;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // Start at the newest indexed record not above the cursor.
+    Location location = 0;
+    const auto entry = std::upper_bound(
+        sparse_.begin(), sparse_.end(), start_id,
+        [](const std::string &id, const IndexEntry &e)
+        { return id < e.id; });
+    if (entry != sparse_.begin())
+    {
+      location = std::prev(entry)->location;
+    }
+
+    while (out.size() < limit)
+    {
+      const auto record = read(location);
+      if (!record)
+      {
+        break;
+      }
+
+      if (record->id > start_id)
+      {
+        out.push_back(to_message(*record));
+      }
+      location = next(location, *record);
+    }
+
+    return out;
+  }
+
+  std::uint64_t LogMessageStore::size() const
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return records_;
+  }
+
+#else
+
+  struct LogMessageStore::Segment
+  {
+  };
+
+  LogMessageStore::LogMessageStore(const std::string &directory, LogStoreOptions options)
+      : directory_(directory),
+        options_(options)
+  {
+    throw std::runtime_error("[LogMessageStore] not supported on Windows");
+  }
+
+  LogMessageStore::~LogMessageStore() = default;
+
+  void LogMessageStore::append(const JsonMessage &) {}
+  void LogMessageStore::flush() {}
+
+  std::vector<JsonMessage> LogMessageStore::list_by_room(
+      const std::string &,
+      std::size_t,
+      const std::optional<std::string> &)
+  {
+    return {};
+  }
+
+  std::vector<JsonMessage> LogMessageStore::replay_from(const std::string &, std::size_t)
+  {
+    return {};
+  }
+
+  std::uint64_t LogMessageStore::size() const
+  {
+    return 0;
+  }
+
+#endif
+
+} // namespace vix::websocket
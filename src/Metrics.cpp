@@ -293,6 +293,31 @@ namespace vix::websocket
 
   } // namespace
 
+  double WebSocketMetrics::deflate_compression_ratio() const noexcept
+  {
+    const auto in = deflate_bytes_in_total.load(std::memory_order_relaxed);
+    const auto out = deflate_bytes_out_total.load(std::memory_order_relaxed);
+
+    if (out == 0)
+    {
+      return 1.0;
+    }
+
+    return static_cast<double>(in) / static_cast<double>(out);
+  }
+
+  double WebSocketMetrics::average_write_batch_size() const noexcept
+  {
+    const auto batches = write_batches_total.load(std::memory_order_relaxed);
+    if (batches == 0)
+    {
+      return 0.0;
+    }
+
+    return static_cast<double>(write_batch_messages_total.load(std::memory_order_relaxed)) /
+           static_cast<double>(batches);
+  }
+
   std::string WebSocketMetrics::render_prometheus() const
   {
     std::ostringstream os;
@@ -317,6 +342,86 @@ namespace vix::websocket
        << "# TYPE vix_ws_errors_total counter\n"
        << "vix_ws_errors_total " << errors_total.load() << "\n\n";
 
+    os << "# HELP vix_ws_write_batches_total Session write-queue flushes (one gathered write each)\n"
+       << "# TYPE vix_ws_write_batches_total counter\n"
+       << "vix_ws_write_batches_total " << write_batches_total.load() << "\n\n"
+
+       << "# HELP vix_ws_write_batch_messages_total Messages written across all flush batches\n"
+       << "# TYPE vix_ws_write_batch_messages_total counter\n"
+       << "vix_ws_write_batch_messages_total " << write_batch_messages_total.load() << "\n\n"
+
+       << "# HELP vix_ws_write_batch_size_avg Average messages per flush batch\n"
+       << "# TYPE vix_ws_write_batch_size_avg gauge\n"
+       << "vix_ws_write_batch_size_avg " << average_write_batch_size() << "\n\n";
+
+    os << "# HELP vix_ws_backpressure_dropped_total Queued messages discarded by a drop policy\n"
+       << "# TYPE vix_ws_backpressure_dropped_total counter\n"
+       << "vix_ws_backpressure_dropped_total " << backpressure_dropped_total.load() << "\n\n"
+
+       << "# HELP vix_ws_backpressure_conflated_total Queued messages superseded by a newer one with the same key\n"
+       << "# TYPE vix_ws_backpressure_conflated_total counter\n"
+       << "vix_ws_backpressure_conflated_total " << backpressure_conflated_total.load() << "\n\n"
+
+       << "# HELP vix_ws_backpressure_closes_total Sessions closed on write queue overflow\n"
+       << "# TYPE vix_ws_backpressure_closes_total counter\n"
+       << "vix_ws_backpressure_closes_total " << backpressure_closes_total.load() << "\n\n"
+
+       << "# HELP vix_ws_write_queue_high_water_messages Deepest session write queue seen (messages)\n"
+       << "# TYPE vix_ws_write_queue_high_water_messages gauge\n"
+       << "vix_ws_write_queue_high_water_messages " << write_queue_high_water_messages.load() << "\n\n"
+
+       << "# HELP vix_ws_write_queue_high_water_bytes Deepest session write queue seen (payload bytes)\n"
+       << "# TYPE vix_ws_write_queue_high_water_bytes gauge\n"
+       << "vix_ws_write_queue_high_water_bytes " << write_queue_high_water_bytes.load() << "\n\n";
+
+    os << "# HELP vix_ws_deflate_messages_total Outbound messages compressed with permessage-deflate\n"
+       << "# TYPE vix_ws_deflate_messages_total counter\n"
+       << "vix_ws_deflate_messages_total " << deflate_messages_total.load() << "\n\n"
+
+       << "# HELP vix_ws_deflate_bytes_in_total Uncompressed bytes fed to the compressor\n"
+       << "# TYPE vix_ws_deflate_bytes_in_total counter\n"
+       << "vix_ws_deflate_bytes_in_total " << deflate_bytes_in_total.load() << "\n\n"
+
+       << "# HELP vix_ws_deflate_bytes_out_total Compressed bytes produced by the compressor\n"
+       << "# TYPE vix_ws_deflate_bytes_out_total counter\n"
+       << "vix_ws_deflate_bytes_out_total " << deflate_bytes_out_total.load() << "\n\n"
+
+       << "# HELP vix_ws_deflate_compression_ratio Outbound uncompressed/compressed byte ratio\n"
+       << "# TYPE vix_ws_deflate_compression_ratio gauge\n"
+       << "vix_ws_deflate_compression_ratio " << deflate_compression_ratio() << "\n\n"
+
+       << "# HELP vix_ws_inflate_messages_total Inbound compressed messages inflated\n"
+       << "# TYPE vix_ws_inflate_messages_total counter\n"
+       << "vix_ws_inflate_messages_total " << inflate_messages_total.load() << "\n\n"
+
+       << "# HELP vix_ws_inflate_bytes_in_total Compressed bytes received\n"
+       << "# TYPE vix_ws_inflate_bytes_in_total counter\n"
+       << "vix_ws_inflate_bytes_in_total " << inflate_bytes_in_total.load() << "\n\n"
+
+       << "# HELP vix_ws_inflate_bytes_out_total Bytes produced by inflating received messages\n"
+       << "# TYPE vix_ws_inflate_bytes_out_total counter\n"
+       << "vix_ws_inflate_bytes_out_total " << inflate_bytes_out_total.load() << "\n\n";
+
+    os << "# HELP vix_ws_store_queue_depth Writes queued for the async message store writer\n"
+       << "# TYPE vix_ws_store_queue_depth gauge\n"
+       << "vix_ws_store_queue_depth " << store_queue_depth.load() << "\n\n"
+
+       << "# HELP vix_ws_store_queue_high_water Deepest async message store queue seen\n"
+       << "# TYPE vix_ws_store_queue_high_water gauge\n"
+       << "vix_ws_store_queue_high_water " << store_queue_high_water.load() << "\n\n"
+
+       << "# HELP vix_ws_store_writes_total Writes handed to the wrapped message store\n"
+       << "# TYPE vix_ws_store_writes_total counter\n"
+       << "vix_ws_store_writes_total " << store_writes_total.load() << "\n\n"
+
+       << "# HELP vix_ws_store_write_failures_total Message store writes that failed\n"
+       << "# TYPE vix_ws_store_write_failures_total counter\n"
+       << "vix_ws_store_write_failures_total " << store_write_failures_total.load() << "\n\n"
+
+       << "# HELP vix_ws_store_writes_rejected_total Message store writes rejected by a full or closed queue\n"
+       << "# TYPE vix_ws_store_writes_rejected_total counter\n"
+       << "vix_ws_store_writes_rejected_total " << store_writes_rejected_total.load() << "\n\n";
+
     os << "# HELP vix_ws_lp_sessions_total Total long-polling sessions ever created\n"
        << "# TYPE vix_ws_lp_sessions_total counter\n"
        << "vix_ws_lp_sessions_total " << lp_sessions_total.load() << "\n\n"
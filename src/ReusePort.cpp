@@ -0,0 +1,145 @@
+/**
+ *
+ *  @file ReusePort.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/ReusePort.hpp>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace vix::websocket::detail
+{
+  ReusePortSocket::~ReusePortSocket()
+  {
+    close();
+  }
+
+  ReusePortSocket::ReusePortSocket(ReusePortSocket &&other) noexcept
+      : fd_(std::exchange(other.fd_, -1))
+  {
+  }
+
+  ReusePortSocket &ReusePortSocket::operator=(ReusePortSocket &&other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+
+#if !defined(_WIN32)
+
+  ReusePortSocket ReusePortSocket::bind(const std::string &host, std::uint16_t port, int backlog)
+  {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host.empty() ? "0.0.0.0" : host.c_str(), &addr.sin_addr) != 1)
+    {
+      throw std::system_error(EINVAL, std::generic_category(), "[ws] invalid listen address " + host);
+    }
+
+    ReusePortSocket socket(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (socket.fd_ < 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "[ws] socket");
+    }
+
+    const int on = 1;
+    if (::setsockopt(socket.fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+        ::setsockopt(socket.fd_, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "[ws] SO_REUSEPORT");
+    }
+
+    if (::bind(socket.fd_, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "[ws] bind");
+    }
+
+    if (backlog >= 0 && ::listen(socket.fd_, backlog) != 0)
+    {
+      throw std::system_error(errno, std::generic_category(), "[ws] listen");
+    }
+
+    return socket;
+  }
+
+  std::uint16_t ReusePortSocket::port() const
+  {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (fd_ < 0 || ::getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+    {
+      return 0;
+    }
+    return ntohs(addr.sin_port);
+  }
+
+  void ReusePortSocket::close() noexcept
+  {
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  bool reuse_port_joinable(const std::string &host, std::uint16_t port) noexcept
+  {
+    try
+    {
+      ReusePortSocket::bind(host, port, -1);
+      return true;
+    }
+    catch (...)
+    {
+      return false;
+    }
+  }
+
+#else
+
+  ReusePortSocket ReusePortSocket::bind(const std::string &, std::uint16_t, int)
+  {
+    throw std::system_error(
+        std::make_error_code(std::errc::operation_not_supported),
+        "[ws] SO_REUSEPORT is not available on Windows");
+  }
+
+  std::uint16_t ReusePortSocket::port() const
+  {
+    return 0;
+  }
+
+  void ReusePortSocket::close() noexcept
+  {
+  }
+
+  bool reuse_port_joinable(const std::string &, std::uint16_t) noexcept
+  {
+    return false;
+  }
+
+#endif
+
+} // namespace vix::websocket::detail
@@ -16,9 +16,8 @@
 
 #include <stdexcept>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
 #include <cstdio>
+#include <utility>
 
 #include <nlohmann/json.hpp>
 
@@ -38,7 +37,121 @@ namespace vix::websocket
     }
   }
 
-  SqliteMessageStore::SqliteMessageStore(const std::string &db_path)
+  /**
+   * @brief Resets a cached statement and its bindings when leaving scope.
+   */
+  struct StatementReset
+  {
+    sqlite3_stmt *stmt;
+
+    ~StatementReset()
+    {
+      sqlite3_reset(stmt);
+      sqlite3_clear_bindings(stmt);
+    }
+  };
+
+  static sqlite3_stmt *prepare_cached(sqlite3 *db, const char *sql, const char *stage)
+  {
+    sqlite3_stmt *stmt = nullptr;
+    const int rc = sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+    sqlite_check(rc, db, stage);
+    return stmt;
+  }
+
+  static void exec_sql(sqlite3 *db, const char *sql, const char *stage)
+  {
+    char *errmsg = nullptr;
+    const int rc = sqlite3_exec(db, sql, nullptr, nullptr, &errmsg);
+    if (rc != SQLITE_OK)
+    {
+      std::string msg = "[SqliteMessageStore] ";
+      msg += stage;
+      msg += " error: ";
+      if (errmsg)
+      {
+        msg += errmsg;
+        sqlite3_free(errmsg);
+      }
+      throw std::runtime_error(msg);
+    }
+  }
+
+  static sqlite3_int64 query_int(sqlite3 *db, const char *sql, const char *stage)
+  {
+    sqlite3_stmt *stmt = nullptr;
+    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+    sqlite_check(rc, db, stage);
+
+    rc = sqlite3_step(stmt);
+    const sqlite3_int64 value = rc == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : 0;
+    sqlite3_finalize(stmt);
+
+    sqlite_check(rc, db, stage);
+    return value;
+  }
+
+  static JsonMessage read_message(sqlite3_stmt *stmt)
+  {
+    JsonMessage m;
+
+    const unsigned char *id = sqlite3_column_text(stmt, 0);
+    const unsigned char *kind = sqlite3_column_text(stmt, 1);
+    const unsigned char *room_col = sqlite3_column_text(stmt, 2);
+    const unsigned char *type = sqlite3_column_text(stmt, 3);
+    const unsigned char *ts = sqlite3_column_text(stmt, 4);
+    const unsigned char *payload_json = sqlite3_column_text(stmt, 5);
+
+    if (id)
+      m.id = reinterpret_cast<const char *>(id);
+    if (kind)
+      m.kind = reinterpret_cast<const char *>(kind);
+    if (room_col)
+      m.room = reinterpret_cast<const char *>(room_col);
+    if (type)
+      m.type = reinterpret_cast<const char *>(type);
+    if (ts)
+      m.ts = reinterpret_cast<const char *>(ts);
+
+    if (payload_json)
+    {
+      try
+      {
+        auto pj = nlohmann::json::parse(
+            reinterpret_cast<const char *>(payload_json));
+        m.payload = nlohmann_payload_to_kvs(pj);
+      }
+      catch (...)
+      {
+        m.payload = vix::json::kvs{};
+      }
+    }
+
+    return m;
+  }
+
+  static void read_messages(
+      sqlite3 *db,
+      sqlite3_stmt *stmt,
+      std::vector<JsonMessage> &out,
+      const char *stage)
+  {
+    int rc = SQLITE_OK;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+      out.push_back(read_message(stmt));
+    }
+
+    if (rc != SQLITE_DONE)
+    {
+      sqlite_check(rc, db, stage);
+    }
+  }
+
+  SqliteMessageStore::SqliteMessageStore(
+      const std::string &db_path,
+      SqliteStoreOptions options)
+      : options_(options)
   {
     int rc = sqlite3_open(db_path.c_str(), &db_);
     if (rc != SQLITE_OK)
@@ -63,11 +176,49 @@ namespace vix::websocket
       }
     }
 
-    init_schema();
+    try
+    {
+      init_schema();
+      seed_ids();
+      prepare_statements();
+    }
+    catch (...)
+    {
+      for (sqlite3_stmt *stmt : {insertStmt_, listStmt_, listBeforeStmt_, replayStmt_})
+      {
+        sqlite3_finalize(stmt);
+      }
+      sqlite3_close(db_);
+      db_ = nullptr;
+      throw;
+    }
+
+    if (options_.groupCommitMessages > 1)
+    {
+      pending_.reserve(options_.groupCommitMessages);
+      committing_.reserve(options_.groupCommitMessages);
+      writer_ = std::thread([this]()
+                            { writer_loop(); });
+    }
   }
 
   SqliteMessageStore::~SqliteMessageStore()
   {
+    if (writer_.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        stopping_ = true;
+      }
+      pendingCv_.notify_one();
+      writer_.join();
+    }
+
+    for (sqlite3_stmt *stmt : {insertStmt_, listStmt_, listBeforeStmt_, replayStmt_})
+    {
+      sqlite3_finalize(stmt);
+    }
+
     if (db_)
     {
       sqlite3_close(db_);
@@ -75,53 +226,152 @@ namespace vix::websocket
     }
   }
 
+  void SqliteMessageStore::prepare_statements()
+  {
+    // Re-appending an id updates the row in place and keeps its position.
+    insertStmt_ = prepare_cached(
+        db_,
+        "INSERT INTO messages "
+        "(id, kind, room, type, ts, payload_json) "
+        "VALUES (?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT(id) DO UPDATE SET "
+        "kind = excluded.kind, room = excluded.room, type = excluded.type, "
+        "ts = excluded.ts, payload_json = excluded.payload_json;",
+        "prepare append");
+
+    listStmt_ = prepare_cached(
+        db_,
+        "SELECT id, kind, room, type, ts, payload_json "
+        "FROM messages "
+        "WHERE room = ?1 "
+        "ORDER BY seq DESC "
+        "LIMIT ?2;",
+        "prepare list_by_room");
+
+    // Id cursors are resolved to a seq through the id index. A cursor that
+    // names no stored message still splits the history by id order.
+    listBeforeStmt_ = prepare_cached(
+        db_,
+        "SELECT id, kind, room, type, ts, payload_json "
+        "FROM messages "
+        "WHERE room = ?1 "
+        "AND seq < COALESCE("
+        "  (SELECT seq FROM messages WHERE id >= ?2 ORDER BY id ASC LIMIT 1),"
+        "  9223372036854775807) "
+        "ORDER BY seq DESC "
+        "LIMIT ?3;",
+        "prepare list_by_room");
+
+    replayStmt_ = prepare_cached(
+        db_,
+        "SELECT id, kind, room, type, ts, payload_json "
+        "FROM messages "
+        "WHERE seq > COALESCE("
+        "  (SELECT seq FROM messages WHERE id <= ?1 ORDER BY id DESC LIMIT 1),"
+        "  0) "
+        "ORDER BY seq ASC "
+        "LIMIT ?2;",
+        "prepare replay_from");
+  }
+
   void SqliteMessageStore::init_schema()
   {
-    const char *sql =
+    // seq is the rowid: the table is clustered in append order, so replay
+    // is a range scan of the table itself and room paging walks the
+    // (room, seq) index.
+    const char *create_sql =
         "CREATE TABLE IF NOT EXISTS messages ("
-        "  id           TEXT PRIMARY KEY,"
+        "  seq          INTEGER PRIMARY KEY,"
+        "  id           TEXT NOT NULL UNIQUE,"
         "  kind         TEXT NOT NULL,"
         "  room         TEXT,"
         "  type         TEXT NOT NULL,"
         "  ts           TEXT NOT NULL,"
         "  payload_json TEXT NOT NULL"
-        ");";
+        ");"
+        "CREATE INDEX IF NOT EXISTS messages_room_seq ON messages(room, seq);";
 
-    char *errmsg = nullptr;
-    int rc = sqlite3_exec(db_, sql, nullptr, nullptr, &errmsg);
-    if (rc != SQLITE_OK)
+    const sqlite3_int64 version = query_int(db_, "PRAGMA user_version;", "read schema version");
+    if (version >= SCHEMA_VERSION)
     {
-      std::string msg = "[SqliteMessageStore] Failed to create table: ";
-      if (errmsg)
-      {
-        msg += errmsg;
-        sqlite3_free(errmsg);
-      }
-      throw std::runtime_error(msg);
+      return;
     }
-  }
 
-  std::string SqliteMessageStore::generate_id()
-  {
-    using clock = std::chrono::system_clock;
-    auto now = clock::now().time_since_epoch();
-    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+    const bool legacy = query_int(
+                            db_,
+                            "SELECT COUNT(*) FROM sqlite_master "
+                            "WHERE type = 'table' AND name = 'messages';",
+                            "inspect schema") != 0;
 
-    std::ostringstream oss;
-    oss << std::setw(20) << std::setfill('0') << micros;
-    return oss.str();
+    exec_sql(db_, "BEGIN IMMEDIATE;", "begin migration");
+    try
+    {
+      if (legacy)
+      {
+        // Version 0 keyed rows by their TEXT id only. Rows are copied in
+        // id order, which is the order replay_from() used to return.
+        exec_sql(db_, "ALTER TABLE messages RENAME TO messages_v0;", "migrate schema");
+        exec_sql(db_, create_sql, "create table");
+        exec_sql(
+            db_,
+            "INSERT INTO messages (id, kind, room, type, ts, payload_json) "
+            "SELECT id, kind, room, type, ts, payload_json "
+            "FROM messages_v0 ORDER BY id;"
+            "DROP TABLE messages_v0;",
+            "migrate rows");
+      }
+      else
+      {
+        exec_sql(db_, create_sql, "create table");
+      }
+
+      const std::string set_version =
+          "PRAGMA user_version = " + std::to_string(SCHEMA_VERSION) + ";";
+      exec_sql(db_, set_version.c_str(), "write schema version");
+      exec_sql(db_, "COMMIT;", "commit migration");
+    }
+    catch (...)
+    {
+      sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+      throw;
+    }
   }
 
-  void SqliteMessageStore::append(const JsonMessage &msg)
+  void SqliteMessageStore::seed_ids()
   {
-    JsonMessage m = msg;
+    // Ids of other formats sort below or above generated ones as strings;
+    // only the generator's own format needs to be continued.
+    sqlite3_stmt *stmt = nullptr;
+    int rc = sqlite3_prepare_v2(
+        db_,
+        "SELECT id FROM messages WHERE length(id) = 20 ORDER BY id DESC LIMIT 1;",
+        -1, &stmt, nullptr);
+    sqlite_check(rc, db_, "prepare seed ids");
 
-    if (m.id.empty())
+    rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW)
     {
-      m.id = generate_id();
+      const auto *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+      if (const auto last = detail::MonotonicIdGenerator::parse(text ? text : ""))
+      {
+        ids_.observe(*last);
+      }
     }
+    sqlite3_finalize(stmt);
+
+    sqlite_check(rc, db_, "step seed ids");
+  }
 
-    if (m.ts.empty())
+  SqliteMessageStore::Row SqliteMessageStore::make_row(const JsonMessage &msg)
+  {
+    Row row;
+    row.id = msg.id;
+    row.kind = msg.kind.empty() ? "event" : msg.kind;
+    row.room = msg.room;
+    row.type = msg.type;
+    row.ts = msg.ts;
+
+    if (row.ts.empty())
     {
       using clock = std::chrono::system_clock;
       auto now = clock::now();
@@ -141,152 +391,247 @@ namespace vix::websocket
           tm.tm_hour,
           tm.tm_min,
           tm.tm_sec);
-      m.ts = buf;
+      row.ts = buf;
     }
 
-    if (m.kind.empty())
-    {
-      m.kind = "event";
-    }
-
-    nlohmann::json payloadJson = ws_kvs_to_nlohmann(m.payload);
-    std::string payloadText = payloadJson.dump();
-
-    const char *sql =
-        "INSERT OR REPLACE INTO messages "
-        "(id, kind, room, type, ts, payload_json) "
-        "VALUES (?, ?, ?, ?, ?, ?);";
+    row.payloadJson = ws_kvs_to_nlohmann(msg.payload).dump();
+    return row;
+  }
 
-    sqlite3_stmt *stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    sqlite_check(rc, db_, "prepare append");
+  void SqliteMessageStore::insert_row(const Row &row)
+  {
+    sqlite3_stmt *stmt = insertStmt_;
+    StatementReset reset{stmt};
 
-    rc = sqlite3_bind_text(stmt, 1, m.id.c_str(), -1, SQLITE_TRANSIENT);
+    // Bound values stay alive until the step below, so no copies are made.
+    int rc = sqlite3_bind_text(stmt, 1, row.id.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind id");
 
-    rc = sqlite3_bind_text(stmt, 2, m.kind.c_str(), -1, SQLITE_TRANSIENT);
+    rc = sqlite3_bind_text(stmt, 2, row.kind.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind kind");
 
-    if (m.room.empty())
+    if (row.room.empty())
     {
       rc = sqlite3_bind_null(stmt, 3);
     }
     else
     {
-      rc = sqlite3_bind_text(stmt, 3, m.room.c_str(), -1, SQLITE_TRANSIENT);
+      rc = sqlite3_bind_text(stmt, 3, row.room.c_str(), -1, SQLITE_STATIC);
     }
     sqlite_check(rc, db_, "bind room");
 
-    rc = sqlite3_bind_text(stmt, 4, m.type.c_str(), -1, SQLITE_TRANSIENT);
+    rc = sqlite3_bind_text(stmt, 4, row.type.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind type");
 
-    rc = sqlite3_bind_text(stmt, 5, m.ts.c_str(), -1, SQLITE_TRANSIENT);
+    rc = sqlite3_bind_text(stmt, 5, row.ts.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind ts");
 
-    rc = sqlite3_bind_text(stmt, 6, payloadText.c_str(), -1, SQLITE_TRANSIENT);
+    rc = sqlite3_bind_text(stmt, 6, row.payloadJson.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind payload");
 
     rc = sqlite3_step(stmt);
     sqlite_check(rc, db_, "step append");
-
-    sqlite3_finalize(stmt);
   }
 
-  std::vector<JsonMessage> SqliteMessageStore::list_by_room(
-      const std::string &room,
-      std::size_t limit,
-      const std::optional<std::string> &before_id)
+  void SqliteMessageStore::append(const JsonMessage &msg)
   {
-    std::vector<JsonMessage> out;
-    if (limit == 0)
-      return out;
-
-    const char *sql_base =
-        "SELECT id, kind, room, type, ts, payload_json "
-        "FROM messages "
-        "WHERE room = ?1 ";
+    Row row = make_row(msg);
 
-    std::string sql;
-    if (before_id.has_value())
+    if (!writer_.joinable())
     {
-      sql = std::string(sql_base) +
-            "AND id < ?2 "
-            "ORDER BY id DESC "
-            "LIMIT ?3;";
+      std::lock_guard<std::mutex> lock(dbMutex_);
+      if (row.id.empty())
+      {
+        row.id = ids_.next();
+      }
+      insert_row(row);
+      return;
     }
-    else
+
+    std::size_t depth = 0;
     {
-      sql = std::string(sql_base) +
-            "ORDER BY id DESC "
-            "LIMIT ?2;";
-    }
+      std::lock_guard<std::mutex> lock(pendingMutex_);
 
-    sqlite3_stmt *stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
-    sqlite_check(rc, db_, "prepare list_by_room");
+      // Taken with the queue slot, so a later id is never queued earlier.
+      if (row.id.empty())
+      {
+        row.id = ids_.next();
+      }
 
-    rc = sqlite3_bind_text(stmt, 1, room.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite_check(rc, db_, "bind room");
+      if (pending_.empty())
+      {
+        firstPendingAt_ = std::chrono::steady_clock::now();
+      }
 
-    if (before_id.has_value())
-    {
-      rc = sqlite3_bind_text(stmt, 2, before_id->c_str(), -1, SQLITE_TRANSIENT);
-      sqlite_check(rc, db_, "bind before_id");
+      pending_.push_back(std::move(row));
+      depth = pending_.size();
+    }
 
-      rc = sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(limit));
-      sqlite_check(rc, db_, "bind limit");
+    // Wake the writer to start the delay, or early once the batch is full.
+    if (depth == 1 || depth >= options_.groupCommitMessages)
+    {
+      pendingCv_.notify_one();
     }
-    else
+  }
+
+  void SqliteMessageStore::flush()
+  {
+    if (!writer_.joinable())
     {
-      rc = sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(limit));
-      sqlite_check(rc, db_, "bind limit");
+      return;
     }
 
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    commit_pending();
+
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    rethrow_writer_error();
+  }
+
+  void SqliteMessageStore::commit_pending()
+  {
+    std::exception_ptr error;
+    std::vector<std::string> lostIds;
+
     {
-      JsonMessage m;
-
-      const unsigned char *id = sqlite3_column_text(stmt, 0);
-      const unsigned char *kind = sqlite3_column_text(stmt, 1);
-      const unsigned char *room_col = sqlite3_column_text(stmt, 2);
-      const unsigned char *type = sqlite3_column_text(stmt, 3);
-      const unsigned char *ts = sqlite3_column_text(stmt, 4);
-      const unsigned char *payload_json = sqlite3_column_text(stmt, 5);
-
-      if (id)
-        m.id = reinterpret_cast<const char *>(id);
-      if (kind)
-        m.kind = reinterpret_cast<const char *>(kind);
-      if (room_col)
-        m.room = reinterpret_cast<const char *>(room_col);
-      if (type)
-        m.type = reinterpret_cast<const char *>(type);
-      if (ts)
-        m.ts = reinterpret_cast<const char *>(ts);
-
-      if (payload_json)
+      // Holding dbMutex_ across the swap keeps batches committed in order,
+      // so a flush() also waits for a batch the writer already took.
+      std::lock_guard<std::mutex> dbLock(dbMutex_);
+      {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        committing_.swap(pending_);
+      }
+
+      if (committing_.empty())
+      {
+        return;
+      }
+
+      try
       {
+        exec_sql(db_, "BEGIN IMMEDIATE;", "begin batch");
+
         try
         {
-          auto pj = nlohmann::json::parse(
-              reinterpret_cast<const char *>(payload_json));
-          m.payload = nlohmann_payload_to_kvs(pj);
+          for (const Row &row : committing_)
+          {
+            insert_row(row);
+          }
+
+          exec_sql(db_, "COMMIT;", "commit batch");
         }
         catch (...)
         {
-          m.payload = vix::json::kvs{};
+          sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+          throw;
+        }
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+        lostIds.reserve(committing_.size());
+        for (Row &row : committing_)
+        {
+          lostIds.push_back(std::move(row.id));
         }
       }
 
-      out.push_back(std::move(m));
+      committing_.clear();
     }
 
-    if (rc != SQLITE_DONE)
+    if (!error)
     {
-      sqlite_check(rc, db_, "step list_by_room");
+      return;
     }
 
-    sqlite3_finalize(stmt);
+    {
+      std::lock_guard<std::mutex> lock(pendingMutex_);
+      if (!writerError_)
+      {
+        writerError_ = error;
+      }
+    }
+
+    if (options_.onCommitError)
+    {
+      try
+      {
+        options_.onCommitError(error, lostIds);
+      }
+      catch (...)
+      {
+      }
+    }
+  }
+
+  void SqliteMessageStore::writer_loop()
+  {
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+
+    while (true)
+    {
+      pendingCv_.wait(lock, [this]()
+                      { return stopping_ || !pending_.empty(); });
+
+      if (pending_.empty())
+      {
+        return;
+      }
+
+      pendingCv_.wait_until(
+          lock,
+          firstPendingAt_ + options_.groupCommitDelay,
+          [this]()
+          { return stopping_ || pending_.size() >= options_.groupCommitMessages; });
+
+      lock.unlock();
+      commit_pending();
+      lock.lock();
+    }
+  }
+
+  void SqliteMessageStore::rethrow_writer_error()
+  {
+    if (writerError_)
+    {
+      std::rethrow_exception(std::exchange(writerError_, nullptr));
+    }
+  }
+
+  std::vector<JsonMessage> SqliteMessageStore::list_by_room(
+      const std::string &room,
+      std::size_t limit,
+      const std::optional<std::string> &before_id)
+  {
+    std::vector<JsonMessage> out;
+    if (limit == 0)
+      return out;
+
+    // Reads see every append before them; batch errors are left to flush().
+    commit_pending();
+
+    std::lock_guard<std::mutex> lock(dbMutex_);
+
+    sqlite3_stmt *stmt = before_id.has_value() ? listBeforeStmt_ : listStmt_;
+    StatementReset reset{stmt};
+
+    int rc = sqlite3_bind_text(stmt, 1, room.c_str(), -1, SQLITE_STATIC);
+    sqlite_check(rc, db_, "bind room");
+
+    if (before_id.has_value())
+    {
+      rc = sqlite3_bind_text(stmt, 2, before_id->c_str(), -1, SQLITE_STATIC);
+      sqlite_check(rc, db_, "bind before_id");
+
+      rc = sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(limit));
+      sqlite_check(rc, db_, "bind limit");
+    }
+    else
+    {
+      rc = sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(limit));
+      sqlite_check(rc, db_, "bind limit");
+    }
+
+    read_messages(db_, stmt, out, "step list_by_room");
     return out;
   }
 
@@ -298,68 +643,21 @@ namespace vix::websocket
     if (limit == 0)
       return out;
 
-    const char *sql =
-        "SELECT id, kind, room, type, ts, payload_json "
-        "FROM messages "
-        "WHERE id > ?1 "
-        "ORDER BY id ASC "
-        "LIMIT ?2;";
+    // Reads see every append before them; batch errors are left to flush().
+    commit_pending();
 
-    sqlite3_stmt *stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr);
-    sqlite_check(rc, db_, "prepare replay_from");
+    std::lock_guard<std::mutex> lock(dbMutex_);
 
-    rc = sqlite3_bind_text(stmt, 1, start_id.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_stmt *stmt = replayStmt_;
+    StatementReset reset{stmt};
+
+    int rc = sqlite3_bind_text(stmt, 1, start_id.c_str(), -1, SQLITE_STATIC);
     sqlite_check(rc, db_, "bind start_id");
 
     rc = sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(limit));
     sqlite_check(rc, db_, "bind limit");
 
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
-    {
-      JsonMessage m;
-
-      const unsigned char *id = sqlite3_column_text(stmt, 0);
-      const unsigned char *kind = sqlite3_column_text(stmt, 1);
-      const unsigned char *room_col = sqlite3_column_text(stmt, 2);
-      const unsigned char *type = sqlite3_column_text(stmt, 3);
-      const unsigned char *ts = sqlite3_column_text(stmt, 4);
-      const unsigned char *payload_json = sqlite3_column_text(stmt, 5);
-
-      if (id)
-        m.id = reinterpret_cast<const char *>(id);
-      if (kind)
-        m.kind = reinterpret_cast<const char *>(kind);
-      if (room_col)
-        m.room = reinterpret_cast<const char *>(room_col);
-      if (type)
-        m.type = reinterpret_cast<const char *>(type);
-      if (ts)
-        m.ts = reinterpret_cast<const char *>(ts);
-
-      if (payload_json)
-      {
-        try
-        {
-          auto pj = nlohmann::json::parse(
-              reinterpret_cast<const char *>(payload_json));
-          m.payload = nlohmann_payload_to_kvs(pj);
-        }
-        catch (...)
-        {
-          m.payload = vix::json::kvs{};
-        }
-      }
-
-      out.push_back(std::move(m));
-    }
-
-    if (rc != SQLITE_DONE)
-    {
-      sqlite_check(rc, db_, "step replay_from");
-    }
-
-    sqlite3_finalize(stmt);
+    read_messages(db_, stmt, out, "step replay_from");
     return out;
   }
 
@@ -0,0 +1,250 @@
+/**
+ *
+ *  @file TimerWheel.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/TimerWheel.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace vix::websocket::detail
+{
+  namespace
+  {
+    constexpr std::uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+    /** Ticks covered by levels [0, level]. */
+    constexpr std::uint64_t level_span(std::size_t level) noexcept
+    {
+      return std::uint64_t{1} << (TimerWheel::SLOT_BITS * (level + 1));
+    }
+
+    constexpr std::uint64_t MAX_DELAY = level_span(TimerWheel::LEVELS - 1) - 1;
+  } // namespace
+
+  TimerWheel::Timer::~Timer()
+  {
+    if (wheel_)
+    {
+      wheel_->cancel(*this);
+    }
+  }
+
+  TimerWheel::TimerWheel(std::chrono::milliseconds tick, Clock::time_point origin)
+      : tick_(std::max(tick, std::chrono::milliseconds{1})),
+        origin_(origin)
+  {
+  }
+
+  TimerWheel::~TimerWheel()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto &level : slots_)
+    {
+      for (Timer *&head : level)
+      {
+        for (Timer *t = head; t != nullptr;)
+        {
+          Timer *next = t->next_;
+          t->prev_ = nullptr;
+          t->next_ = nullptr;
+          t->linked_ = false;
+          t->wheel_ = nullptr;
+          t = next;
+        }
+        head = nullptr;
+      }
+    }
+  }
+
+  std::uint64_t TimerWheel::to_ticks(std::chrono::milliseconds d) const noexcept
+  {
+    if (d.count() <= 0)
+    {
+      return 1;
+    }
+
+    const auto ticks = static_cast<std::uint64_t>((d.count() + tick_.count() - 1) / tick_.count());
+    return std::max<std::uint64_t>(ticks, 1);
+  }
+
+  void TimerWheel::schedule(Timer &timer, std::chrono::milliseconds delay, Callback callback)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    unlink_locked(timer);
+    timer.callback_ = std::move(callback);
+    timer.wheel_ = this;
+    timer.expiry_ = now_.load(std::memory_order_relaxed) + std::min(to_ticks(delay), MAX_DELAY);
+    link_locked(timer);
+  }
+
+  void TimerWheel::reschedule(Timer &timer, std::chrono::milliseconds delay)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    unlink_locked(timer);
+    timer.wheel_ = this;
+    timer.expiry_ = now_.load(std::memory_order_relaxed) + std::min(to_ticks(delay), MAX_DELAY);
+    link_locked(timer);
+  }
+
+  void TimerWheel::cancel(Timer &timer) noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    unlink_locked(timer);
+  }
+
+  std::size_t TimerWheel::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  void TimerWheel::link_locked(Timer &timer) noexcept
+  {
+    const std::uint64_t now = now_.load(std::memory_order_relaxed);
+    const std::uint64_t delta = timer.expiry_ - now;
+
+    std::size_t level = 0;
+    while (level + 1 < LEVELS && delta >= level_span(level))
+    {
+      ++level;
+    }
+
+    const auto slot = static_cast<std::size_t>(
+        (timer.expiry_ >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    Timer *&head = slots_[level][slot];
+    timer.prev_ = nullptr;
+    timer.next_ = head;
+    if (head)
+    {
+      head->prev_ = &timer;
+    }
+    head = &timer;
+
+    timer.level_ = static_cast<std::uint8_t>(level);
+    timer.slot_ = static_cast<std::uint8_t>(slot);
+    timer.linked_ = true;
+    ++size_;
+  }
+
+  void TimerWheel::unlink_locked(Timer &timer) noexcept
+  {
+    if (!timer.linked_)
+    {
+      return;
+    }
+
+    if (timer.prev_)
+    {
+      timer.prev_->next_ = timer.next_;
+    }
+    else
+    {
+      slots_[timer.level_][timer.slot_] = timer.next_;
+    }
+
+    if (timer.next_)
+    {
+      timer.next_->prev_ = timer.prev_;
+    }
+
+    timer.prev_ = nullptr;
+    timer.next_ = nullptr;
+    timer.linked_ = false;
+    --size_;
+  }
+
+  void TimerWheel::cascade_locked(std::size_t level) noexcept
+  {
+    const std::uint64_t now = now_.load(std::memory_order_relaxed);
+    const auto slot = static_cast<std::size_t>((now >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    Timer *t = slots_[level][slot];
+    slots_[level][slot] = nullptr;
+
+    while (t)
+    {
+      Timer *next = t->next_;
+      t->linked_ = false;
+      --size_;
+      link_locked(*t);
+      t = next;
+    }
+  }
+
+  std::size_t TimerWheel::advance(Clock::time_point now)
+  {
+    if (now <= origin_)
+    {
+      return 0;
+    }
+
+    const auto target = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - origin_).count() /
+        tick_.count());
+
+    std::vector<Callback> expired;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      std::uint64_t current = now_.load(std::memory_order_relaxed);
+      while (current < target)
+      {
+        ++current;
+        now_.store(current, std::memory_order_relaxed);
+
+        // Pull timers down from coarser levels whenever the finer level
+        // wraps around.
+        for (std::size_t level = 1; level < LEVELS; ++level)
+        {
+          if ((current & (level_span(level - 1) - 1)) != 0)
+          {
+            break;
+          }
+          cascade_locked(level);
+        }
+
+        Timer *t = slots_[0][current & SLOT_MASK];
+        slots_[0][current & SLOT_MASK] = nullptr;
+
+        while (t)
+        {
+          Timer *next = t->next_;
+          t->prev_ = nullptr;
+          t->next_ = nullptr;
+          t->linked_ = false;
+          --size_;
+
+          if (t->callback_)
+          {
+            expired.push_back(t->callback_);
+          }
+          t = next;
+        }
+      }
+    }
+
+    for (auto &callback : expired)
+    {
+      callback();
+    }
+
+    return expired.size();
+  }
+
+} // namespace vix::websocket::detail
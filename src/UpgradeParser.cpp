@@ -0,0 +1,338 @@
+/**
+ *
+ *  @file UpgradeParser.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/UpgradeParser.hpp>
+
+#include <algorithm>
+
+namespace vix::websocket::detail
+{
+  namespace
+  {
+    constexpr char lower_ascii(char c) noexcept
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    constexpr bool is_ows(char c) noexcept
+    {
+      return c == ' ' || c == '\t';
+    }
+
+    std::string_view trim_ows(std::string_view s) noexcept
+    {
+      while (!s.empty() && is_ows(s.front()))
+      {
+        s.remove_prefix(1);
+      }
+      while (!s.empty() && is_ows(s.back()))
+      {
+        s.remove_suffix(1);
+      }
+      return s;
+    }
+  } // namespace
+
+  std::string_view HeaderValues::joined(std::string &storage) const
+  {
+    if (count <= 1)
+    {
+      return lines[0];
+    }
+
+    storage.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (lines[i].empty())
+      {
+        continue;
+      }
+
+      if (!storage.empty())
+      {
+        storage += ", ";
+      }
+      storage += lines[i];
+    }
+    return storage;
+  }
+
+  bool iequals_ascii(std::string_view a, std::string_view b) noexcept
+  {
+    if (a.size() != b.size())
+    {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+      if (lower_ascii(a[i]) != lower_ascii(b[i]))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool header_has_token(std::string_view value, std::string_view token) noexcept
+  {
+    while (!value.empty())
+    {
+      const std::size_t comma = value.find(',');
+      const std::string_view part =
+          comma == std::string_view::npos ? value : value.substr(0, comma);
+
+      if (iequals_ascii(trim_ows(part), token))
+      {
+        return true;
+      }
+
+      if (comma == std::string_view::npos)
+      {
+        break;
+      }
+
+      value.remove_prefix(comma + 1);
+    }
+
+    return false;
+  }
+
+  UpgradeParser::Status UpgradeParser::parse(std::string_view buffer) noexcept
+  {
+    if (status_ != Status::NeedMore)
+    {
+      return status_;
+    }
+
+    while (true)
+    {
+      const std::size_t end = buffer.find("\r\n", scanPos_);
+
+      if (end == std::string_view::npos || end + 2 > maxHeadSize_)
+      {
+        if (buffer.size() > maxHeadSize_)
+        {
+          return fail("websocket HTTP head too large");
+        }
+
+        // A CR at the very end may be the first half of the next CRLF.
+        scanPos_ = std::max(lineStart_, buffer.empty() ? 0 : buffer.size() - 1);
+        return Status::NeedMore;
+      }
+
+      if (lineStart_ == 0)
+      {
+        if (!parse_request_line(buffer, end))
+        {
+          return status_;
+        }
+      }
+      else if (end == lineStart_)
+      {
+        headSize_ = end + 2;
+        status_ = Status::Complete;
+        return status_;
+      }
+      else if (!parse_header_line(buffer, end))
+      {
+        return status_;
+      }
+
+      lineStart_ = end + 2;
+      scanPos_ = lineStart_;
+    }
+  }
+
+  bool UpgradeParser::parse_request_line(std::string_view buffer, std::size_t end) noexcept
+  {
+    const std::string_view line = buffer.substr(0, end);
+
+    const std::size_t sp1 = line.find(' ');
+    if (sp1 == 0 || sp1 == std::string_view::npos)
+    {
+      fail("malformed websocket request line");
+      return false;
+    }
+
+    const std::size_t sp2 = line.find(' ', sp1 + 1);
+    if (sp2 == std::string_view::npos || sp2 == sp1 + 1)
+    {
+      fail("malformed websocket request line");
+      return false;
+    }
+
+    if (line.substr(sp2 + 1).rfind("HTTP/1.", 0) != 0)
+    {
+      fail("websocket handshake requires HTTP/1.1");
+      return false;
+    }
+
+    method_ = Field{0, static_cast<std::uint32_t>(sp1)};
+    target_ = Field{static_cast<std::uint32_t>(sp1 + 1),
+                    static_cast<std::uint32_t>(sp2 - sp1 - 1)};
+    return true;
+  }
+
+  bool UpgradeParser::parse_header_line(std::string_view buffer, std::size_t end) noexcept
+  {
+    const std::string_view line = buffer.substr(lineStart_, end - lineStart_);
+
+    if (is_ows(line.front()))
+    {
+      fail("folded websocket header lines are not supported");
+      return false;
+    }
+
+    const std::size_t colon = line.find(':');
+    if (colon == 0 || colon == std::string_view::npos || is_ows(line[colon - 1]))
+    {
+      fail("malformed websocket header line");
+      return false;
+    }
+
+    const std::string_view name = line.substr(0, colon);
+
+    // Header names are dispatched on length first; each needed name has a
+    // distinct length, so at most one case-insensitive compare runs per line.
+    HeaderId id = HeaderId::Count;
+    switch (name.size())
+    {
+    case 4:
+      id = iequals_ascii(name, "host") ? HeaderId::Host : id;
+      break;
+    case 6:
+      id = iequals_ascii(name, "origin") ? HeaderId::Origin : id;
+      break;
+    case 7:
+      id = iequals_ascii(name, "upgrade") ? HeaderId::Upgrade : id;
+      break;
+    case 10:
+      id = iequals_ascii(name, "connection") ? HeaderId::Connection : id;
+      break;
+    case 17:
+      id = iequals_ascii(name, "sec-websocket-key") ? HeaderId::Key : id;
+      break;
+    case 21:
+      id = iequals_ascii(name, "sec-websocket-version") ? HeaderId::Version : id;
+      break;
+    case 22:
+      id = iequals_ascii(name, "sec-websocket-protocol") ? HeaderId::Protocol : id;
+      break;
+    case 24:
+      id = iequals_ascii(name, "sec-websocket-extensions") ? HeaderId::Extensions : id;
+      break;
+    default:
+      break;
+    }
+
+    if (id == HeaderId::Count)
+    {
+      return true;
+    }
+
+    const std::string_view value = trim_ows(line.substr(colon + 1));
+
+    if (id == HeaderId::Connection && header_has_token(value, "upgrade"))
+    {
+      connectionUpgrade_ = true;
+    }
+
+    const auto index = static_cast<std::size_t>(id);
+    const Field field{
+        static_cast<std::uint32_t>(value.data() - buffer.data()),
+        static_cast<std::uint32_t>(value.size())};
+
+    if (index >= FIRST_LIST)
+    {
+      std::uint8_t &count = listCounts_[index - FIRST_LIST];
+      if (count == HeaderValues::MAX_LINES)
+      {
+        fail("too many websocket list header lines");
+        return false;
+      }
+
+      lists_[index - FIRST_LIST][count++] = field;
+      return true;
+    }
+
+    if (!seen_[index])
+    {
+      seen_[index] = true;
+      headers_[index] = field;
+    }
+
+    return true;
+  }
+
+  UpgradeParser::Status UpgradeParser::fail(const char *reason) noexcept
+  {
+    error_ = reason;
+    status_ = Status::Error;
+    return status_;
+  }
+
+  UpgradeRequest UpgradeParser::request(std::string_view buffer) const noexcept
+  {
+    const auto view = [buffer](Field f) noexcept
+    {
+      return buffer.substr(f.offset, f.size);
+    };
+    const auto header = [&](HeaderId id) noexcept
+    {
+      return view(headers_[static_cast<std::size_t>(id)]);
+    };
+    const auto list = [&](HeaderId id) noexcept
+    {
+      const std::size_t i = static_cast<std::size_t>(id) - FIRST_LIST;
+
+      HeaderValues values;
+      values.count = listCounts_[i];
+      for (std::size_t n = 0; n < values.count; ++n)
+      {
+        values.lines[n] = view(lists_[i][n]);
+      }
+      return values;
+    };
+
+    UpgradeRequest r;
+    if (status_ != Status::Complete)
+    {
+      return r;
+    }
+
+    r.method = view(method_);
+    r.target = view(target_);
+
+    const std::size_t q = r.target.find('?');
+    r.path = r.target.substr(0, q);
+    if (q != std::string_view::npos)
+    {
+      r.query = r.target.substr(q + 1);
+    }
+
+    r.host = header(HeaderId::Host);
+    r.origin = header(HeaderId::Origin);
+    r.upgrade = header(HeaderId::Upgrade);
+    r.connection = header(HeaderId::Connection);
+    r.key = header(HeaderId::Key);
+    r.version = header(HeaderId::Version);
+    r.extensions = list(HeaderId::Extensions);
+    r.protocol = list(HeaderId::Protocol);
+    r.connectionUpgrade = connectionUpgrade_;
+    r.headSize = headSize_;
+    return r;
+  }
+
+} // namespace vix::websocket::detail
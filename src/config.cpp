@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <string>
 
 namespace vix::websocket
 {
@@ -48,6 +49,24 @@ namespace vix::websocket
     cfg.enablePerMessageDeflate =
         core.getBool("websocket.enable_deflate", cfg.enablePerMessageDeflate);
 
+    {
+      const int value = core.getInt(
+          "websocket.deflate_min_size",
+          static_cast<int>(cfg.deflateMinSize));
+
+      cfg.deflateMinSize = static_cast<std::size_t>(std::max(0, value));
+    }
+
+    cfg.deflateServerNoContextTakeover =
+        core.getBool("websocket.deflate_server_no_context_takeover",
+                     cfg.deflateServerNoContextTakeover);
+
+    cfg.deflateServerMaxWindowBits = std::clamp(
+        core.getInt("websocket.deflate_server_max_window_bits",
+                    cfg.deflateServerMaxWindowBits),
+        9,
+        15);
+
     {
       const int value = core.getInt(
           "websocket.ping_interval",
@@ -63,9 +82,78 @@ namespace vix::websocket
       }
     }
 
+    {
+      const int value = core.getInt(
+          "websocket.close_timeout",
+          static_cast<int>(cfg.closeTimeout.count()));
+
+      cfg.closeTimeout = std::chrono::seconds{std::max(0, value)};
+    }
+
     cfg.autoPingPong =
         core.getBool("websocket.auto_ping_pong", cfg.autoPingPong);
 
+    {
+      const int value = core.getInt(
+          "websocket.write_batch_max_messages",
+          static_cast<int>(cfg.writeBatchMaxMessages));
+
+      cfg.writeBatchMaxMessages = static_cast<std::size_t>(std::max(1, value));
+    }
+
+    {
+      const int value = core.getInt(
+          "websocket.write_batch_max_bytes",
+          static_cast<int>(cfg.writeBatchMaxBytes));
+
+      cfg.writeBatchMaxBytes = static_cast<std::size_t>(std::max(1024, value));
+    }
+
+    {
+      const int value = core.getInt(
+          "websocket.write_fragment_size",
+          static_cast<int>(cfg.writeFragmentSize));
+
+      cfg.writeFragmentSize =
+          value <= 0 ? 0 : static_cast<std::size_t>(std::max(1024, value));
+    }
+
+    {
+      const int value = core.getInt(
+          "websocket.acceptor_threads",
+          static_cast<int>(cfg.acceptorThreads));
+
+      cfg.acceptorThreads = static_cast<std::size_t>(std::clamp(value, 1, 1024));
+    }
+
+    cfg.sharedNothing =
+        core.getBool("websocket.shared_nothing", cfg.sharedNothing);
+
+    {
+      const int value = core.getInt(
+          "websocket.max_pending_messages",
+          static_cast<int>(cfg.backpressure.maxMessages));
+
+      cfg.backpressure.maxMessages = static_cast<std::size_t>(std::max(1, value));
+    }
+
+    {
+      const int value = core.getInt(
+          "websocket.max_pending_bytes",
+          static_cast<int>(cfg.backpressure.maxBytes));
+
+      cfg.backpressure.maxBytes = static_cast<std::size_t>(std::max(1024, value));
+    }
+
+    {
+      const std::string name = core.getString("websocket.backpressure_policy", "close");
+      BackpressurePolicy policy = cfg.backpressure.policy;
+      if (parse_backpressure_policy(name, policy))
+      {
+        cfg.backpressure.policy = policy;
+      }
+    }
+
     return cfg;
   }
 
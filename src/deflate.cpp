@@ -0,0 +1,411 @@
+/**
+ *
+ *  @file deflate.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/deflate.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+namespace vix::websocket::detail
+{
+  namespace
+  {
+    constexpr unsigned char SYNC_FLUSH_TRAILER[4] = {0x00, 0x00, 0xff, 0xff};
+    constexpr std::size_t INFLATE_STEP = 16 * 1024;
+
+    std::string_view trim(std::string_view s) noexcept
+    {
+      while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+      {
+        s.remove_prefix(1);
+      }
+
+      while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+      {
+        s.remove_suffix(1);
+      }
+
+      return s;
+    }
+
+    bool iequals(std::string_view a, std::string_view b) noexcept
+    {
+      if (a.size() != b.size())
+      {
+        return false;
+      }
+
+      for (std::size_t i = 0; i < a.size(); ++i)
+      {
+        if (std::tolower(static_cast<unsigned char>(a[i])) !=
+            std::tolower(static_cast<unsigned char>(b[i])))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    /** Split on @p sep, ignoring separators inside double quotes. */
+    std::vector<std::string_view> split_unquoted(std::string_view s, char sep)
+    {
+      std::vector<std::string_view> parts;
+      bool quoted = false;
+      std::size_t start = 0;
+
+      for (std::size_t i = 0; i < s.size(); ++i)
+      {
+        if (s[i] == '"')
+        {
+          quoted = !quoted;
+        }
+        else if (s[i] == sep && !quoted)
+        {
+          parts.push_back(trim(s.substr(start, i - start)));
+          start = i + 1;
+        }
+      }
+
+      parts.push_back(trim(s.substr(start)));
+      return parts;
+    }
+
+    /** Parse a window-bits value ("10" or "\"10\""); -1 if invalid. */
+    int parse_window_bits(std::string_view v) noexcept
+    {
+      v = trim(v);
+      if (v.size() >= 2 && v.front() == '"' && v.back() == '"')
+      {
+        v = v.substr(1, v.size() - 2);
+      }
+
+      if (v.empty() || v.size() > 2)
+      {
+        return -1;
+      }
+
+      int bits = 0;
+      for (char c : v)
+      {
+        if (c < '0' || c > '9')
+        {
+          return -1;
+        }
+        bits = bits * 10 + (c - '0');
+      }
+
+      return (bits >= 8 && bits <= 15) ? bits : -1;
+    }
+
+    /** Try to accept one offer; std::nullopt if it must be declined. */
+    std::optional<DeflateNegotiation> accept_offer(
+        const std::vector<std::string_view> &params,
+        const DeflateParams &policy)
+    {
+      bool serverNoContext = false;
+      bool clientNoContext = false;
+      int serverBits = 0;
+      int clientBits = 0;
+      bool clientBitsOffered = false;
+
+      for (std::size_t i = 1; i < params.size(); ++i)
+      {
+        const std::string_view param = params[i];
+        const std::size_t eq = param.find('=');
+        const std::string_view name = trim(param.substr(0, eq));
+        const bool hasValue = eq != std::string_view::npos;
+        const std::string_view value = hasValue ? param.substr(eq + 1) : std::string_view{};
+
+        if (iequals(name, "server_no_context_takeover"))
+        {
+          if (hasValue || serverNoContext)
+          {
+            return std::nullopt;
+          }
+          serverNoContext = true;
+        }
+        else if (iequals(name, "client_no_context_takeover"))
+        {
+          if (hasValue || clientNoContext)
+          {
+            return std::nullopt;
+          }
+          clientNoContext = true;
+        }
+        else if (iequals(name, "server_max_window_bits"))
+        {
+          if (!hasValue || serverBits != 0)
+          {
+            return std::nullopt;
+          }
+          serverBits = parse_window_bits(value);
+          if (serverBits < 0)
+          {
+            return std::nullopt;
+          }
+        }
+        else if (iequals(name, "client_max_window_bits"))
+        {
+          if (clientBitsOffered)
+          {
+            return std::nullopt;
+          }
+          clientBitsOffered = true;
+          clientBits = hasValue ? parse_window_bits(value) : 15;
+          if (clientBits < 0)
+          {
+            return std::nullopt;
+          }
+        }
+        else
+        {
+          return std::nullopt;
+        }
+      }
+
+      DeflateNegotiation result;
+      DeflateParams &p = result.params;
+
+      p.serverNoContextTakeover = serverNoContext || policy.serverNoContextTakeover;
+      p.clientNoContextTakeover = clientNoContext;
+      p.serverMaxWindowBits = std::min(
+          serverBits != 0 ? serverBits : 15,
+          std::clamp(policy.serverMaxWindowBits, 9, 15));
+      p.clientMaxWindowBits = clientBitsOffered ? clientBits : 15;
+
+      // zlib cannot produce a raw deflate stream with a 256-byte window.
+      if (p.serverMaxWindowBits < 9)
+      {
+        return std::nullopt;
+      }
+
+      std::string &h = result.responseHeader;
+      h = "permessage-deflate";
+
+      if (p.serverNoContextTakeover)
+      {
+        h += "; server_no_context_takeover";
+      }
+
+      if (p.clientNoContextTakeover)
+      {
+        h += "; client_no_context_takeover";
+      }
+
+      if (serverBits != 0 || p.serverMaxWindowBits < 15)
+      {
+        h += "; server_max_window_bits=" + std::to_string(p.serverMaxWindowBits);
+      }
+
+      return result;
+    }
+  } // namespace
+
+  std::optional<DeflateNegotiation> negotiate_permessage_deflate(
+      std::string_view offers,
+      const DeflateParams &policy)
+  {
+    for (std::string_view offer : split_unquoted(offers, ','))
+    {
+      const auto params = split_unquoted(offer, ';');
+      if (params.empty() || !iequals(params.front(), "permessage-deflate"))
+      {
+        continue;
+      }
+
+      if (auto accepted = accept_offer(params, policy))
+      {
+        return accepted;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  struct PerMessageDeflate::Streams
+  {
+    z_stream deflater{};
+    z_stream inflater{};
+    bool deflaterReady{false};
+    bool inflaterReady{false};
+
+    ~Streams()
+    {
+      if (deflaterReady)
+      {
+        deflateEnd(&deflater);
+      }
+
+      if (inflaterReady)
+      {
+        inflateEnd(&inflater);
+      }
+    }
+  };
+
+  PerMessageDeflate::PerMessageDeflate(const DeflateParams &params)
+      : params_(params),
+        streams_(std::make_unique<Streams>())
+  {
+  }
+
+  PerMessageDeflate::~PerMessageDeflate() = default;
+
+  void PerMessageDeflate::compress(std::span<const std::byte> in, std::string &out)
+  {
+    z_stream &z = streams_->deflater;
+
+    if (!streams_->deflaterReady)
+    {
+      if (deflateInit2(&z,
+                       Z_DEFAULT_COMPRESSION,
+                       Z_DEFLATED,
+                       -params_.serverMaxWindowBits,
+                       8,
+                       Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        throw std::runtime_error("permessage-deflate: deflateInit2 failed");
+      }
+      streams_->deflaterReady = true;
+    }
+
+    out.resize(deflateBound(&z, static_cast<uLong>(in.size())) + 16);
+
+    z.next_in = reinterpret_cast<Bytef *>(const_cast<std::byte *>(in.data()));
+    z.avail_in = static_cast<uInt>(in.size());
+
+    std::size_t produced = 0;
+    do
+    {
+      if (produced == out.size())
+      {
+        out.resize(out.size() * 2);
+      }
+
+      z.next_out = reinterpret_cast<Bytef *>(out.data() + produced);
+      z.avail_out = static_cast<uInt>(out.size() - produced);
+
+      const int rc = deflate(&z, Z_SYNC_FLUSH);
+      if (rc != Z_OK && rc != Z_BUF_ERROR)
+      {
+        throw std::runtime_error("permessage-deflate: deflate failed");
+      }
+
+      produced = out.size() - z.avail_out;
+    } while (z.avail_out == 0);
+
+    // A sync flush always ends with an empty stored block; RFC 7692 7.2.1
+    // drops its 4-byte tail from the wire.
+    if (produced >= 4)
+    {
+      produced -= 4;
+    }
+    out.resize(produced);
+
+    if (params_.serverNoContextTakeover)
+    {
+      deflateReset(&z);
+    }
+  }
+
+  void PerMessageDeflate::decompress(
+      std::span<const std::byte> in,
+      bool lastChunk,
+      std::string &out,
+      std::size_t maxMessageSize)
+  {
+    if (!streams_->inflaterReady)
+    {
+      // A full 15-bit window accepts streams produced with any smaller one.
+      if (inflateInit2(&streams_->inflater, -15) != Z_OK)
+      {
+        throw std::runtime_error("permessage-deflate: inflateInit2 failed");
+      }
+      streams_->inflaterReady = true;
+    }
+
+    inflate_into(reinterpret_cast<const unsigned char *>(in.data()),
+                 in.size(),
+                 out,
+                 maxMessageSize);
+
+    if (lastChunk)
+    {
+      inflate_into(SYNC_FLUSH_TRAILER, sizeof(SYNC_FLUSH_TRAILER), out, maxMessageSize);
+      inflatedSize_ = 0;
+
+      if (params_.clientNoContextTakeover)
+      {
+        inflateReset(&streams_->inflater);
+      }
+    }
+  }
+
+  void PerMessageDeflate::inflate_into(
+      const unsigned char *data,
+      std::size_t size,
+      std::string &out,
+      std::size_t maxMessageSize)
+  {
+    z_stream &z = streams_->inflater;
+    z.next_in = const_cast<Bytef *>(data);
+    z.avail_in = static_cast<uInt>(size);
+
+    while (true)
+    {
+      const std::size_t before = out.size();
+      out.resize(before + INFLATE_STEP);
+
+      z.next_out = reinterpret_cast<Bytef *>(out.data() + before);
+      z.avail_out = static_cast<uInt>(INFLATE_STEP);
+
+      const int rc = inflate(&z, Z_SYNC_FLUSH);
+      const std::size_t produced = INFLATE_STEP - z.avail_out;
+      out.resize(before + produced);
+      inflatedSize_ += produced;
+
+      if (inflatedSize_ > maxMessageSize)
+      {
+        throw std::runtime_error("websocket message exceeds max message size after inflate");
+      }
+
+      if (rc == Z_STREAM_END)
+      {
+        // The peer ended the deflate stream (BFINAL); the next message
+        // starts a fresh one.
+        inflateReset(&z);
+        if (z.avail_in == 0)
+        {
+          return;
+        }
+        continue;
+      }
+
+      if (rc == Z_BUF_ERROR || (rc == Z_OK && z.avail_in == 0 && z.avail_out != 0))
+      {
+        return;
+      }
+
+      if (rc != Z_OK)
+      {
+        throw std::runtime_error("permessage-deflate: corrupt compressed data");
+      }
+    }
+  }
+
+} // namespace vix::websocket::detail
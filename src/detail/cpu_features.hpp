@@ -0,0 +1,130 @@
+/**
+ *
+ *  @file cpu_features.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_WEBSOCKET_DETAIL_CPU_FEATURES_HPP
+#define VIX_WEBSOCKET_DETAIL_CPU_FEATURES_HPP
+
+// Internal to the kernel translation units (mask, utf8, handshake).
+
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VIX_WS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/** @brief Compile one function for an instruction set the build does not assume. */
+#if defined(__GNUC__) || defined(__clang__)
+#define VIX_WS_TARGET(x) __attribute__((target(x)))
+#else
+#define VIX_WS_TARGET(x)
+#endif
+
+namespace vix::websocket::detail
+{
+  /**
+   * @brief x86 extensions the SIMD kernels dispatch on.
+   *
+   * All false on other architectures.
+   */
+  struct CpuFeatures
+  {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+
+    /** @brief AVX2 with YMM state enabled by the OS. */
+    bool avx2 = false;
+
+    /** @brief SHA extensions (SHA-NI). */
+    bool sha = false;
+  };
+
+#if defined(VIX_WS_X86)
+  /** @brief eax, ebx, ecx, edx of CPUID @p leaf; zero if the leaf is missing. */
+  inline std::array<std::uint32_t, 4> cpuid(std::uint32_t leaf, std::uint32_t subleaf = 0) noexcept
+  {
+    std::array<std::uint32_t, 4> r{};
+#if defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, static_cast<int>(leaf & 0x80000000u));
+    if (static_cast<std::uint32_t>(info[0]) < leaf)
+    {
+      return r;
+    }
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+    {
+      r[i] = static_cast<std::uint32_t>(info[i]);
+    }
+#else
+    if (__get_cpuid_max(leaf & 0x80000000u, nullptr) < leaf)
+    {
+      return r;
+    }
+    __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+    return r;
+  }
+
+  /** @brief XCR0: state components the OS saves on context switch. */
+  inline std::uint64_t xgetbv0() noexcept
+  {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    std::uint32_t eax = 0;
+    std::uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+  }
+#endif
+
+  /** @brief Probe the CPU; prefer cpu_features(), which caches the result. */
+  inline CpuFeatures detect_cpu_features() noexcept
+  {
+    CpuFeatures f;
+#if defined(VIX_WS_X86)
+    const auto leaf1 = cpuid(1);
+    f.sse2 = (leaf1[3] & (1u << 26)) != 0;
+    f.ssse3 = (leaf1[2] & (1u << 9)) != 0;
+    f.sse41 = (leaf1[2] & (1u << 19)) != 0;
+
+    const bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+    const bool avx = (leaf1[2] & (1u << 28)) != 0;
+    const bool ymmSaved = osxsave && (xgetbv0() & 0x6) == 0x6;
+
+    const auto leaf7 = cpuid(7, 0);
+    f.avx2 = avx && ymmSaved && (leaf7[1] & (1u << 5)) != 0;
+    f.sha = (leaf7[1] & (1u << 29)) != 0;
+#endif
+    return f;
+  }
+
+  /** @brief Features of the running CPU, probed once per process. */
+  inline const CpuFeatures &cpu_features() noexcept
+  {
+    static const CpuFeatures features = detect_cpu_features();
+    return features;
+  }
+
+} // namespace vix::websocket::detail
+
+#endif // VIX_WEBSOCKET_DETAIL_CPU_FEATURES_HPP
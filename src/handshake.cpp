@@ -0,0 +1,542 @@
+/**
+ *
+ *  @file handshake.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/handshake.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "detail/cpu_features.hpp"
+
+// The ARMv8 SHA1 instructions are optional; only build the kernel when the
+// compiler targets them.
+#if (defined(__aarch64__) || defined(_M_ARM64)) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define VIX_WS_SHA_ARM 1
+#include <arm_neon.h>
+#endif
+
+namespace vix::websocket::detail
+{
+  namespace
+  {
+    using sha1_blocks_fn = void (*)(
+        std::uint32_t *state,
+        const unsigned char *blocks,
+        std::size_t count) noexcept;
+
+    constexpr std::uint32_t SHA1_INIT[5] = {
+        0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u};
+
+    constexpr char GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    constexpr std::size_t GUID_SIZE = sizeof(GUID) - 1;
+
+    /** Length of a conforming Sec-WebSocket-Key (base64 of 16 bytes). */
+    constexpr std::size_t CLIENT_KEY_SIZE = 24;
+
+    constexpr char BASE64_TABLE[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    inline std::uint32_t rol32(std::uint32_t v, int bits) noexcept
+    {
+      return (v << bits) | (v >> (32 - bits));
+    }
+
+    inline std::uint32_t load_be32(const unsigned char *p) noexcept
+    {
+      return (static_cast<std::uint32_t>(p[0]) << 24) |
+             (static_cast<std::uint32_t>(p[1]) << 16) |
+             (static_cast<std::uint32_t>(p[2]) << 8) |
+             static_cast<std::uint32_t>(p[3]);
+    }
+
+    inline void store_be32(unsigned char *p, std::uint32_t v) noexcept
+    {
+      p[0] = static_cast<unsigned char>(v >> 24);
+      p[1] = static_cast<unsigned char>(v >> 16);
+      p[2] = static_cast<unsigned char>(v >> 8);
+      p[3] = static_cast<unsigned char>(v);
+    }
+
+    void sha1_scalar(std::uint32_t *state, const unsigned char *blocks, std::size_t count) noexcept
+    {
+      for (; count != 0; --count, blocks += 64)
+      {
+        // The schedule only ever needs the last 16 words.
+        std::uint32_t w[16];
+        for (int i = 0; i < 16; ++i)
+        {
+          w[i] = load_be32(blocks + i * 4);
+        }
+
+        std::uint32_t a = state[0];
+        std::uint32_t b = state[1];
+        std::uint32_t c = state[2];
+        std::uint32_t d = state[3];
+        std::uint32_t e = state[4];
+
+        const auto next_word = [&w](int i) noexcept
+        {
+          if (i < 16)
+          {
+            return w[i];
+          }
+
+          const std::uint32_t v = rol32(
+              w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15], 1);
+          w[i & 15] = v;
+          return v;
+        };
+
+        const auto step = [&](std::uint32_t f, std::uint32_t k, std::uint32_t word) noexcept
+        {
+          const std::uint32_t t = rol32(a, 5) + f + e + k + word;
+          e = d;
+          d = c;
+          c = rol32(b, 30);
+          b = a;
+          a = t;
+        };
+
+        for (int i = 0; i < 20; ++i)
+        {
+          step(d ^ (b & (c ^ d)), 0x5A827999u, next_word(i));
+        }
+        for (int i = 20; i < 40; ++i)
+        {
+          step(b ^ c ^ d, 0x6ED9EBA1u, next_word(i));
+        }
+        for (int i = 40; i < 60; ++i)
+        {
+          step((b & c) | (d & (b | c)), 0x8F1BBCDCu, next_word(i));
+        }
+        for (int i = 60; i < 80; ++i)
+        {
+          step(b ^ c ^ d, 0xCA62C1D6u, next_word(i));
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+      }
+    }
+
+#if defined(VIX_WS_X86)
+    /**
+     * Four rounds of group G (rounds 4G..4G+3) with SHA-NI.
+     *
+     * msg[] is a rolling window of the message schedule: each group
+     * finishes the words that group G+1 consumes (sha1msg2), mixes those of
+     * G+2 (xor) and starts those of G+3 (sha1msg1).
+     */
+    template <int G>
+    VIX_WS_TARGET("sha,ssse3,sse4.1")
+    inline void sha_ni_group(
+        __m128i &abcd,
+        __m128i (&e)[2],
+        __m128i (&msg)[4],
+        const unsigned char *block,
+        __m128i byteSwap) noexcept
+    {
+      constexpr int cur = G & 1;
+      __m128i &m = msg[G & 3];
+
+      if constexpr (G < 4)
+      {
+        m = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + G * 16)),
+            byteSwap);
+      }
+
+      if constexpr (G == 0)
+      {
+        e[0] = _mm_add_epi32(e[0], m);
+      }
+      else
+      {
+        e[cur] = _mm_sha1nexte_epu32(e[cur], m);
+      }
+
+      e[cur ^ 1] = abcd;
+
+      if constexpr (G >= 3 && G <= 18)
+      {
+        msg[(G + 1) & 3] = _mm_sha1msg2_epu32(msg[(G + 1) & 3], m);
+      }
+
+      abcd = _mm_sha1rnds4_epu32(abcd, e[cur], G / 5);
+
+      if constexpr (G >= 1 && G <= 16)
+      {
+        msg[(G + 3) & 3] = _mm_sha1msg1_epu32(msg[(G + 3) & 3], m);
+      }
+
+      if constexpr (G >= 2 && G <= 17)
+      {
+        msg[(G + 2) & 3] = _mm_xor_si128(msg[(G + 2) & 3], m);
+      }
+
+      if constexpr (G < 19)
+      {
+        sha_ni_group<G + 1>(abcd, e, msg, block, byteSwap);
+      }
+    }
+
+    VIX_WS_TARGET("sha,ssse3,sse4.1")
+    void sha1_sha_ni(std::uint32_t *state, const unsigned char *blocks, std::size_t count) noexcept
+    {
+      const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+
+      __m128i abcd = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+      __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+      for (; count != 0; --count, blocks += 64)
+      {
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e0;
+
+        __m128i e[2] = {e0, _mm_setzero_si128()};
+        __m128i msg[4];
+        sha_ni_group<0>(abcd, e, msg, blocks, byteSwap);
+
+        e0 = _mm_sha1nexte_epu32(e[0], eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1B));
+      state[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e0, 3));
+    }
+#endif // VIX_WS_X86
+
+#if defined(VIX_WS_SHA_ARM)
+    void sha1_arm(std::uint32_t *state, const unsigned char *blocks, std::size_t count) noexcept
+    {
+      const uint32x4_t k[4] = {
+          vdupq_n_u32(0x5A827999u),
+          vdupq_n_u32(0x6ED9EBA1u),
+          vdupq_n_u32(0x8F1BBCDCu),
+          vdupq_n_u32(0xCA62C1D6u),
+      };
+
+      uint32x4_t abcd = vld1q_u32(state);
+      std::uint32_t e = state[4];
+
+      for (; count != 0; --count, blocks += 64)
+      {
+        const uint32x4_t abcdSaved = abcd;
+        const std::uint32_t eSaved = e;
+
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+        {
+          w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+        }
+
+        for (int g = 0; g < 20; ++g)
+        {
+          uint32x4_t &cur = w[g & 3];
+          if (g >= 4)
+          {
+            cur = vsha1su1q_u32(
+                vsha1su0q_u32(cur, w[(g + 1) & 3], w[(g + 2) & 3]),
+                w[(g + 3) & 3]);
+          }
+
+          const uint32x4_t wk = vaddq_u32(cur, k[g / 5]);
+          const std::uint32_t eNext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+          if (g < 5)
+          {
+            abcd = vsha1cq_u32(abcd, e, wk);
+          }
+          else if (g < 10 || g >= 15)
+          {
+            abcd = vsha1pq_u32(abcd, e, wk);
+          }
+          else
+          {
+            abcd = vsha1mq_u32(abcd, e, wk);
+          }
+
+          e = eNext;
+        }
+
+        abcd = vaddq_u32(abcd, abcdSaved);
+        e += eSaved;
+      }
+
+      vst1q_u32(state, abcd);
+      state[4] = e;
+    }
+#endif // VIX_WS_SHA_ARM
+
+    sha1_blocks_fn kernel_fn(Sha1Kernel kernel) noexcept
+    {
+      switch (kernel)
+      {
+      case Sha1Kernel::Scalar:
+        return &sha1_scalar;
+#if defined(VIX_WS_X86)
+      case Sha1Kernel::ShaNi:
+        return &sha1_sha_ni;
+#endif
+#if defined(VIX_WS_SHA_ARM)
+      case Sha1Kernel::ArmSha:
+        return &sha1_arm;
+#endif
+      default:
+        return &sha1_scalar;
+      }
+    }
+
+    Sha1Kernel detect_sha1_kernel() noexcept
+    {
+      if (sha1_kernel_supported(Sha1Kernel::ShaNi))
+      {
+        return Sha1Kernel::ShaNi;
+      }
+
+      if (sha1_kernel_supported(Sha1Kernel::ArmSha))
+      {
+        return Sha1Kernel::ArmSha;
+      }
+
+      return Sha1Kernel::Scalar;
+    }
+
+    sha1_blocks_fn active_sha1_fn() noexcept
+    {
+      static const sha1_blocks_fn fn = kernel_fn(active_sha1_kernel());
+      return fn;
+    }
+
+    Sha1Digest finish_digest(const std::uint32_t *state) noexcept
+    {
+      Sha1Digest out{};
+      for (std::size_t i = 0; i < 5; ++i)
+      {
+        store_be32(out.data() + i * 4, state[i]);
+      }
+      return out;
+    }
+
+    /** Incremental SHA-1 over a fixed stack buffer. */
+    class Sha1Stream
+    {
+    public:
+      explicit Sha1Stream(sha1_blocks_fn fn) noexcept
+          : fn_(fn)
+      {
+        std::memcpy(state_, SHA1_INIT, sizeof(state_));
+      }
+
+      void update(const unsigned char *data, std::size_t len) noexcept
+      {
+        total_ += len;
+
+        if (buffered_ != 0)
+        {
+          const std::size_t take = std::min(len, 64 - buffered_);
+          std::memcpy(buffer_ + buffered_, data, take);
+          buffered_ += take;
+          data += take;
+          len -= take;
+
+          if (buffered_ < 64)
+          {
+            return;
+          }
+
+          fn_(state_, buffer_, 1);
+          buffered_ = 0;
+        }
+
+        const std::size_t full = len / 64;
+        if (full != 0)
+        {
+          fn_(state_, data, full);
+        }
+
+        buffered_ = len - full * 64;
+        if (buffered_ != 0)
+        {
+          std::memcpy(buffer_, data + full * 64, buffered_);
+        }
+      }
+
+      Sha1Digest finish() noexcept
+      {
+        // Tail, 0x80 terminator and the 64-bit length fit in one or two blocks.
+        unsigned char tail[128]{};
+        std::memcpy(tail, buffer_, buffered_);
+        tail[buffered_] = 0x80u;
+
+        const std::size_t tailSize = buffered_ < 56 ? 64 : 128;
+        const std::uint64_t bits = static_cast<std::uint64_t>(total_) * 8u;
+        store_be32(tail + tailSize - 8, static_cast<std::uint32_t>(bits >> 32));
+        store_be32(tail + tailSize - 4, static_cast<std::uint32_t>(bits));
+
+        fn_(state_, tail, tailSize / 64);
+        return finish_digest(state_);
+      }
+
+    private:
+      sha1_blocks_fn fn_;
+      std::uint32_t state_[5];
+      unsigned char buffer_[64];
+      std::size_t buffered_{0};
+      std::uint64_t total_{0};
+    };
+
+    Sha1Digest sha1_run(sha1_blocks_fn fn, const unsigned char *data, std::size_t len) noexcept
+    {
+      Sha1Stream stream(fn);
+      stream.update(data, len);
+      return stream.finish();
+    }
+  } // namespace
+
+  const char *sha1_kernel_name(Sha1Kernel kernel) noexcept
+  {
+    switch (kernel)
+    {
+    case Sha1Kernel::Scalar:
+      return "scalar";
+    case Sha1Kernel::ShaNi:
+      return "sha-ni";
+    case Sha1Kernel::ArmSha:
+      return "arm-sha";
+    }
+
+    return "unknown";
+  }
+
+  bool sha1_kernel_supported(Sha1Kernel kernel) noexcept
+  {
+    switch (kernel)
+    {
+    case Sha1Kernel::Scalar:
+      return true;
+#if defined(VIX_WS_X86)
+    case Sha1Kernel::ShaNi:
+    {
+      const CpuFeatures &cpu = cpu_features();
+      return cpu.sha && cpu.ssse3 && cpu.sse41;
+    }
+#endif
+#if defined(VIX_WS_SHA_ARM)
+    case Sha1Kernel::ArmSha:
+      return true;
+#endif
+    default:
+      return false;
+    }
+  }
+
+  Sha1Kernel active_sha1_kernel() noexcept
+  {
+    static const Sha1Kernel kernel = detect_sha1_kernel();
+    return kernel;
+  }
+
+  Sha1Digest sha1_digest(const unsigned char *data, std::size_t len) noexcept
+  {
+    return sha1_run(active_sha1_fn(), data, len);
+  }
+
+  Sha1Digest sha1_digest_with(
+      Sha1Kernel kernel,
+      const unsigned char *data,
+      std::size_t len) noexcept
+  {
+    if (!sha1_kernel_supported(kernel))
+    {
+      kernel = Sha1Kernel::Scalar;
+    }
+
+    return sha1_run(kernel_fn(kernel), data, len);
+  }
+
+  void base64_encode_to(const unsigned char *data, std::size_t len, char *out) noexcept
+  {
+    std::size_t i = 0;
+    for (; i + 3 <= len; i += 3, out += 4)
+    {
+      const std::uint32_t n =
+          (static_cast<std::uint32_t>(data[i]) << 16) |
+          (static_cast<std::uint32_t>(data[i + 1]) << 8) |
+          static_cast<std::uint32_t>(data[i + 2]);
+
+      out[0] = BASE64_TABLE[(n >> 18) & 0x3F];
+      out[1] = BASE64_TABLE[(n >> 12) & 0x3F];
+      out[2] = BASE64_TABLE[(n >> 6) & 0x3F];
+      out[3] = BASE64_TABLE[n & 0x3F];
+    }
+
+    const std::size_t rem = len - i;
+    if (rem == 0)
+    {
+      return;
+    }
+
+    std::uint32_t n = static_cast<std::uint32_t>(data[i]) << 16;
+    if (rem == 2)
+    {
+      n |= static_cast<std::uint32_t>(data[i + 1]) << 8;
+    }
+
+    out[0] = BASE64_TABLE[(n >> 18) & 0x3F];
+    out[1] = BASE64_TABLE[(n >> 12) & 0x3F];
+    out[2] = rem == 2 ? BASE64_TABLE[(n >> 6) & 0x3F] : '=';
+    out[3] = '=';
+  }
+
+  AcceptKey websocket_accept_key(std::string_view clientKey) noexcept
+  {
+    Sha1Digest digest;
+
+    if (clientKey.size() == CLIENT_KEY_SIZE)
+    {
+      // 24 + 36 = 60 bytes: the padded message is exactly two blocks and
+      // its length field is a constant.
+      static_assert(CLIENT_KEY_SIZE + GUID_SIZE == 60);
+
+      unsigned char blocks[128]{};
+      std::memcpy(blocks, clientKey.data(), CLIENT_KEY_SIZE);
+      std::memcpy(blocks + CLIENT_KEY_SIZE, GUID, GUID_SIZE);
+      blocks[60] = 0x80u;
+      store_be32(blocks + 124, 60u * 8u);
+
+      std::uint32_t state[5];
+      std::memcpy(state, SHA1_INIT, sizeof(state));
+      active_sha1_fn()(state, blocks, 2);
+      digest = finish_digest(state);
+    }
+    else
+    {
+      // Non-conforming key length: hash key and GUID as a stream.
+      Sha1Stream stream(active_sha1_fn());
+      stream.update(reinterpret_cast<const unsigned char *>(clientKey.data()), clientKey.size());
+      stream.update(reinterpret_cast<const unsigned char *>(GUID), GUID_SIZE);
+      digest = stream.finish();
+    }
+
+    AcceptKey out{};
+    base64_encode_to(digest.data(), digest.size(), out.data());
+    return out;
+  }
+
+} // namespace vix::websocket::detail
@@ -20,12 +20,12 @@
 #include <cstring>
 #include <cerrno>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -56,6 +56,16 @@ namespace vix::websocket
       return Logger::getInstance();
     }
 
+    /** @brief Raise a max-gauge to @p value if it is higher. */
+    inline void raise_to(std::atomic<std::uint64_t> &gauge, std::uint64_t value)
+    {
+      std::uint64_t current = gauge.load(std::memory_order_relaxed);
+      while (current < value &&
+             !gauge.compare_exchange_weak(current, value, std::memory_order_relaxed))
+      {
+      }
+    }
+
     inline std::string to_lower_copy(std::string s)
     {
       std::transform(
@@ -211,108 +221,11 @@ namespace vix::websocket
       return trim_copy(message);
     }
 
-    inline bool starts_with_icase(std::string_view s, std::string_view prefix)
-    {
-      if (prefix.size() > s.size())
-      {
-        return false;
-      }
-
-      for (std::size_t i = 0; i < prefix.size(); ++i)
-      {
-        const auto a = static_cast<unsigned char>(s[i]);
-        const auto b = static_cast<unsigned char>(prefix[i]);
-
-        if (std::tolower(a) != std::tolower(b))
-        {
-          return false;
-        }
-      }
-
-      return true;
-    }
-
-    inline std::string get_header_value(
-        const std::string &raw_http,
-        const std::string &header_name)
-    {
-      const std::string needle = to_lower_copy(header_name) + ":";
-
-      std::size_t pos = 0;
-      while (pos < raw_http.size())
-      {
-        const std::size_t line_end = raw_http.find("\r\n", pos);
-        const std::size_t end =
-            (line_end == std::string::npos) ? raw_http.size() : line_end;
-
-        std::string line = raw_http.substr(pos, end - pos);
-        std::string lower = to_lower_copy(line);
-
-        if (lower.rfind(needle, 0) == 0)
-        {
-          return trim_copy(line.substr(needle.size()));
-        }
-
-        if (line_end == std::string::npos)
-        {
-          break;
-        }
-
-        pos = line_end + 2;
-      }
-
-      return {};
-    }
-
-    inline bool header_contains_token(
-        const std::string &raw_http,
-        const std::string &header_name,
-        const std::string &token)
-    {
-      const std::string value =
-          to_lower_copy(get_header_value(raw_http, header_name));
-      const std::string wanted = to_lower_copy(token);
-
-      if (value.empty())
-      {
-        return false;
-      }
-
-      std::size_t start = 0;
-      while (start < value.size())
-      {
-        const std::size_t comma = value.find(',', start);
-        std::string part =
-            (comma == std::string::npos)
-                ? value.substr(start)
-                : value.substr(start, comma - start);
-
-        part = trim_copy(part);
-        if (part == wanted)
-        {
-          return true;
-        }
-
-        if (comma == std::string::npos)
-        {
-          break;
-        }
-
-        start = comma + 1;
-      }
-
-      return false;
-    }
-
-    inline std::size_t find_http_head_end(const std::string &s)
+    const detail::SharedFrame &shared_ping_frame()
     {
-      const auto pos = s.find("\r\n\r\n");
-      if (pos == std::string::npos)
-      {
-        return std::string::npos;
-      }
-
-      return pos + 4;
+      static const detail::SharedFrame frame =
+          detail::make_shared_frame(detail::Opcode::Ping, std::span<const std::byte>{});
+      return frame;
     }
   } // namespace
 
@@ -321,12 +234,20 @@ namespace vix::websocket
       const Config &cfg,
       std::shared_ptr<Router> router,
       std::shared_ptr<vix::executor::RuntimeExecutor> executor,
-      std::shared_ptr<io_context> ioc)
+      std::shared_ptr<io_context> ioc,
+      std::shared_ptr<WebSocketMetrics> metrics,
+      std::shared_ptr<detail::TimerWheel> timers,
+      std::size_t coreIndex)
       : stream_(std::move(stream)),
         cfg_(cfg),
         router_(std::move(router)),
         executor_(std::move(executor)),
-        ioc_(std::move(ioc))
+        ioc_(std::move(ioc)),
+        assembler_(cfg_.maxMessageSize),
+        metrics_(std::move(metrics)),
+        timers_(std::move(timers)),
+        coreIndex_(coreIndex),
+        writeQueue_(cfg_.backpressure)
   {
     if (!ioc_)
     {
@@ -337,6 +258,7 @@ namespace vix::websocket
   task<void> Session::run()
   {
     bool must_close = false;
+    std::optional<detail::CloseCode> closeCode;
 
     try
     {
@@ -350,6 +272,12 @@ namespace vix::websocket
       maybe_start_heartbeat();
       co_await do_read_loop();
     }
+    catch (const detail::CloseError &e)
+    {
+      emit_error(e.what());
+      closeCode = e.code();
+      must_close = true;
+    }
     catch (const std::exception &e)
     {
       emit_error(e.what());
@@ -361,35 +289,134 @@ namespace vix::websocket
       open_ = false;
       stop_heartbeat();
 
+      bool closeQueued = false;
+      if (closeCode)
+      {
+        // Sealing under the same lock as closing_ keeps a concurrent flush
+        // from discarding the frames queued before the close frame.
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        closeQueued = !closing_.exchange(true) && queue_close_frame(*closeCode);
+      }
+
+      if (closeQueued)
+      {
+        cancel_idle_timer();
+        arm_close_timer();
+        trigger_write_flush();
+      }
+
       if (router_)
       {
         notify_close_once(*this, router_, closeNotified_);
       }
 
-      co_await close_stream_only();
+      // With a close frame queued the flush loop closes the stream after it.
+      if (!closeQueued)
+      {
+        co_await close_stream_only();
+      }
     }
 
     co_return;
   }
 
-  void Session::send_text(std::string_view text)
+  void Session::send_text(std::string_view text, std::string_view key)
+  {
+    if (closing_)
+    {
+      return;
+    }
+
+    do_enqueue_message(PendingMessage{false, std::string{text}, {}, std::string{key}});
+  }
+
+  void Session::send_frame(detail::SharedFrame frame, std::string_view key)
+  {
+    if (closing_ || !frame)
+    {
+      return;
+    }
+
+    const bool isBinary = frame.opcode == detail::Opcode::Binary;
+    do_enqueue_message(PendingMessage{isBinary, {}, std::move(frame), std::string{key}});
+  }
+
+  void Session::send_text(std::string_view text, SendPriority priority)
+  {
+    if (closing_)
+    {
+      return;
+    }
+
+    do_enqueue_message(
+        PendingMessage{false, std::string{text}, {}, {}},
+        false,
+        detail::lane_of(priority));
+  }
+
+  void Session::send_frame(detail::SharedFrame frame, SendPriority priority)
+  {
+    if (closing_ || !frame)
+    {
+      return;
+    }
+
+    const bool isBinary = frame.opcode == detail::Opcode::Binary;
+    do_enqueue_message(
+        PendingMessage{isBinary, {}, std::move(frame), {}},
+        false,
+        detail::lane_of(priority));
+  }
+
+  void Session::send_text(
+      std::string_view text,
+      SendCallback onSent,
+      SendPriority priority)
+  {
+    do_enqueue_message(
+        PendingMessage{false, std::string{text}, {}, {}, make_completion(std::move(onSent))},
+        false,
+        detail::lane_of(priority));
+  }
+
+  SendAwaitable Session::async_send_text(std::string_view text, SendPriority priority)
+  {
+    SendAwaitable done;
+    send_text(text, done.callback(), priority);
+    return done;
+  }
+
+  void Session::send_text_conflated(std::string_view key, std::string_view text)
   {
     if (closing_)
     {
       return;
     }
 
-    auto self = shared_from_this();
-    const std::string payload{text};
+    do_enqueue_message(PendingMessage{false, std::string{text}, {}, std::string{key}}, true);
+  }
 
-    ioc_->post([self, payload]()
-               {
-    if (self->closing_)
+  void Session::send_frame_conflated(std::string_view key, detail::SharedFrame frame)
+  {
+    if (closing_ || !frame)
     {
       return;
     }
 
-    self->do_enqueue_message(false, payload); });
+    const bool isBinary = frame.opcode == detail::Opcode::Binary;
+    do_enqueue_message(PendingMessage{isBinary, {}, std::move(frame), std::string{key}}, true);
+  }
+
+  void Session::set_backpressure(const BackpressureOptions &options)
+  {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    writeQueue_.set_options(options);
+  }
+
+  WriteQueueStats Session::write_queue_stats()
+  {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return writeQueue_.stats();
   }
 
   task<void> Session::flush_write_loop(std::shared_ptr<Session> self)
@@ -400,71 +427,98 @@ namespace vix::websocket
     {
       while (true)
       {
-        PendingMessage msg{};
-
         {
           std::lock_guard<std::mutex> lock(self->writeMutex_);
 
-          if (self->closing_)
+          // A sealed queue still drains up to and including its close frame.
+          if (self->closing_ && !self->writeQueue_.sealed())
           {
             self->writeQueue_.clear();
-            self->queuedWriteBytes_ = 0;
+            self->fragmented_ = {};
+            self->fragmenting_ = false;
             self->writeInProgress_ = false;
             co_return;
           }
 
-          if (self->writeQueue_.empty())
+          if (self->fragmenting_)
           {
-            self->writeInProgress_ = false;
-            co_return;
+            // No other data frame may start before the fragmented message
+            // is finished; only control frames go in between.
+            self->writeQueue_.pop_control(self->flushBatch_);
           }
-
-          msg = std::move(self->writeQueue_.front());
-          self->writeQueue_.pop_front();
-
-          if (self->queuedWriteBytes_ >= msg.data.size())
+          else if (self->writeQueue_.empty())
           {
-            self->queuedWriteBytes_ -= msg.data.size();
+            self->writeInProgress_ = false;
+            co_return;
           }
           else
           {
-            self->queuedWriteBytes_ = 0;
+            // Drain a whole batch under one lock acquisition. The first
+            // message is always taken, even if it alone exceeds the byte
+            // cap. A message that will be fragmented ends the batch.
+            const std::size_t fragmentSize = self->cfg_.writeFragmentSize;
+            self->writeQueue_.pop_batch(
+                self->flushBatch_,
+                std::max<std::size_t>(1, self->cfg_.writeBatchMaxMessages),
+                self->cfg_.writeBatchMaxBytes,
+                fragmentSize != 0 ? fragmentSize : static_cast<std::size_t>(-1));
           }
         }
 
-        std::vector<std::byte> frame;
-        if (msg.isBinary)
+        const std::size_t encoded = self->encode_write_batch();
+        co_await self->write_gather(self->flushSegments_);
+
+        // push_last() makes the close frame the last message of its batch.
+        const bool closeWritten =
+            !self->flushBatch_.empty() &&
+            self->flushBatch_.back().frame &&
+            self->flushBatch_.back().frame.opcode == detail::Opcode::Close;
+
+        std::size_t written = 0;
+        for (const auto &segment : self->flushSegments_)
         {
-          std::vector<std::byte> payload;
-          payload.reserve(msg.data.size());
+          written += segment.size();
+        }
+        const std::uint64_t total =
+            self->bytesFlushed_.fetch_add(written, std::memory_order_relaxed) + written;
 
-          for (char ch : msg.data)
-          {
-            payload.push_back(
-                static_cast<std::byte>(static_cast<unsigned char>(ch)));
-          }
+        for (PendingMessage &msg : self->flushBatch_)
+        {
+          msg.completion.finish(SendStatus::Written, total);
+        }
 
-          frame = detail::build_frame(
-              detail::Opcode::Binary,
-              payload,
-              true,
-              false);
+        if (!self->fragmenting_)
+        {
+          self->fragmented_.completion.finish(SendStatus::Written, total);
+          self->fragmented_ = {};
         }
-        else
+
+        if (self->metrics_)
         {
-          frame = detail::build_text_frame(msg.data, false);
+          auto &m = *self->metrics_;
+          m.write_batches_total.fetch_add(1, std::memory_order_relaxed);
+          m.write_batch_messages_total.fetch_add(encoded, std::memory_order_relaxed);
         }
 
-        co_await self->write_raw_frame(frame);
+        self->flushBatch_.clear();
+
+        if (closeWritten)
+        {
+          must_close = true;
+          break;
+        }
       }
     }
     catch (const std::exception &e)
     {
       {
         std::lock_guard<std::mutex> lock(self->writeMutex_);
+        self->fragmenting_ = false;
         self->writeInProgress_ = false;
       }
 
+      self->flushBatch_.clear();
+      self->fragmented_ = {};
       self->emit_error(e.what());
       must_close = true;
     }
@@ -477,14 +531,180 @@ namespace vix::websocket
     co_return;
   }
 
-  task<void> Session::close_sequence(std::shared_ptr<Session> self)
+  std::size_t Session::encode_write_batch()
   {
-    try
+    flushSegments_.clear();
+    flushHeaders_.clear();
+
+    // Segments point into flushHeaders_, so it must not reallocate below.
+    // The extra slot holds the header of a fragment.
+    flushHeaders_.reserve(flushBatch_.size() + 1);
+    if (flushCompressed_.size() < flushBatch_.size())
     {
-      co_await self->write_raw_frame(detail::build_close_frame(false));
+      flushCompressed_.resize(flushBatch_.size());
     }
-    catch (...)
+
+    std::size_t encoded = flushBatch_.size();
+
+    for (std::size_t i = 0; i < flushBatch_.size(); ++i)
+    {
+      PendingMessage &msg = flushBatch_[i];
+
+      const detail::Opcode opcode =
+          msg.isBinary ? detail::Opcode::Binary : detail::Opcode::Text;
+      const std::span<const std::byte> payload =
+          msg.frame ? msg.frame.payload() : detail::as_byte_span(msg.data);
+
+      const bool control = msg.frame && detail::is_control_opcode(msg.frame.opcode);
+
+      // pop_batch() puts a message above the fragment size last.
+      const bool mayFragment =
+          !control &&
+          !fragmenting_ &&
+          cfg_.writeFragmentSize != 0 &&
+          i + 1 == flushBatch_.size();
+
+      if (deflate_ && !control && payload.size() >= cfg_.deflateMinSize)
+      {
+        std::string &compressed = flushCompressed_[i];
+        deflate_->compress(payload, compressed);
+
+        if (metrics_)
+        {
+          metrics_->deflate_messages_total.fetch_add(1, std::memory_order_relaxed);
+          metrics_->deflate_bytes_in_total.fetch_add(payload.size(), std::memory_order_relaxed);
+          metrics_->deflate_bytes_out_total.fetch_add(compressed.size(), std::memory_order_relaxed);
+        }
+
+        if (mayFragment && compressed.size() > cfg_.writeFragmentSize)
+        {
+          fragmentedCompressed_.swap(compressed);
+          fragmentedPayload_ = detail::as_byte_span(fragmentedCompressed_);
+          fragmentedOpcode_ = opcode;
+          fragmentedRsv1_ = true;
+          fragmentedOffset_ = 0;
+          fragmented_ = std::move(msg);
+          fragmenting_ = true;
+          encoded = i;
+          break;
+        }
+
+        flushHeaders_.push_back(detail::encode_frame_header(
+            opcode,
+            compressed.size(),
+            true,
+            nullptr,
+            true));
+        flushSegments_.push_back(flushHeaders_.back().view());
+        flushSegments_.push_back(detail::as_byte_span(compressed));
+        msg.completion.add_bytes(flushHeaders_.back().view().size() + compressed.size());
+        continue;
+      }
+
+      if (mayFragment && payload.size() > cfg_.writeFragmentSize)
+      {
+        fragmented_ = std::move(msg);
+        fragmentedPayload_ = fragmented_.frame
+                                 ? fragmented_.frame.payload()
+                                 : detail::as_byte_span(fragmented_.data);
+        fragmentedOpcode_ = opcode;
+        fragmentedRsv1_ = false;
+        fragmentedOffset_ = 0;
+        fragmenting_ = true;
+        encoded = i;
+        break;
+      }
+
+      if (msg.frame)
+      {
+        // Shared broadcast frame: already encoded, written as is.
+        flushSegments_.push_back(msg.frame.wire());
+        msg.completion.add_bytes(msg.frame.wire().size());
+        continue;
+      }
+
+      flushHeaders_.push_back(detail::encode_frame_header(opcode, payload.size(), true));
+      flushSegments_.push_back(flushHeaders_.back().view());
+      flushSegments_.push_back(payload);
+      msg.completion.add_bytes(flushHeaders_.back().view().size() + payload.size());
+    }
+
+    if (fragmenting_)
+    {
+      encode_next_fragment();
+
+      // A fragmented message counts once, in the flush of its last fragment.
+      if (!fragmenting_)
+      {
+        ++encoded;
+      }
+    }
+
+    return encoded;
+  }
+
+  void Session::encode_next_fragment()
+  {
+    const std::size_t remaining = fragmentedPayload_.size() - fragmentedOffset_;
+    const std::size_t size = std::min(remaining, cfg_.writeFragmentSize);
+    const bool first = fragmentedOffset_ == 0;
+    const bool fin = size == remaining;
+
+    // RFC 7692: RSV1 marks the whole message and is set on the first frame.
+    flushHeaders_.push_back(detail::encode_frame_header(
+        first ? fragmentedOpcode_ : detail::Opcode::Continuation,
+        size,
+        fin,
+        nullptr,
+        first && fragmentedRsv1_));
+    flushSegments_.push_back(flushHeaders_.back().view());
+    flushSegments_.push_back(fragmentedPayload_.subspan(fragmentedOffset_, size));
+    fragmented_.completion.add_bytes(flushHeaders_.back().view().size() + size);
+
+    fragmentedOffset_ += size;
+    fragmenting_ = !fin;
+  }
+
+  task<void> Session::close_sequence(std::shared_ptr<Session> self, bool closeQueued)
+  {
+    notify_close_once(*self, self->router_, self->closeNotified_);
+
+    if (closeQueued)
+    {
+      self->trigger_write_flush();
+    }
+    else
+    {
+      co_await self->close_stream_only();
+    }
+    co_return;
+  }
+
+  task<void> Session::abort_sequence(std::shared_ptr<Session> self)
+  {
+    bool writeClose = false;
+    {
+      std::lock_guard<std::mutex> lock(self->writeMutex_);
+      self->writeQueue_.clear();
+
+      // A frame already on the wire cannot be cut short by the close frame;
+      // the stream is closed without one in that case.
+      if (!self->writeInProgress_)
+      {
+        self->writeInProgress_ = true;
+        writeClose = true;
+      }
+    }
+
+    if (writeClose && self->stream_ && self->stream_->is_open())
     {
+      try
+      {
+        co_await self->write_raw_frame(detail::build_close_frame(false));
+      }
+      catch (...)
+      {
+      }
     }
 
     notify_close_once(*self, self->router_, self->closeNotified_);
@@ -492,7 +712,15 @@ namespace vix::websocket
     co_return;
   }
 
-  void Session::send_binary(const void *data, std::size_t size)
+  task<void> Session::close_deadline_sequence(std::shared_ptr<Session> self)
+  {
+    log().log(Logger::Level::Debug, "[ws] close timeout, closing stream");
+
+    notify_close_once(*self, self->router_, self->closeNotified_);
+    co_await self->close_stream_only();
+  }
+
+  void Session::send_binary(const void *data, std::size_t size, std::string_view key)
   {
     if (closing_)
     {
@@ -506,18 +734,106 @@ namespace vix::websocket
       payload.assign(ptr, ptr + size);
     }
 
-    auto self = shared_from_this();
-    ioc_->post([self, payload = std::move(payload)]() mutable
-               {
-    if (self->closing_)
+    do_enqueue_message(PendingMessage{true, std::move(payload), {}, std::string{key}});
+  }
+
+  void Session::send_binary(const void *data, std::size_t size, SendPriority priority)
+  {
+    if (closing_)
     {
       return;
     }
 
-    self->do_enqueue_message(true, std::move(payload)); });
+    std::string payload;
+    if (data != nullptr && size != 0)
+    {
+      const auto *ptr = static_cast<const char *>(data);
+      payload.assign(ptr, ptr + size);
+    }
+
+    do_enqueue_message(
+        PendingMessage{true, std::move(payload), {}, {}},
+        false,
+        detail::lane_of(priority));
+  }
+
+  void Session::send_binary(
+      const void *data,
+      std::size_t size,
+      SendCallback onSent,
+      SendPriority priority)
+  {
+    std::string payload;
+    if (data != nullptr && size != 0)
+    {
+      const auto *ptr = static_cast<const char *>(data);
+      payload.assign(ptr, ptr + size);
+    }
+
+    do_enqueue_message(
+        PendingMessage{true, std::move(payload), {}, {}, make_completion(std::move(onSent))},
+        false,
+        detail::lane_of(priority));
+  }
+
+  SendAwaitable Session::async_send_binary(
+      const void *data,
+      std::size_t size,
+      SendPriority priority)
+  {
+    SendAwaitable done;
+    send_binary(data, size, done.callback(), priority);
+    return done;
   }
 
   task<void> Session::write_raw_frame(const std::vector<std::byte> &frame)
+  {
+    co_await write_all(std::span<const std::byte>(frame.data(), frame.size()));
+  }
+
+  task<void> Session::write_raw_frame(
+      std::span<const std::byte> header,
+      std::span<const std::byte> payload)
+  {
+    const std::array<std::span<const std::byte>, 2> segments{header, payload};
+    co_await write_gather(segments);
+  }
+
+  task<void> Session::write_gather(std::span<const std::span<const std::byte>> segments)
+  {
+    // The stream has no gather write. Small segments are coalesced into one
+    // reusable buffer so a batch still costs a single write; large payloads
+    // go out straight from their own storage.
+    writeScratch_.clear();
+
+    for (const auto &segment : segments)
+    {
+      if (segment.size() > WRITE_COALESCE_LIMIT)
+      {
+        if (!writeScratch_.empty())
+        {
+          co_await write_all(
+              std::span<const std::byte>(writeScratch_.data(), writeScratch_.size()));
+          writeScratch_.clear();
+        }
+
+        co_await write_all(segment);
+        continue;
+      }
+
+      writeScratch_.insert(writeScratch_.end(), segment.begin(), segment.end());
+    }
+
+    if (!writeScratch_.empty())
+    {
+      co_await write_all(
+          std::span<const std::byte>(writeScratch_.data(), writeScratch_.size()));
+    }
+
+    co_return;
+  }
+
+  task<void> Session::write_all(std::span<const std::byte> bytes)
   {
     if (!stream_ || !stream_->is_open())
     {
@@ -525,12 +841,10 @@ namespace vix::websocket
     }
 
     std::size_t written = 0;
-    while (written < frame.size())
+    while (written < bytes.size())
     {
       const std::size_t n = co_await stream_->async_write(
-          std::span<const std::byte>(
-              frame.data() + written,
-              frame.size() - written),
+          bytes.subspan(written),
           writeCancel_.token());
 
       if (n == 0)
@@ -546,71 +860,111 @@ namespace vix::websocket
 
   void Session::close(std::string)
   {
-    bool expected = false;
-    if (!closing_.compare_exchange_strong(expected, true))
+    bool closeQueued = false;
     {
-      return;
+      // closing_ and the close frame change together, so a flush never
+      // sees a closing session whose queue is not sealed yet.
+      std::lock_guard<std::mutex> lock(writeMutex_);
+      if (closing_.exchange(true))
+      {
+        return;
+      }
+
+      closeQueued = queue_close_frame(std::nullopt);
     }
 
     cancel_idle_timer();
     stop_heartbeat();
 
-    if (ioc_)
+    if (closeQueued)
+    {
+      arm_close_timer();
+    }
+
+    if (ioc_)
     {
       spawn_detached(
           *ioc_,
-          Session::close_sequence(shared_from_this()));
+          Session::close_sequence(shared_from_this(), closeQueued));
     }
   }
 
-  task<void> Session::do_accept()
+  void Session::close_now()
   {
-    const std::string raw_head = co_await read_http_head();
+    if (closing_.exchange(true))
+    {
+      return;
+    }
 
-    if (raw_head.empty())
+    cancel_idle_timer();
+    stop_heartbeat();
+
+    // Bounds the close frame write as well; the peer may not be reading.
+    arm_close_timer();
+
+    if (ioc_)
     {
-      throw std::runtime_error("empty websocket handshake request");
+      spawn_detached(*ioc_, Session::abort_sequence(shared_from_this()));
     }
+  }
 
-    const std::size_t first_line_end = raw_head.find("\r\n");
-    const std::string request_line =
-        first_line_end == std::string::npos
-            ? raw_head
-            : raw_head.substr(0, first_line_end);
+  task<void> Session::do_accept()
+  {
+    const detail::UpgradeRequest request = co_await read_http_head();
 
-    if (!starts_with_icase(request_line, "GET "))
+    if (!detail::iequals_ascii(request.method, "GET"))
     {
       throw std::runtime_error("websocket handshake must use GET");
     }
 
-    const std::string upgrade =
-        to_lower_copy(get_header_value(raw_head, "Upgrade"));
-    if (upgrade != "websocket")
+    if (!detail::iequals_ascii(request.upgrade, "websocket"))
     {
       throw std::runtime_error("missing Upgrade: websocket");
     }
 
-    if (!header_contains_token(raw_head, "Connection", "Upgrade"))
+    if (!request.connectionUpgrade)
     {
       throw std::runtime_error("missing Connection: Upgrade");
     }
 
-    const std::string ws_key =
-        trim_copy(get_header_value(raw_head, "Sec-WebSocket-Key"));
-    if (ws_key.empty())
+    if (request.key.empty())
     {
       throw std::runtime_error("missing Sec-WebSocket-Key");
     }
 
-    const std::string version =
-        trim_copy(get_header_value(raw_head, "Sec-WebSocket-Version"));
-    if (!version.empty() && version != "13")
+    if (!request.version.empty() && request.version != "13")
     {
       throw std::runtime_error("unsupported Sec-WebSocket-Version");
     }
 
-    const std::string accept_key = detail::websocket_accept_from_key(ws_key);
-    co_await send_upgrade_response(accept_key);
+    std::string extensions;
+    if (cfg_.enablePerMessageDeflate)
+    {
+      detail::DeflateParams policy;
+      policy.serverNoContextTakeover = cfg_.deflateServerNoContextTakeover;
+      policy.serverMaxWindowBits = cfg_.deflateServerMaxWindowBits;
+
+      // Offers may be split over several header lines.
+      std::string offers;
+      auto negotiated = detail::negotiate_permessage_deflate(
+          request.extensions.joined(offers),
+          policy);
+
+      if (negotiated)
+      {
+        deflate_ = std::make_unique<detail::PerMessageDeflate>(negotiated->params);
+        extensions = std::move(negotiated->responseHeader);
+      }
+    }
+
+    const detail::AcceptKey accept_key = detail::websocket_accept_key(request.key);
+
+    // The request views point into the read buffer; release the head only
+    // once they are no longer needed.
+    readBuffer_.consume(request.headSize);
+    co_await send_upgrade_response(
+        std::string_view(accept_key.data(), accept_key.size()),
+        extensions);
 
     open_ = true;
     closing_ = false;
@@ -626,42 +980,52 @@ namespace vix::websocket
 
   task<void> Session::do_read_loop()
   {
+    const bool streaming = router_ && router_->has_message_chunk_handler();
+
     while (!closing_ &&
            stream_ &&
            stream_->is_open())
     {
-      detail::Frame frame = co_await read_frame();
-      cancel_idle_timer();
+      const detail::FrameHeader h = co_await read_frame_header();
+      note_activity();
 
-      switch (frame.opcode)
+      if (streaming && !detail::is_control_opcode(h.opcode))
       {
-      case detail::Opcode::Text:
-        if (router_)
+        const detail::Opcode opcode =
+            assembler_.begin_frame(h.opcode, h.fin, h.payload_length);
+
+        if (h.opcode != detail::Opcode::Continuation)
         {
-          router_->handle_message(*this, frame.text());
+          inboundCompressed_ = h.rsv1;
+          utf8_.reset();
         }
-        arm_idle_timer();
-        break;
 
+        co_await stream_frame_payload(h, opcode == detail::Opcode::Binary);
+        continue;
+      }
+
+      const detail::FrameView frame = co_await read_frame(h);
+
+      switch (frame.opcode)
+      {
+      case detail::Opcode::Text:
       case detail::Opcode::Binary:
-        if (router_)
-        {
-          router_->handle_message(*this, frame.text());
-        }
-        arm_idle_timer();
+      case detail::Opcode::Continuation:
+        on_data_frame(frame);
         break;
 
       case detail::Opcode::Ping:
         if (cfg_.autoPingPong)
         {
-          co_await write_raw_frame(
-              detail::build_pong_frame(frame.payload, false));
+          // Queued so the pong cannot land inside a frame being flushed.
+          do_enqueue_message(
+              PendingMessage{false, {}, detail::make_shared_frame(detail::Opcode::Pong, frame.payload)},
+              false,
+              detail::WriteLane::Control);
         }
-        arm_idle_timer();
         break;
 
       case detail::Opcode::Pong:
-        arm_idle_timer();
         break;
 
       case detail::Opcode::Close:
@@ -677,9 +1041,7 @@ namespace vix::websocket
         co_await close_stream_only();
         co_return;
 
-      case detail::Opcode::Continuation:
       default:
-        arm_idle_timer();
         break;
       }
     }
@@ -692,118 +1054,474 @@ namespace vix::websocket
       notify_close_once(*this, router_, closeNotified_);
     }
 
-    co_await close_stream_only();
+    bool closeQueued = false;
+    {
+      std::lock_guard<std::mutex> lock(writeMutex_);
+      closeQueued = writeQueue_.sealed();
+    }
+
+    // close() queued a close frame; the flush loop closes the stream after it.
+    if (!closeQueued)
+    {
+      co_await close_stream_only();
+    }
     co_return;
   }
 
-  task<detail::Frame> Session::read_frame()
+  void Session::on_data_frame(const detail::FrameView &frame)
+  {
+    assembler_.begin_frame(frame.opcode, frame.fin, frame.payload.size());
+
+    if (frame.opcode != detail::Opcode::Continuation)
+    {
+      inboundCompressed_ = frame.rsv1;
+      utf8_.reset();
+    }
+
+    const bool isText = assembler_.opcode() == detail::Opcode::Text;
+
+    if (frame.fin && frame.opcode != detail::Opcode::Continuation)
+    {
+      if (!isText && router_ && router_->has_binary_message_handler())
+      {
+        // Unfragmented binary message: hand out a view of the read buffer.
+        if (inboundCompressed_)
+        {
+          const std::string message = inflate_message(frame.payload);
+          router_->handle_binary_message(*this, detail::as_byte_span(message));
+        }
+        else
+        {
+          router_->handle_binary_message(*this, frame.payload);
+        }
+        return;
+      }
+
+      // Unfragmented message: deliver straight from the read buffer.
+      std::string message = inboundCompressed_ ? inflate_message(frame.payload) : frame.text();
+
+      if (isText && !detail::is_valid_utf8(message))
+      {
+        throw_invalid_utf8();
+      }
+
+      if (router_)
+      {
+        router_->handle_message(*this, std::move(message));
+      }
+      return;
+    }
+
+    // Uncompressed fragments are checked as they arrive so a bad message
+    // fails before the rest of it is buffered.
+    if (isText && !inboundCompressed_)
+    {
+      check_text_chunk(frame.text_view(), frame.fin);
+    }
+
+    assembler_.append(frame.payload);
+
+    if (frame.fin)
+    {
+      std::string message = assembler_.take();
+      if (inboundCompressed_)
+      {
+        message = inflate_message(detail::as_byte_span(message));
+        if (isText)
+        {
+          check_text_chunk(message, true);
+        }
+      }
+
+      if (!router_)
+      {
+        return;
+      }
+
+      if (!isText && router_->has_binary_message_handler())
+      {
+        router_->handle_binary_message(*this, detail::as_byte_span(message));
+      }
+      else
+      {
+        router_->handle_message(*this, std::move(message));
+      }
+    }
+  }
+
+  void Session::check_text_chunk(std::string_view chunk, bool last)
+  {
+    if (!utf8_.feed(chunk) || (last && !utf8_.finish()))
+    {
+      throw_invalid_utf8();
+    }
+  }
+
+  void Session::throw_invalid_utf8()
+  {
+    throw detail::CloseError(
+        detail::CloseCode::InvalidPayload,
+        "websocket text message is not valid UTF-8");
+  }
+
+  std::string Session::inflate_message(std::span<const std::byte> payload)
+  {
+    std::string out;
+    deflate_->decompress(payload, true, out, cfg_.maxMessageSize);
+
+    if (metrics_)
+    {
+      metrics_->inflate_messages_total.fetch_add(1, std::memory_order_relaxed);
+      metrics_->inflate_bytes_in_total.fetch_add(payload.size(), std::memory_order_relaxed);
+      metrics_->inflate_bytes_out_total.fetch_add(out.size(), std::memory_order_relaxed);
+    }
+
+    return out;
+  }
+
+  task<detail::FrameHeader> Session::read_frame_header()
   {
     co_await ensure_bytes(2);
+    co_await ensure_bytes(detail::frame_header_size(readBuffer_.data()));
 
     const detail::FrameHeader h =
-        detail::parse_frame_header(
-            reinterpret_cast<const std::byte *>(readBuffer_.data()),
-            readBuffer_.size());
+        detail::parse_frame_header(readBuffer_.data(), readBuffer_.size());
+
+    if (!detail::is_known_opcode(h.opcode))
+    {
+      throw std::runtime_error("websocket frame uses a reserved opcode");
+    }
+
+    if (h.rsv1 &&
+        (!deflate_ ||
+         detail::is_control_opcode(h.opcode) ||
+         h.opcode == detail::Opcode::Continuation))
+    {
+      throw std::runtime_error("websocket frame has an unexpected RSV1 bit");
+    }
+
+    if (detail::is_control_opcode(h.opcode))
+    {
+      if (!h.fin)
+      {
+        throw std::runtime_error("websocket control frame must not be fragmented");
+      }
+
+      if (h.payload_length > 125)
+      {
+        throw std::runtime_error("websocket control frame payload too large");
+      }
+    }
+
+    co_return h;
+  }
+
+  task<detail::FrameView> Session::read_frame(const detail::FrameHeader &h)
+  {
+    if (h.payload_length > cfg_.maxMessageSize)
+    {
+      throw std::runtime_error("websocket frame exceeds max message size");
+    }
 
     const std::size_t frame_size = h.header_size + h.payload_length;
     co_await ensure_bytes(frame_size);
 
-    std::vector<std::byte> bytes(frame_size);
-    std::memcpy(bytes.data(), readBuffer_.data(), frame_size);
-    readBuffer_.erase(0, frame_size);
+    // The payload is unmasked in place and handed out as a view. Consuming
+    // only moves the read cursor, so the bytes stay put until the next read.
+    const detail::FrameView frame =
+        detail::decode_frame_in_place(readBuffer_.data(), h);
+    readBuffer_.consume(frame_size);
 
-    co_return detail::decode_frame(bytes);
+    co_return frame;
+  }
+
+  task<void> Session::stream_frame_payload(const detail::FrameHeader &h, bool isBinary)
+  {
+    readBuffer_.consume(h.header_size);
+
+    std::size_t remaining = h.payload_length;
+    std::size_t phase = 0;
+
+    // Hands one unmasked piece to the chunk handler, inflating it first
+    // when the message is compressed.
+    auto deliver = [&](std::span<const std::byte> piece, bool last)
+    {
+      if (!inboundCompressed_)
+      {
+        const std::string_view text(reinterpret_cast<const char *>(piece.data()), piece.size());
+        if (!isBinary)
+        {
+          check_text_chunk(text, last);
+        }
+
+        if (router_)
+        {
+          router_->handle_message_chunk(*this, text, isBinary, last);
+        }
+        return;
+      }
+
+      inflateScratch_.clear();
+      deflate_->decompress(piece, last, inflateScratch_, cfg_.maxMessageSize);
+
+      if (metrics_)
+      {
+        metrics_->inflate_bytes_in_total.fetch_add(piece.size(), std::memory_order_relaxed);
+        metrics_->inflate_bytes_out_total.fetch_add(inflateScratch_.size(), std::memory_order_relaxed);
+        if (last)
+        {
+          metrics_->inflate_messages_total.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      if (!isBinary)
+      {
+        check_text_chunk(inflateScratch_, last);
+      }
+
+      if (router_ && (last || !inflateScratch_.empty()))
+      {
+        router_->handle_message_chunk(*this, inflateScratch_, isBinary, last);
+      }
+    };
+
+    if (remaining == 0)
+    {
+      if (h.fin)
+      {
+        deliver({}, true);
+      }
+      co_return;
+    }
+
+    while (remaining > 0)
+    {
+      if (readBuffer_.empty())
+      {
+        co_await ensure_bytes(1);
+      }
+
+      const std::size_t n = std::min(remaining, readBuffer_.size());
+      std::byte *chunk = readBuffer_.data();
+
+      if (h.masked)
+      {
+        phase = detail::apply_mask(chunk, n, h.mask_key, phase);
+      }
+
+      remaining -= n;
+      deliver(std::span<const std::byte>(chunk, n), h.fin && remaining == 0);
+      readBuffer_.consume(n);
+    }
+
+    co_return;
+  }
+
+  void Session::note_activity() noexcept
+  {
+    if (timers_)
+    {
+      lastActivityTick_.store(timers_->now_tick(), std::memory_order_relaxed);
+    }
   }
 
   void Session::arm_idle_timer()
   {
-    return;
+    if (!timers_ || cfg_.idleTimeout <= std::chrono::seconds::zero())
+    {
+      return;
+    }
+
+    note_activity();
+
+    std::weak_ptr<Session> weak = weak_from_this();
+    timers_->schedule(
+        idleTimer_,
+        cfg_.idleTimeout,
+        [weak]()
+        {
+          if (auto self = weak.lock())
+          {
+            self->on_idle_timer();
+          }
+        });
   }
 
   void Session::cancel_idle_timer()
   {
-    idleCancel_.request_cancel();
+    if (timers_)
+    {
+      timers_->cancel(idleTimer_);
+    }
   }
 
-  task<void> Session::on_idle_timeout()
+  void Session::on_idle_timer()
   {
-    if (closing_ || !stream_ || !stream_->is_open())
+    if (closing_)
     {
-      co_return;
+      return;
     }
 
-    log().log(Logger::Level::Debug, "[ws] disconnected (idle timeout)");
+    // Frames only record a tick; the deadline is checked lazily here and
+    // pushed back by whatever is left of the timeout.
+    const std::uint64_t timeout = timers_->to_ticks(cfg_.idleTimeout);
+    const std::uint64_t idle =
+        timers_->now_tick() - lastActivityTick_.load(std::memory_order_relaxed);
 
-    closing_ = true;
-    open_ = false;
-    stop_heartbeat();
-
-    try
+    if (idle < timeout)
     {
-      co_await write_raw_frame(detail::build_close_frame(false));
+      timers_->reschedule(idleTimer_, (timeout - idle) * timers_->tick());
+      return;
     }
-    catch (...)
+
+    if (ioc_)
     {
+      spawn_detached(*ioc_, Session::idle_timeout_sequence(shared_from_this()));
     }
+  }
 
-    if (router_)
+  task<void> Session::idle_timeout_sequence(std::shared_ptr<Session> self)
+  {
+    co_await self->on_idle_timeout();
+  }
+
+  task<void> Session::on_idle_timeout()
+  {
+    if (closing_ || !stream_ || !stream_->is_open())
     {
-      notify_close_once(*this, router_, closeNotified_);
+      co_return;
     }
 
-    co_await close_stream_only();
+    log().log(Logger::Level::Debug, "[ws] disconnected (idle timeout)");
+
+    open_ = false;
+    close_now();
     co_return;
   }
 
-  void Session::do_enqueue_message(bool isBinary, std::string payload)
+  void Session::do_enqueue_message(
+      PendingMessage message,
+      bool conflate,
+      detail::WriteLane lane)
   {
     if (closing_)
     {
+      message.completion.finish(SendStatus::Rejected);
       return;
     }
 
-    const std::size_t payloadSize = payload.size();
-    bool overflow = false;
+    using Push = detail::BasicWriteQueue<PendingMessage>::Push;
+
+    Push result = Push::Queued;
+    WriteQueueStats before{};
+    WriteQueueStats after{};
+    BackpressureOptions limits{};
 
     {
       std::lock_guard<std::mutex> lock(writeMutex_);
 
       if (closing_)
       {
+        message.completion.finish(SendStatus::Rejected);
         return;
       }
 
-      if (writeQueue_.size() >= MAX_PENDING_WRITE_MESSAGES ||
-          queuedWriteBytes_ + payloadSize > MAX_PENDING_WRITE_BYTES)
+      message.completion.set_queue_position(writeQueue_.size());
+
+      before = writeQueue_.stats();
+      result = conflate
+                   ? writeQueue_.push_conflated(std::move(message), lane)
+                   : writeQueue_.push(std::move(message), lane);
+      after = writeQueue_.stats();
+      limits = writeQueue_.options();
+    }
+
+    // Still owned here only if the queue did not take it. A message shed by
+    // the overflow policy is Dropped, like one DropOldest discards; only a
+    // send the session refused outright is Rejected.
+    message.completion.finish(
+        result == Push::Dropped ? SendStatus::Dropped : SendStatus::Rejected);
+
+    if (metrics_)
+    {
+      auto &m = *metrics_;
+      m.backpressure_dropped_total.fetch_add(after.dropped - before.dropped, std::memory_order_relaxed);
+      m.backpressure_conflated_total.fetch_add(after.conflated - before.conflated, std::memory_order_relaxed);
+
+      if (result == Push::Overflow)
       {
-        overflow = true;
+        m.backpressure_closes_total.fetch_add(1, std::memory_order_relaxed);
       }
-      else
-      {
-        queuedWriteBytes_ += payloadSize;
 
-        writeQueue_.push_back(PendingMessage{
-            isBinary,
-            std::move(payload),
-        });
+      if (after.highWaterMessages > before.highWaterMessages)
+      {
+        raise_to(m.write_queue_high_water_messages, after.highWaterMessages);
+      }
+      if (after.highWaterBytes > before.highWaterBytes)
+      {
+        raise_to(m.write_queue_high_water_bytes, after.highWaterBytes);
       }
     }
 
-    if (overflow)
+    if (result == Push::Overflow)
     {
       log().log(
           Logger::Level::Warn,
           "[ws] closing slow client reason=backpressure queue_messages={} queue_bytes={}",
-          MAX_PENDING_WRITE_MESSAGES,
-          MAX_PENDING_WRITE_BYTES);
+          limits.maxMessages,
+          limits.maxBytes);
 
-      close("backpressure");
+      close_now();
       return;
     }
 
     trigger_write_flush();
   }
 
+  bool Session::queue_close_frame(std::optional<detail::CloseCode> code)
+  {
+    std::array<std::byte, 2> status{};
+    std::span<const std::byte> payload{};
+    if (code)
+    {
+      const auto value = static_cast<std::uint16_t>(*code);
+      status = {static_cast<std::byte>(value >> 8), static_cast<std::byte>(value & 0xFF)};
+      payload = status;
+    }
+
+    return ioc_ && stream_ && stream_->is_open() &&
+           writeQueue_.push_last(
+               PendingMessage{false, {}, detail::make_shared_frame(detail::Opcode::Close, payload)});
+  }
+
+  void Session::arm_close_timer()
+  {
+    if (!timers_ || cfg_.closeTimeout <= std::chrono::seconds::zero())
+    {
+      return;
+    }
+
+    std::weak_ptr<Session> weak = weak_from_this();
+    timers_->schedule(
+        closeTimer_,
+        cfg_.closeTimeout,
+        [weak]()
+        {
+          if (auto self = weak.lock())
+          {
+            self->on_close_timer();
+          }
+        });
+  }
+
+  void Session::on_close_timer()
+  {
+    if (ioc_ && stream_ && stream_->is_open())
+    {
+      spawn_detached(*ioc_, Session::close_deadline_sequence(shared_from_this()));
+    }
+  }
+
   void Session::emit_error(const std::string &message)
   {
     const DisconnectReason reason =
@@ -845,6 +1563,21 @@ namespace vix::websocket
     }
   }
 
+  detail::SendCompletion Session::make_completion(SendCallback onSent)
+  {
+    if (!onSent)
+    {
+      return {};
+    }
+
+    return detail::SendCompletion(
+        [ioc = ioc_, onSent = std::move(onSent)](const SendReceipt &receipt)
+        {
+          ioc->post([onSent, receipt]()
+                    { onSent(receipt); });
+        });
+  }
+
   void Session::trigger_write_flush()
   {
     {
@@ -862,38 +1595,33 @@ namespace vix::websocket
         Session::flush_write_loop(shared_from_this()));
   }
 
-  task<std::string> Session::read_http_head()
+  task<detail::UpgradeRequest> Session::read_http_head()
   {
-    constexpr std::size_t MAX_HTTP_HEAD = 64 * 1024;
+    detail::UpgradeParser parser;
 
     while (true)
     {
-      const auto pos = find_http_head_end(readBuffer_);
-      if (pos != std::string::npos)
+      switch (parser.parse(readBuffer_.view()))
       {
-        std::string out = readBuffer_.substr(0, pos);
-        readBuffer_.erase(0, pos);
-        co_return out;
-      }
+      case detail::UpgradeParser::Status::Complete:
+        co_return parser.request(readBuffer_.view());
 
-      if (readBuffer_.size() > MAX_HTTP_HEAD)
-      {
-        throw std::runtime_error("websocket HTTP head too large");
+      case detail::UpgradeParser::Status::Error:
+        throw std::runtime_error(parser.error());
+
+      case detail::UpgradeParser::Status::NeedMore:
+        break;
       }
 
-      std::array<std::byte, 8192> chunk{};
-      const auto n = co_await stream_->async_read(
-          std::span<std::byte>(chunk.data(), chunk.size()),
-          readCancel_.token());
+      const auto space = readBuffer_.prepare(READ_CHUNK_SIZE);
+      const auto n = co_await stream_->async_read(space, readCancel_.token());
 
       if (n == 0)
       {
         throw std::runtime_error("unexpected EOF while reading websocket HTTP head");
       }
 
-      readBuffer_.append(
-          reinterpret_cast<const char *>(chunk.data()),
-          n);
+      readBuffer_.commit(n);
     }
   }
 
@@ -901,32 +1629,42 @@ namespace vix::websocket
   {
     while (readBuffer_.size() < n)
     {
-      std::array<std::byte, 8192> chunk{};
-      const auto r = co_await stream_->async_read(
-          std::span<std::byte>(chunk.data(), chunk.size()),
-          readCancel_.token());
+      // Read straight into the buffer tail; ask for at least the missing
+      // bytes so a large frame is not assembled from many small reads.
+      const std::size_t missing = n - readBuffer_.size();
+      const auto space = readBuffer_.prepare(std::max(missing, READ_CHUNK_SIZE));
+
+      const auto r = co_await stream_->async_read(space, readCancel_.token());
 
       if (r == 0)
       {
         throw std::system_error(std::make_error_code(std::errc::connection_reset));
       }
 
-      readBuffer_.append(
-          reinterpret_cast<const char *>(chunk.data()),
-          r);
+      readBuffer_.commit(r);
     }
 
     co_return;
   }
 
-  task<void> Session::send_upgrade_response(const std::string &accept_key)
+  task<void> Session::send_upgrade_response(
+      std::string_view accept_key,
+      std::string_view extensions)
   {
     std::string res;
     res.reserve(256);
     res += "HTTP/1.1 101 Switching Protocols\r\n";
     res += "Upgrade: websocket\r\n";
     res += "Connection: Upgrade\r\n";
-    res += "Sec-WebSocket-Accept: " + accept_key + "\r\n";
+    res += "Sec-WebSocket-Accept: ";
+    res += accept_key;
+    res += "\r\n";
+    if (!extensions.empty())
+    {
+      res += "Sec-WebSocket-Extensions: ";
+      res += extensions;
+      res += "\r\n";
+    }
     res += "Server: Vix.cpp\r\n";
     res += "\r\n";
 
@@ -959,12 +1697,15 @@ namespace vix::websocket
     {
       std::lock_guard<std::mutex> lock(writeMutex_);
       writeQueue_.clear();
-      queuedWriteBytes_ = 0;
       writeInProgress_ = false;
     }
 
     cancel_idle_timer();
     stop_heartbeat();
+    if (timers_)
+    {
+      timers_->cancel(closeTimer_);
+    }
     readCancel_.request_cancel();
     writeCancel_.request_cancel();
     closeCancel_.request_cancel();
@@ -979,16 +1720,16 @@ namespace vix::websocket
 
   void Session::shutdown_now() noexcept
   {
-    bool expected = false;
-    if (!closing_.compare_exchange_strong(expected, true))
-    {
-      return;
-    }
-
+    // A graceful close may still be draining; shutdown does not wait for it.
+    closing_ = true;
     open_ = false;
 
     cancel_idle_timer();
     stop_heartbeat();
+    if (timers_)
+    {
+      timers_->cancel(closeTimer_);
+    }
 
     readCancel_.request_cancel();
     writeCancel_.request_cancel();
@@ -1008,22 +1749,46 @@ namespace vix::websocket
 
   void Session::maybe_start_heartbeat()
   {
-    return;
+    if (!timers_ || cfg_.pingInterval <= std::chrono::seconds::zero())
+    {
+      return;
+    }
+
+    std::weak_ptr<Session> weak = weak_from_this();
+    timers_->schedule(
+        heartbeatTimer_,
+        cfg_.pingInterval,
+        [weak]()
+        {
+          if (auto self = weak.lock())
+          {
+            self->on_heartbeat_timer();
+          }
+        });
   }
 
-  void Session::stop_heartbeat()
+  void Session::on_heartbeat_timer()
   {
-    heartbeatStop_ = true;
-
-    if (heartbeatThread_.joinable())
+    if (closing_ || !open_)
     {
-      if (heartbeatThread_.get_id() == std::this_thread::get_id())
-      {
-        heartbeatThread_.detach();
-        return;
-      }
+      return;
+    }
 
-      heartbeatThread_.join();
+    timers_->reschedule(heartbeatTimer_, cfg_.pingInterval);
+
+    // Pings go through the write queue so they never interleave with a
+    // frame the flush loop is writing.
+    do_enqueue_message(
+        PendingMessage{false, {}, shared_ping_frame()},
+        false,
+        detail::WriteLane::Control);
+  }
+
+  void Session::stop_heartbeat()
+  {
+    if (timers_)
+    {
+      timers_->cancel(heartbeatTimer_);
     }
   }
 
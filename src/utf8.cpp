@@ -0,0 +1,607 @@
+/**
+ *
+ *  @file utf8.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/websocket/utf8.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "detail/cpu_features.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VIX_WS_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace vix::websocket::detail
+{
+  namespace
+  {
+    using utf8_fn = bool (*)(const std::uint8_t *, std::size_t) noexcept;
+
+    /** Length of the sequence introduced by @p lead, 0 if it cannot start one. */
+    inline std::size_t sequence_length(std::uint8_t lead) noexcept
+    {
+      if (lead < 0x80)
+      {
+        return 1;
+      }
+      if (lead >= 0xC2 && lead <= 0xDF)
+      {
+        return 2;
+      }
+      if (lead >= 0xE0 && lead <= 0xEF)
+      {
+        return 3;
+      }
+      if (lead >= 0xF0 && lead <= 0xF4)
+      {
+        return 4;
+      }
+      return 0;
+    }
+
+    /** Unicode Table 3-7: the second byte range depends on the lead. */
+    inline bool second_byte_ok(std::uint8_t lead, std::uint8_t b) noexcept
+    {
+      switch (lead)
+      {
+      case 0xE0:
+        return b >= 0xA0 && b <= 0xBF;
+      case 0xED:
+        return b >= 0x80 && b <= 0x9F;
+      case 0xF0:
+        return b >= 0x90 && b <= 0xBF;
+      case 0xF4:
+        return b >= 0x80 && b <= 0x8F;
+      default:
+        return (b & 0xC0) == 0x80;
+      }
+    }
+
+    /**
+     * Validate [s, s + n). A sequence cut short by the end of the buffer is
+     * not an error here: its well-formed prefix is accepted and its offset
+     * reported through @p incompleteAt (n when everything is complete).
+     */
+    bool scalar_validate(const std::uint8_t *s, std::size_t n, std::size_t &incompleteAt) noexcept
+    {
+      std::size_t i = 0;
+
+      while (i < n)
+      {
+        if (i + 8 <= n)
+        {
+          std::uint64_t w;
+          std::memcpy(&w, s + i, sizeof(w));
+          if ((w & 0x8080808080808080ull) == 0)
+          {
+            i += 8;
+            continue;
+          }
+        }
+
+        const std::uint8_t c = s[i];
+        if (c < 0x80)
+        {
+          ++i;
+          continue;
+        }
+
+        const std::size_t len = sequence_length(c);
+        if (len == 0)
+        {
+          return false;
+        }
+
+        const std::size_t avail = std::min(len, n - i);
+        if (avail > 1 && !second_byte_ok(c, s[i + 1]))
+        {
+          return false;
+        }
+
+        for (std::size_t k = 2; k < avail; ++k)
+        {
+          if ((s[i + k] & 0xC0) != 0x80)
+          {
+            return false;
+          }
+        }
+
+        if (avail < len)
+        {
+          incompleteAt = i;
+          return true;
+        }
+
+        i += len;
+      }
+
+      incompleteAt = n;
+      return true;
+    }
+
+    bool utf8_scalar(const std::uint8_t *s, std::size_t n) noexcept
+    {
+      std::size_t incompleteAt = 0;
+      return scalar_validate(s, n, incompleteAt) && incompleteAt == n;
+    }
+
+    /**
+     * The vector kernels check every byte against the ones before it, so a
+     * sequence whose lead sits in the last three bytes of the vector region
+     * is only complete-checked by the scalar tail, which restarts at it.
+     */
+    bool validate_tail(const std::uint8_t *s, std::size_t done, std::size_t n) noexcept
+    {
+      std::size_t start = done;
+      for (std::size_t k = 1; k <= 3 && k <= done; ++k)
+      {
+        const std::uint8_t b = s[done - k];
+        if ((b & 0xC0) != 0x80)
+        {
+          if (b >= 0xC0)
+          {
+            start = done - k;
+          }
+          break;
+        }
+      }
+
+      return utf8_scalar(s + start, n - start);
+    }
+
+    // Lookup tables of the vectorised check ("Validating UTF-8 In Less Than
+    // One Instruction Per Byte", Keiser & Lemire). Each table maps a nibble
+    // to the set of errors that nibble is compatible with; a byte pair is
+    // invalid when the three lookups share a bit.
+    constexpr std::uint8_t TOO_SHORT = 1u << 0;
+    constexpr std::uint8_t TOO_LONG = 1u << 1;
+    constexpr std::uint8_t OVERLONG_3 = 1u << 2;
+    constexpr std::uint8_t TOO_LARGE = 1u << 3;
+    constexpr std::uint8_t SURROGATE = 1u << 4;
+    constexpr std::uint8_t OVERLONG_2 = 1u << 5;
+    constexpr std::uint8_t TOO_LARGE_1000 = 1u << 6;
+    constexpr std::uint8_t OVERLONG_4 = 1u << 6;
+    constexpr std::uint8_t TWO_CONTS = 1u << 7;
+    constexpr std::uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    [[maybe_unused]] alignas(16) constexpr std::uint8_t BYTE_1_HIGH[16] = {
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+    [[maybe_unused]] alignas(16) constexpr std::uint8_t BYTE_1_LOW[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+    [[maybe_unused]] alignas(16) constexpr std::uint8_t BYTE_2_HIGH[16] = {
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+    /** Bytes above these values in the last lanes start an unfinished sequence. */
+    [[maybe_unused]] alignas(32) constexpr std::uint8_t INCOMPLETE_MAX[32] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF};
+
+    /** Below this size the vector setup costs more than the scalar loop. */
+    constexpr std::size_t VECTOR_MIN_SIZE = 64;
+
+#if defined(VIX_WS_X86)
+    VIX_WS_TARGET("sse4.1")
+    bool utf8_sse4(const std::uint8_t *s, std::size_t n) noexcept
+    {
+      if (n < VECTOR_MIN_SIZE)
+      {
+        return utf8_scalar(s, n);
+      }
+
+      const __m128i byte1High = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_HIGH));
+      const __m128i byte1Low = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_LOW));
+      const __m128i byte2High = _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_2_HIGH));
+      const __m128i incompleteMax =
+          _mm_load_si128(reinterpret_cast<const __m128i *>(INCOMPLETE_MAX + 16));
+      const __m128i nibble = _mm_set1_epi8(0x0F);
+
+      __m128i prev = _mm_setzero_si128();
+      __m128i prevIncomplete = _mm_setzero_si128();
+      __m128i error = _mm_setzero_si128();
+
+      std::size_t i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+
+        if (_mm_movemask_epi8(in) == 0)
+        {
+          // ASCII block: only an unfinished sequence before it can fail.
+          error = _mm_or_si128(error, prevIncomplete);
+        }
+        else
+        {
+          const __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+          const __m128i prev2 = _mm_alignr_epi8(in, prev, 14);
+          const __m128i prev3 = _mm_alignr_epi8(in, prev, 13);
+
+          const __m128i b1h = _mm_shuffle_epi8(
+              byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+          const __m128i b1l = _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble));
+          const __m128i b2h = _mm_shuffle_epi8(
+              byte2High, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+          const __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+          const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(0x60));
+          const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0x70));
+          const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth),
+                                               _mm_set1_epi8(static_cast<char>(0x80)));
+
+          error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+          prevIncomplete = _mm_subs_epu8(in, incompleteMax);
+        }
+
+        prev = in;
+      }
+
+      if (!_mm_testz_si128(error, error))
+      {
+        return false;
+      }
+
+      return validate_tail(s, i, n);
+    }
+
+    VIX_WS_TARGET("avx2")
+    bool utf8_avx2(const std::uint8_t *s, std::size_t n) noexcept
+    {
+      if (n < VECTOR_MIN_SIZE)
+      {
+        return utf8_scalar(s, n);
+      }
+
+      const __m256i byte1High = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_HIGH)));
+      const __m256i byte1Low = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_1_LOW)));
+      const __m256i byte2High = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i *>(BYTE_2_HIGH)));
+      const __m256i incompleteMax =
+          _mm256_load_si256(reinterpret_cast<const __m256i *>(INCOMPLETE_MAX));
+      const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+      __m256i prev = _mm256_setzero_si256();
+      __m256i prevIncomplete = _mm256_setzero_si256();
+      __m256i error = _mm256_setzero_si256();
+
+      std::size_t i = 0;
+      for (; i + 32 <= n; i += 32)
+      {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+
+        if (_mm256_movemask_epi8(in) == 0)
+        {
+          error = _mm256_or_si256(error, prevIncomplete);
+        }
+        else
+        {
+          // Lane-crossing shift: bytes of the previous block feed the
+          // first lane, bytes of the low lane feed the high one.
+          const __m256i carried = _mm256_permute2x128_si256(prev, in, 0x21);
+          const __m256i prev1 = _mm256_alignr_epi8(in, carried, 15);
+          const __m256i prev2 = _mm256_alignr_epi8(in, carried, 14);
+          const __m256i prev3 = _mm256_alignr_epi8(in, carried, 13);
+
+          const __m256i b1h = _mm256_shuffle_epi8(
+              byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+          const __m256i b1l = _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble));
+          const __m256i b2h = _mm256_shuffle_epi8(
+              byte2High, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+          const __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+          const __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0x60));
+          const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0x70));
+          const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                                  _mm256_set1_epi8(static_cast<char>(0x80)));
+
+          error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+          prevIncomplete = _mm256_subs_epu8(in, incompleteMax);
+        }
+
+        prev = in;
+      }
+
+      const bool ok = _mm256_testz_si256(error, error) != 0;
+
+      // The tail runs non-VEX code; avoid the AVX/SSE transition penalty.
+      _mm256_zeroupper();
+
+      return ok && validate_tail(s, i, n);
+    }
+#endif // VIX_WS_X86
+
+#if defined(VIX_WS_UTF8_NEON)
+    bool utf8_neon(const std::uint8_t *s, std::size_t n) noexcept
+    {
+      if (n < VECTOR_MIN_SIZE)
+      {
+        return utf8_scalar(s, n);
+      }
+
+      const uint8x16_t byte1High = vld1q_u8(BYTE_1_HIGH);
+      const uint8x16_t byte1Low = vld1q_u8(BYTE_1_LOW);
+      const uint8x16_t byte2High = vld1q_u8(BYTE_2_HIGH);
+      const uint8x16_t incompleteMax = vld1q_u8(INCOMPLETE_MAX + 16);
+      const uint8x16_t nibble = vdupq_n_u8(0x0F);
+
+      uint8x16_t prev = vdupq_n_u8(0);
+      uint8x16_t prevIncomplete = vdupq_n_u8(0);
+      uint8x16_t error = vdupq_n_u8(0);
+
+      std::size_t i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        const uint8x16_t in = vld1q_u8(s + i);
+
+        if (vmaxvq_u8(in) < 0x80)
+        {
+          error = vorrq_u8(error, prevIncomplete);
+        }
+        else
+        {
+          const uint8x16_t prev1 = vextq_u8(prev, in, 15);
+          const uint8x16_t prev2 = vextq_u8(prev, in, 14);
+          const uint8x16_t prev3 = vextq_u8(prev, in, 13);
+
+          const uint8x16_t b1h = vqtbl1q_u8(byte1High, vshrq_n_u8(prev1, 4));
+          const uint8x16_t b1l = vqtbl1q_u8(byte1Low, vandq_u8(prev1, nibble));
+          const uint8x16_t b2h = vqtbl1q_u8(byte2High, vshrq_n_u8(in, 4));
+          const uint8x16_t special = vandq_u8(vandq_u8(b1h, b1l), b2h);
+
+          const uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0x60));
+          const uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0x70));
+          const uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+          error = vorrq_u8(error, veorq_u8(must23, special));
+          prevIncomplete = vqsubq_u8(in, incompleteMax);
+        }
+
+        prev = in;
+      }
+
+      if (vmaxvq_u8(error) != 0)
+      {
+        return false;
+      }
+
+      return validate_tail(s, i, n);
+    }
+#endif // VIX_WS_UTF8_NEON
+
+    utf8_fn kernel_fn(Utf8Kernel kernel) noexcept
+    {
+      switch (kernel)
+      {
+      case Utf8Kernel::Scalar:
+        return &utf8_scalar;
+#if defined(VIX_WS_X86)
+      case Utf8Kernel::Sse4:
+        return &utf8_sse4;
+      case Utf8Kernel::Avx2:
+        return &utf8_avx2;
+#endif
+#if defined(VIX_WS_UTF8_NEON)
+      case Utf8Kernel::Neon:
+        return &utf8_neon;
+#endif
+      default:
+        return &utf8_scalar;
+      }
+    }
+
+    Utf8Kernel detect_utf8_kernel() noexcept
+    {
+      if (utf8_kernel_supported(Utf8Kernel::Avx2))
+      {
+        return Utf8Kernel::Avx2;
+      }
+
+      if (utf8_kernel_supported(Utf8Kernel::Neon))
+      {
+        return Utf8Kernel::Neon;
+      }
+
+      if (utf8_kernel_supported(Utf8Kernel::Sse4))
+      {
+        return Utf8Kernel::Sse4;
+      }
+
+      return Utf8Kernel::Scalar;
+    }
+
+    utf8_fn active_utf8_fn() noexcept
+    {
+      static const utf8_fn fn = kernel_fn(active_utf8_kernel());
+      return fn;
+    }
+
+    inline const std::uint8_t *as_u8(std::span<const std::byte> data) noexcept
+    {
+      return reinterpret_cast<const std::uint8_t *>(data.data());
+    }
+  } // namespace
+
+  const char *utf8_kernel_name(Utf8Kernel kernel) noexcept
+  {
+    switch (kernel)
+    {
+    case Utf8Kernel::Scalar:
+      return "scalar";
+    case Utf8Kernel::Sse4:
+      return "sse4";
+    case Utf8Kernel::Avx2:
+      return "avx2";
+    case Utf8Kernel::Neon:
+      return "neon";
+    }
+
+    return "unknown";
+  }
+
+  bool utf8_kernel_supported(Utf8Kernel kernel) noexcept
+  {
+    switch (kernel)
+    {
+    case Utf8Kernel::Scalar:
+      return true;
+#if defined(VIX_WS_X86)
+    case Utf8Kernel::Sse4:
+      return cpu_features().sse41;
+    case Utf8Kernel::Avx2:
+      return cpu_features().avx2;
+#endif
+#if defined(VIX_WS_UTF8_NEON)
+    case Utf8Kernel::Neon:
+      return true;
+#endif
+    default:
+      return false;
+    }
+  }
+
+  Utf8Kernel active_utf8_kernel() noexcept
+  {
+    static const Utf8Kernel kernel = detect_utf8_kernel();
+    return kernel;
+  }
+
+  bool is_valid_utf8(std::span<const std::byte> data) noexcept
+  {
+    return active_utf8_fn()(as_u8(data), data.size());
+  }
+
+  bool is_valid_utf8_with(Utf8Kernel kernel, std::span<const std::byte> data) noexcept
+  {
+    if (!utf8_kernel_supported(kernel))
+    {
+      kernel = Utf8Kernel::Scalar;
+    }
+
+    return kernel_fn(kernel)(as_u8(data), data.size());
+  }
+
+  bool Utf8Validator::feed(std::span<const std::byte> data) noexcept
+  {
+    if (failed_)
+    {
+      return false;
+    }
+
+    const std::uint8_t *p = as_u8(data);
+    std::size_t n = data.size();
+
+    if (pendingSize_ > 0)
+    {
+      // Finish the sequence left open by the previous piece first.
+      const std::size_t need = sequence_length(pending_[0]) - pendingSize_;
+      const std::size_t take = std::min(need, n);
+
+      std::memcpy(pending_.data() + pendingSize_, p, take);
+      pendingSize_ = static_cast<std::uint8_t>(pendingSize_ + take);
+      p += take;
+      n -= take;
+
+      std::size_t incompleteAt = 0;
+      if (!scalar_validate(pending_.data(), pendingSize_, incompleteAt))
+      {
+        failed_ = true;
+        return false;
+      }
+
+      if (incompleteAt == 0)
+      {
+        return true;
+      }
+
+      pendingSize_ = 0;
+    }
+
+    if (n == 0)
+    {
+      return true;
+    }
+
+    // Keep a trailing unfinished sequence for the next piece.
+    std::size_t cut = n;
+    for (std::size_t k = 1; k <= 3 && k <= n; ++k)
+    {
+      const std::uint8_t b = p[n - k];
+      if ((b & 0xC0) != 0x80)
+      {
+        if (b >= 0xC0 && sequence_length(b) > k)
+        {
+          cut = n - k;
+        }
+        break;
+      }
+    }
+
+    if (!active_utf8_fn()(p, cut))
+    {
+      failed_ = true;
+      return false;
+    }
+
+    const std::size_t rest = n - cut;
+    if (rest == 0)
+    {
+      return true;
+    }
+
+    std::memcpy(pending_.data(), p + cut, rest);
+    pendingSize_ = static_cast<std::uint8_t>(rest);
+
+    std::size_t incompleteAt = 0;
+    if (!scalar_validate(pending_.data(), pendingSize_, incompleteAt))
+    {
+      failed_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+} // namespace vix::websocket::detail
@@ -16,9 +16,11 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <string>
 #include <system_error>
 #include <thread>
 #include <utility>
@@ -26,6 +28,8 @@
 #include <vix/async/core/spawn.hpp>
 #include <vix/async/net/tcp.hpp>
 #include <vix/async/net/asio_net_service.hpp>
+#include <vix/websocket/CoreGroup.hpp>
+#include <vix/websocket/ReusePort.hpp>
 
 #if defined(__linux__)
 #include <pthread.h>
@@ -44,6 +48,22 @@ namespace vix::websocket
       return Logger::getInstance();
     }
 
+#if VIX_WEBSOCKET_REUSE_PORT
+    template <typename Endpoint>
+    constexpr bool endpoint_has_reuse_port = requires(Endpoint &ep) { ep.reuse_port = true; };
+
+    static_assert(
+        endpoint_has_reuse_port<tcp_endpoint>,
+        "VIX_WEBSOCKET_REUSE_PORT needs a vix::async whose tcp_endpoint has reuse_port");
+#endif
+
+    void set_reuse_port([[maybe_unused]] tcp_endpoint &ep, [[maybe_unused]] bool on)
+    {
+#if VIX_WEBSOCKET_REUSE_PORT
+      ep.reuse_port = on;
+#endif
+    }
+
     void init_logger_from_env_once()
     {
       static std::once_flag once;
@@ -94,9 +114,10 @@ namespace vix::websocket
         wsConfig_(Config::from_core(coreConfig_)),
         executor_(std::move(executor)),
         router_(std::move(router)),
-        ioContext_(std::make_shared<io_context>()),
-        listener_(nullptr),
+        shards_(),
+        accepted_(),
         ioThreads_(),
+        timerThread_(),
         stopRequested_(false),
         logged_listen_(false),
         boundPort_(0),
@@ -123,6 +144,49 @@ namespace vix::websocket
           port);
       throw std::invalid_argument("Invalid WebSocket port");
     }
+
+    const std::size_t shardCount = wsConfig_.acceptorThreads;
+    if (shardCount > 1)
+    {
+#if !VIX_WEBSOCKET_REUSE_PORT
+      logger().log(
+          Logger::Level::Error,
+          "[ws] acceptor_threads = {} needs a build with VIX_WEBSOCKET_REUSE_PORT",
+          shardCount);
+      throw std::invalid_argument(
+          "websocket.acceptor_threads > 1 needs VIX_WEBSOCKET_REUSE_PORT");
+#endif
+
+      if (port == 0)
+      {
+        logger().log(
+            Logger::Level::Error,
+            "[ws] acceptor_threads = {} needs a fixed port",
+            shardCount);
+        throw std::invalid_argument("websocket.acceptor_threads > 1 needs a fixed port");
+      }
+    }
+
+    // Sessions cannot move between IO contexts, so the cores of a
+    // shared-nothing group are the acceptor shards; one would serialize
+    // every session and broadcast on a single thread.
+    if (wsConfig_.sharedNothing && shardCount < 2)
+    {
+      logger().log(
+          Logger::Level::Error,
+          "[ws] shared_nothing needs acceptor_threads > 1");
+      throw std::invalid_argument("websocket.shared_nothing needs websocket.acceptor_threads > 1");
+    }
+
+    accepted_ = std::vector<std::atomic<std::uint64_t>>(shardCount);
+    shards_.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i)
+    {
+      shards_.push_back(IoShard{
+          std::make_shared<io_context>(),
+          nullptr,
+          std::make_shared<detail::TimerWheel>()});
+    }
   }
 
   LowLevelServer::~LowLevelServer()
@@ -161,10 +225,13 @@ namespace vix::websocket
     return ep;
   }
 
-  vix::async::core::task<void> LowLevelServer::init_listener(unsigned short port)
+  vix::async::core::task<void> LowLevelServer::init_listener(
+      IoShard &shard,
+      unsigned short port,
+      bool reusePort)
   {
-    listener_ = vix::async::net::make_tcp_listener(*ioContext_);
-    if (!listener_)
+    shard.listener = vix::async::net::make_tcp_listener(*shard.ioc);
+    if (!shard.listener)
     {
       throw std::runtime_error("failed to create native Vix TCP listener");
     }
@@ -180,8 +247,9 @@ namespace vix::websocket
               "0.0.0.0");
 
       endpoint.port = port;
+      set_reuse_port(endpoint, reusePort);
 
-      co_await listener_->async_listen(endpoint);
+      co_await shard.listener->async_listen(endpoint);
 
       boundPort_.store(static_cast<int>(port), std::memory_order_relaxed);
     }
@@ -198,7 +266,7 @@ namespace vix::websocket
     co_return;
   }
 
-  vix::async::core::task<void> LowLevelServer::start_server()
+  vix::async::core::task<void> LowLevelServer::start_server(std::size_t index)
   {
     const int port =
         get_config_int_fallback(
@@ -207,23 +275,71 @@ namespace vix::websocket
             "websocket_port",
             9090);
 
-    co_await init_listener(static_cast<unsigned short>(port));
+    IoShard &shard = shards_[index];
+
+    if (index == 0)
+    {
+      co_await init_listener(
+          shard,
+          static_cast<unsigned short>(port),
+          shards_.size() > 1);
+    }
+    else
+    {
+      // Join the port only if the first listener really holds SO_REUSEPORT;
+      // otherwise this bind would fail with EADDRINUSE.
+      const std::string host = make_bind_endpoint().host;
+      if (!detail::reuse_port_joinable(host, static_cast<std::uint16_t>(port)))
+      {
+        logger().log(
+            Logger::Level::Warn,
+            "[ws] port {} is not shared with SO_REUSEPORT; shard {} accepts no connections",
+            port,
+            index);
+        co_return;
+      }
+
+      try
+      {
+        co_await init_listener(shard, static_cast<unsigned short>(port), true);
+      }
+      catch (const std::exception &)
+      {
+        // Logged by init_listener; the other shards keep accepting.
+        co_return;
+      }
+    }
 
     if (stopRequested_.load(std::memory_order_acquire))
     {
       co_return;
     }
 
-    if (!listener_ || !listener_->is_open())
+    if (!shard.listener || !shard.listener->is_open())
     {
       throw std::runtime_error("websocket listener is not open");
     }
 
-    if (!logged_listen_.exchange(true, std::memory_order_acq_rel))
+    if (index == 0)
+    {
+      // The others join the port once it is held with SO_REUSEPORT.
+      for (std::size_t i = 1; i < shards_.size(); ++i)
+      {
+        spawn_detached(*shards_[i].ioc, start_server(i));
+      }
+    }
+
+    if (shards_.size() > 1 &&
+        !logged_listen_.exchange(true, std::memory_order_acq_rel))
     {
-      spawn_detached(*ioContext_, accept_loop());
+      logger().log(
+          Logger::Level::Debug,
+          "[ws] {} SO_REUSEPORT acceptors on port {}",
+          shards_.size(),
+          port);
     }
 
+    spawn_detached(*shard.ioc, accept_loop(index));
     co_return;
   }
 
@@ -232,45 +348,31 @@ namespace vix::websocket
     init_logger_from_env_once();
     vix::utils::console_wait_banner();
 
-    spawn_detached(*ioContext_, start_server());
+    spawn_detached(*shards_.front().ioc, start_server(0));
+
     start_io_threads();
+    start_timer_thread();
   }
 
-  void LowLevelServer::start_accept()
+  vix::async::core::task<void> LowLevelServer::accept_loop(std::size_t index)
   {
-    if (stopRequested_.load(std::memory_order_acquire))
-    {
-      return;
-    }
+    IoShard &shard = shards_[index];
 
-    if (!listener_ || !listener_->is_open())
-    {
-      throw std::runtime_error("websocket listener is not open");
-    }
-
-    if (!logged_listen_.exchange(true, std::memory_order_acq_rel))
-    {
-      spawn_detached(*ioContext_, accept_loop());
-    }
-  }
-
-  vix::async::core::task<void> LowLevelServer::accept_loop()
-  {
     while (!stopRequested_.load(std::memory_order_acquire))
     {
-      if (!listener_ || !listener_->is_open())
+      if (!shard.listener || !shard.listener->is_open())
       {
         break;
       }
 
       try
       {
-        auto stream = co_await listener_->async_accept();
+        auto stream = co_await shard.listener->async_accept();
 
         if (!stream)
         {
           if (stopRequested_.load(std::memory_order_acquire) ||
-              !listener_ || !listener_->is_open())
+              !shard.listener || !shard.listener->is_open())
           {
             break;
           }
@@ -284,12 +386,15 @@ namespace vix::websocket
           break;
         }
 
-        spawn_detached(*ioContext_, handle_client(std::move(stream)));
+        accepted_[index].fetch_add(1, std::memory_order_relaxed);
+
+        // The stream belongs to this shard's context; the session stays here.
+        spawn_detached(*shard.ioc, handle_client(std::move(stream), index));
       }
       catch (const std::exception &e)
       {
         if (stopRequested_.load(std::memory_order_acquire) ||
-            !listener_ || !listener_->is_open())
+            !shard.listener || !shard.listener->is_open())
         {
           break;
         }
@@ -317,14 +422,19 @@ namespace vix::websocket
 
     for (std::size_t i = 0; i < n; ++i)
     {
+      auto ioc = shards_[i].ioc;
+
       ioThreads_.emplace_back(
-          [this, i]()
+          [ioc, i]()
           {
             vix::utils::console_wait_banner();
 
+            // Each shard has exactly one IO thread, which owns its core.
+            detail::this_core = i;
+
             try
             {
-              ioContext_->run();
+              ioc->run();
             }
             catch (const std::exception &e)
             {
@@ -338,8 +448,43 @@ namespace vix::websocket
     }
   }
 
+  void LowLevelServer::start_timer_thread()
+  {
+    // io_context has no timer primitive, so a ticker thread posts the wheel
+    // advance; expired callbacks then run on the IO thread of each shard.
+    timerThread_ = std::thread(
+        [this]()
+        {
+          std::vector<std::pair<std::shared_ptr<io_context>,
+                                std::shared_ptr<detail::TimerWheel>>>
+              wheels;
+          wheels.reserve(shards_.size());
+          for (const IoShard &shard : shards_)
+          {
+            wheels.emplace_back(shard.ioc, shard.timers);
+          }
+
+          const auto tick = wheels.front().second->tick();
+
+          while (!stopRequested_.load(std::memory_order_acquire))
+          {
+            std::this_thread::sleep_for(tick);
+
+            for (const auto &[ioc, timers] : wheels)
+            {
+              ioc->post(
+                  [timers = timers]()
+                  {
+                    timers->advance(detail::TimerWheel::Clock::now());
+                  });
+            }
+          }
+        });
+  }
+
   vix::async::core::task<void> LowLevelServer::handle_client(
-      std::unique_ptr<tcp_stream> stream)
+      std::unique_ptr<tcp_stream> stream,
+      std::size_t index)
   {
     if (!stream)
     {
@@ -348,12 +493,17 @@ namespace vix::websocket
 
     try
     {
+      const IoShard &shard = shards_[index];
+
       auto session = std::make_shared<Session>(
           std::move(stream),
           wsConfig_,
           router_,
           executor_,
-          ioContext_);
+          shard.ioc,
+          metrics_,
+          shard.timers,
+          index);
 
       co_await session->run();
     }
@@ -391,7 +541,7 @@ namespace vix::websocket
 
   std::size_t LowLevelServer::compute_io_thread_count() const
   {
-    return 1;
+    return shards_.size();
   }
 
   void LowLevelServer::stop_async()
@@ -404,28 +554,28 @@ namespace vix::websocket
       return;
     }
 
-    try
+    for (IoShard &shard : shards_)
     {
-      if (listener_)
+      try
+      {
+        if (shard.listener)
+        {
+          shard.listener->close();
+        }
+      }
+      catch (...)
       {
-        listener_->close();
       }
-    }
-    catch (...)
-    {
-    }
 
-    if (ioContext_)
-    {
       try
       {
-        ioContext_->net().stop();
+        shard.ioc->net().stop();
       }
       catch (...)
       {
       }
 
-      ioContext_->stop();
+      shard.ioc->stop();
     }
   }
 
@@ -441,11 +591,11 @@ namespace vix::websocket
     const std::thread::id current_id = std::this_thread::get_id();
     bool deferred_completion = false;
 
-    if (ioContext_)
+    for (IoShard &shard : shards_)
     {
       try
       {
-        ioContext_->net().join();
+        shard.ioc->net().join();
       }
       catch (...)
       {
@@ -475,9 +625,24 @@ namespace vix::websocket
 
     ioThreads_.clear();
 
-    if (!deferred_completion && ioContext_)
+    if (timerThread_.joinable())
+    {
+      if (timerThread_.get_id() == current_id)
+      {
+        timerThread_.detach();
+      }
+      else
+      {
+        timerThread_.join();
+      }
+    }
+
+    if (!deferred_completion)
     {
-      ioContext_->shutdown();
+      for (IoShard &shard : shards_)
+      {
+        shard.ioc->shutdown();
+      }
     }
 
     if (!deferred_completion)
@@ -0,0 +1,55 @@
+#ifndef VIX_WEBSOCKET_TESTS_STORE_TEST_SUPPORT_HPP
+#define VIX_WEBSOCKET_TESTS_STORE_TEST_SUPPORT_HPP
+
+// Fixtures shared by the message store tests.
+
+#include <vix/websocket/MessageId.hpp>
+#include <vix/websocket/MessageStore.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace store_test
+{
+  /** Temp path for one test, cleared of anything an earlier run left there. */
+  inline std::string fresh_path(const std::string &name)
+  {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / ("vix_ws_" + name);
+    for (const char *suffix : {"", "-wal", "-shm"})
+    {
+      std::filesystem::remove_all(path.string() + suffix);
+    }
+    return path.string();
+  }
+
+  inline std::string make_id(std::uint64_t n)
+  {
+    return vix::websocket::detail::MonotonicIdGenerator::format(n);
+  }
+
+  inline vix::websocket::JsonMessage make_message(std::uint64_t n, const std::string &room)
+  {
+    vix::websocket::JsonMessage m;
+    m.id = make_id(n);
+    m.kind = "event";
+    m.room = room;
+    m.type = "chat";
+    m.ts = "2025-01-01T00:00:00Z";
+    m.payload = vix::json::kvs{"n", static_cast<long long>(n), "text", "hello"};
+    return m;
+  }
+
+  inline std::vector<std::string> ids_of(const std::vector<vix::websocket::JsonMessage> &messages)
+  {
+    std::vector<std::string> ids;
+    for (const auto &m : messages)
+    {
+      ids.push_back(m.id);
+    }
+    return ids;
+  }
+} // namespace store_test
+
+#endif // VIX_WEBSOCKET_TESTS_STORE_TEST_SUPPORT_HPP
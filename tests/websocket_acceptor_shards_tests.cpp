@@ -0,0 +1,174 @@
+#include <vix/config/Config.hpp>
+#include <vix/executor/RuntimeExecutor.hpp>
+#include <vix/websocket/ReusePort.hpp>
+#include <vix/websocket/websocket.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+#if !defined(_WIN32)
+  constexpr std::size_t SHARDS = 4;
+
+  std::string write_env(std::uint16_t port, std::size_t acceptors, bool sharedNothing = false)
+  {
+    const fs::path path = fs::temp_directory_path() / "vix_ws_acceptor_shards_tests.env";
+    std::ofstream out(path);
+    out << "WEBSOCKET_HOST=127.0.0.1\n"
+        << "WEBSOCKET_PORT=" << port << "\n"
+        << "WEBSOCKET_ACCEPTOR_THREADS=" << acceptors << "\n"
+        << "WEBSOCKET_SHARED_NOTHING=" << (sharedNothing ? "true" : "false") << "\n";
+    return path.string();
+  }
+
+  std::uint16_t free_port()
+  {
+    return ws::detail::ReusePortSocket::bind("127.0.0.1", 0).port();
+  }
+
+  int connect_to(std::uint16_t port)
+  {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  std::size_t shards_with_connections(const ws::LowLevelServer &engine)
+  {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < engine.shard_count(); ++i)
+    {
+      if (engine.accepted_count(i) > 0)
+      {
+        ++n;
+      }
+    }
+    return n;
+  }
+
+  void test_shards_accept_connections()
+  {
+    const std::uint16_t port = free_port();
+    vix::config::Config config{write_env(port, SHARDS)};
+    auto executor = std::make_shared<vix::executor::RuntimeExecutor>(1u);
+
+#if VIX_WEBSOCKET_REUSE_PORT
+    ws::LowLevelServer engine(config, executor, std::make_shared<ws::Router>());
+    expect_true(engine.shard_count() == SHARDS, "one shard per acceptor thread");
+
+    engine.run();
+
+    // Shards other than the first start listening once it holds the port,
+    // so keep connecting until the kernel has spread a batch across them.
+    for (int round = 0; round < 100 && shards_with_connections(engine) < 2; ++round)
+    {
+      std::vector<int> clients;
+      for (int i = 0; i < 16; ++i)
+      {
+        clients.push_back(connect_to(port));
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+      for (int fd : clients)
+      {
+        if (fd >= 0)
+          ::close(fd);
+      }
+    }
+
+    expect_true(shards_with_connections(engine) >= 2, "more than one shard accepts connections");
+
+    engine.stop_async();
+    engine.join_threads();
+#else
+    bool refused = false;
+    try
+    {
+      ws::LowLevelServer engine(config, executor, std::make_shared<ws::Router>());
+    }
+    catch (const std::invalid_argument &)
+    {
+      refused = true;
+    }
+    expect_true(refused, "acceptor_threads > 1 is refused without SO_REUSEPORT support");
+#endif
+  }
+
+  void test_shared_nothing_needs_several_shards()
+  {
+    vix::config::Config config{write_env(free_port(), 1, true)};
+    auto executor = std::make_shared<vix::executor::RuntimeExecutor>(1u);
+
+    bool refused = false;
+    try
+    {
+      ws::LowLevelServer engine(config, executor, std::make_shared<ws::Router>());
+    }
+    catch (const std::invalid_argument &)
+    {
+      refused = true;
+    }
+    expect_true(refused, "shared_nothing with a single shard is refused");
+  }
+#endif
+}
+
+int main()
+{
+#if !defined(_WIN32)
+  test_shards_accept_connections();
+  test_shared_nothing_needs_several_shards();
+#endif
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_acceptor_shards_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_acceptor_shards_tests passed\n";
+  return EXIT_SUCCESS;
+}
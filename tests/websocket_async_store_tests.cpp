@@ -0,0 +1,354 @@
+#include <vix/websocket/AsyncMessageStore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  namespace ws = vix::websocket;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  /** In-memory store whose append() can be held back or made to throw. */
+  class FakeStore : public ws::IMessageStore
+  {
+  public:
+    void append(const ws::JsonMessage &msg) override
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]()
+               { return open_; });
+
+      if (msg.type == "fail")
+      {
+        throw std::runtime_error("disk full");
+      }
+      ids_.push_back(msg.id);
+    }
+
+    std::vector<ws::JsonMessage> list_by_room(
+        const std::string &,
+        std::size_t,
+        const std::optional<std::string> &) override
+    {
+      return {};
+    }
+
+    std::vector<ws::JsonMessage> replay_from(const std::string &, std::size_t) override
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<ws::JsonMessage> out;
+      for (const auto &id : ids_)
+      {
+        ws::JsonMessage m;
+        m.id = id;
+        out.push_back(m);
+      }
+      return out;
+    }
+
+    void hold()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = false;
+    }
+
+    void release()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+      }
+      cv_.notify_all();
+    }
+
+    std::vector<std::string> ids()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return ids_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_{true};
+    std::vector<std::string> ids_;
+  };
+
+  ws::JsonMessage make_message(int n, const std::string &type = "chat")
+  {
+    ws::JsonMessage m;
+    m.id = std::to_string(n);
+    m.room = "r";
+    m.type = type;
+    return m;
+  }
+
+  void wait_for_depth(const ws::AsyncMessageStore &store, std::size_t depth)
+  {
+    for (int i = 0; i < 2000 && store.depth() != depth; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  void test_order_callbacks_and_flush()
+  {
+    FakeStore inner;
+    ws::AsyncMessageStore store(inner);
+
+    std::atomic<int> stored{0};
+    for (int n = 0; n < 100; ++n)
+    {
+      store.append(make_message(n), [&stored](const ws::StoreReceipt &r)
+                   { stored += r.ok() ? 1 : 0; });
+    }
+    store.flush();
+
+    std::vector<std::string> expected;
+    for (int n = 0; n < 100; ++n)
+    {
+      expected.push_back(std::to_string(n));
+    }
+    expect_true(inner.ids() == expected, "order: writes reach the store in submission order");
+    expect_true(stored.load() == 100, "callbacks: every write reported stored");
+    expect_true(store.depth() == 0 && store.completed() == 100, "flush: queue drained");
+    expect_true(store.replay_from("", 1000).size() == 100, "reads: pass through to the inner store");
+  }
+
+  void test_reads_see_queued_writes()
+  {
+    FakeStore inner;
+    ws::AsyncMessageStore store(inner);
+
+    inner.hold();
+    for (int n = 0; n < 10; ++n)
+    {
+      store.append(make_message(n));
+    }
+
+    std::thread releaser([&inner]()
+                         {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                           inner.release(); });
+    const auto replayed = store.replay_from("", 1000);
+    releaser.join();
+
+    expect_true(replayed.size() == 10, "reads: wait for writes queued before them");
+  }
+
+  void test_failure_and_future()
+  {
+    FakeStore inner;
+    ws::WebSocketMetrics metrics;
+    ws::AsyncMessageStore store(inner, {}, &metrics);
+
+    auto failed = store.append_future(make_message(1, "fail"));
+    auto stored = store.append_future(make_message(2));
+
+    const ws::StoreReceipt a = failed.get();
+    const ws::StoreReceipt b = stored.get();
+    expect_true(a.status == ws::StoreWriteStatus::Failed && a.error == "disk full",
+                "failure: exception reported in the receipt");
+    expect_true(b.ok(), "failure: later writes still stored");
+    expect_true(metrics.store_writes_total.load() == 2 &&
+                    metrics.store_write_failures_total.load() == 1,
+                "metrics: writes and failures counted");
+  }
+
+  void test_reject_when_full()
+  {
+    FakeStore inner;
+    ws::WebSocketMetrics metrics;
+    ws::AsyncStoreOptions options;
+    options.capacity = 4;
+    options.blockWhenFull = false;
+    ws::AsyncMessageStore store(inner, options, &metrics);
+
+    inner.hold();
+    int accepted = 0;
+    for (int n = 0; n < 10; ++n)
+    {
+      accepted += store.append(make_message(n), {}) ? 1 : 0;
+    }
+
+    expect_true(accepted == 4, "full: capacity bounds accepted writes");
+    expect_true(store.depth() == 4 && store.high_water() == 4, "full: depth and high water");
+    expect_true(metrics.store_queue_depth.load() == 4 &&
+                    metrics.store_writes_rejected_total.load() == 6,
+                "metrics: depth gauge and rejections");
+
+    ws::StoreReceipt rejected;
+    store.append(make_message(99), [&rejected](const ws::StoreReceipt &r)
+                 { rejected = r; });
+    expect_true(rejected.status == ws::StoreWriteStatus::Rejected, "full: callback runs inline on reject");
+
+    inner.release();
+    store.flush();
+    expect_true(inner.ids().size() == 4 && store.depth() == 0, "full: accepted writes stored");
+    expect_true(metrics.store_queue_depth.load() == 0 && metrics.store_queue_high_water.load() == 4,
+                "metrics: depth gauge returns to zero");
+  }
+
+  void test_block_when_full()
+  {
+    FakeStore inner;
+    ws::AsyncStoreOptions options;
+    options.capacity = 1;
+    ws::AsyncMessageStore store(inner, options);
+
+    // The write being stored still holds its slot.
+    inner.hold();
+    store.append(make_message(0));
+    wait_for_depth(store, 1);
+
+    std::atomic<bool> done{false};
+    std::thread producer([&]()
+                         {
+                           store.append(make_message(1));
+                           done = true; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    expect_true(!done.load(), "block: producer waits while the queue is full");
+
+    inner.release();
+    producer.join();
+    store.flush();
+    expect_true(inner.ids() == std::vector<std::string>{"0", "1"}, "block: every write stored");
+  }
+
+  void test_shutdown_drains()
+  {
+    FakeStore inner;
+    ws::AsyncMessageStore store(inner);
+
+    inner.hold();
+    for (int n = 0; n < 50; ++n)
+    {
+      store.append(make_message(n));
+    }
+
+    std::thread releaser([&inner]()
+                         {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                           inner.release(); });
+    store.shutdown();
+    releaser.join();
+
+    expect_true(inner.ids().size() == 50, "shutdown: queued writes drained");
+    expect_true(!store.append(make_message(50), {}), "shutdown: later writes rejected");
+    store.shutdown();
+  }
+
+  void test_shutdown_from_callback()
+  {
+    FakeStore inner;
+    {
+      ws::AsyncMessageStore store(inner);
+
+      std::atomic<bool> rejected{false};
+      inner.hold();
+      store.append(make_message(0), [&store, &rejected](const ws::StoreReceipt &)
+                   {
+                     store.shutdown();
+                     rejected = !store.append(make_message(1), {}); });
+      store.append(make_message(2));
+      inner.release();
+
+      // The destructor on this thread joins the writer the callback stopped.
+      store.flush();
+      expect_true(rejected.load(), "callback shutdown: later writes rejected");
+    }
+
+    expect_true(inner.ids().size() == 2, "callback shutdown: queued writes still stored");
+  }
+
+  void test_append_from_callback_when_full()
+  {
+    FakeStore inner;
+    ws::AsyncStoreOptions options;
+    options.capacity = 1;
+    ws::AsyncMessageStore store(inner, options);
+
+    // The write whose callback runs still holds the only slot.
+    std::atomic<bool> accepted{true};
+    store.append(make_message(0), [&store, &accepted](const ws::StoreReceipt &)
+                 { accepted = store.append(make_message(1), {}); });
+    store.flush();
+
+    expect_true(!accepted.load(), "callback append: rejected instead of waiting on the writer");
+    expect_true(inner.ids() == std::vector<std::string>{"0"}, "callback append: first write stored");
+  }
+
+  void test_concurrent_producers()
+  {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 5000;
+
+    FakeStore inner;
+    ws::AsyncStoreOptions options;
+    options.capacity = 64;
+    ws::AsyncMessageStore store(inner, options);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+      threads.emplace_back([&store, t]()
+                           {
+                             for (int i = 0; i < PER_THREAD; ++i)
+                             {
+                               store.append(make_message(t * PER_THREAD + i));
+                             } });
+    }
+    for (auto &t : threads)
+    {
+      t.join();
+    }
+    store.flush();
+
+    expect_true(inner.ids().size() == THREADS * PER_THREAD, "concurrent: every write stored");
+    expect_true(store.high_water() <= options.capacity, "concurrent: queue stays bounded");
+  }
+}
+
+int main()
+{
+  test_order_callbacks_and_flush();
+  test_reads_see_queued_writes();
+  test_failure_and_future();
+  test_reject_when_full();
+  test_block_when_full();
+  test_shutdown_drains();
+  test_shutdown_from_callback();
+  test_append_from_callback_when_full();
+  test_concurrent_producers();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_async_store_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_async_store_tests passed\n";
+  return EXIT_SUCCESS;
+}
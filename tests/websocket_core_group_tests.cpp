@@ -0,0 +1,379 @@
+#include <vix/websocket/CoreGroup.hpp>
+#include <vix/websocket/MpscQueue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  namespace detail = vix::websocket::detail;
+
+  struct FakeSession
+  {
+    std::size_t core{0};
+    std::atomic<int> received{0};
+    std::atomic<int> wrongCore{0};
+  };
+
+  using Group = detail::BasicCoreGroup<FakeSession>;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  /** Runs posted work on the calling thread, as if it were @p core. */
+  void run_inline(std::size_t core, std::function<void()> fn)
+  {
+    const std::size_t previous = detail::this_core;
+    detail::this_core = core;
+    fn();
+    detail::this_core = previous;
+  }
+
+  /** One worker thread per core, standing in for the IO shards. */
+  class Workers
+  {
+  public:
+    explicit Workers(std::size_t n)
+        : queues_(n)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        threads_.emplace_back(
+            [this, i]()
+            {
+              detail::this_core = i;
+              Queue &q = queues_[i];
+
+              while (true)
+              {
+                std::function<void()> fn;
+                {
+                  std::unique_lock<std::mutex> lock(q.mutex);
+                  q.cv.wait(lock, [&]()
+                            { return q.stop || !q.work.empty(); });
+                  if (q.work.empty())
+                  {
+                    return;
+                  }
+                  fn = std::move(q.work.front());
+                  q.work.pop_front();
+                }
+                fn();
+              }
+            });
+      }
+    }
+
+    ~Workers()
+    {
+      join();
+    }
+
+    /** Finish posted work and stop the threads. */
+    void join()
+    {
+      for (Queue &q : queues_)
+      {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.stop = true;
+        q.cv.notify_all();
+      }
+      for (auto &t : threads_)
+      {
+        t.join();
+      }
+      threads_.clear();
+    }
+
+    void post(std::size_t core, std::function<void()> fn)
+    {
+      Queue &q = queues_[core];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.work.push_back(std::move(fn));
+      q.cv.notify_one();
+    }
+
+  private:
+    struct Queue
+    {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::deque<std::function<void()>> work;
+      bool stop{false};
+    };
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+  };
+
+  int room_size(Group &group, const std::string &room)
+  {
+    auto n = std::make_shared<int>(0);
+    group.broadcast_room(room, [n](FakeSession &)
+                         { ++*n; });
+    return *n;
+  }
+
+  bool wait_for(const std::function<bool()> &done)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  void test_mpsc_queue()
+  {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+
+    detail::MpscQueue<int> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+      producers.emplace_back(
+          [&queue, p]()
+          {
+            for (int i = 0; i < PER_PRODUCER; ++i)
+            {
+              queue.push(p * PER_PRODUCER + i);
+            }
+          });
+    }
+
+    std::vector<int> last(PRODUCERS, -1);
+    int popped = 0;
+    bool ordered = true;
+    while (popped < PRODUCERS * PER_PRODUCER)
+    {
+      int value = 0;
+      if (!queue.pop(value))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      const int p = value / PER_PRODUCER;
+      const int i = value % PER_PRODUCER;
+      ordered = ordered && i == last[p] + 1;
+      last[p] = i;
+      ++popped;
+    }
+
+    for (auto &t : producers)
+    {
+      t.join();
+    }
+
+    expect_true(ordered, "mpsc keeps per-producer order");
+    expect_true(queue.empty(), "mpsc drained");
+  }
+
+  void test_membership()
+  {
+    Group group(2, run_inline);
+    auto a = std::make_shared<FakeSession>();
+    auto b = std::make_shared<FakeSession>();
+    b->core = 1;
+
+    group.add(a->core, a);
+    group.add(b->core, b);
+    group.add(a->core, a);
+    expect_true(group.session_count() == 2, "add is idempotent");
+
+    group.join(a->core, a, "lobby");
+    group.join(a->core, a, "lobby");
+    group.join(b->core, b, "lobby");
+    group.join(b->core, b, "games");
+    expect_true(room_size(group, "lobby") == 2, "room spans both cores");
+
+    group.leave(a->core, a.get(), "lobby");
+    expect_true(room_size(group, "lobby") == 1, "leave removes one member");
+
+    group.leave_all(b->core, b.get());
+    expect_true(room_size(group, "lobby") == 0, "leave_all empties lobby");
+    expect_true(room_size(group, "games") == 0, "leave_all empties games");
+    expect_true(group.session_count() == 2, "leave_all keeps sessions");
+
+    group.join(b->core, b, "games");
+    group.remove(b->core, b.get());
+    expect_true(room_size(group, "games") == 0, "remove drops memberships");
+    expect_true(group.session_count() == 1, "remove forgets the session");
+
+    group.add(7, b);
+    expect_true(group.session_count() == 1, "unknown core is ignored");
+  }
+
+  void test_expired_sessions_are_pruned()
+  {
+    Group group(1, run_inline);
+    auto a = std::make_shared<FakeSession>();
+    auto b = std::make_shared<FakeSession>();
+
+    group.join(0, a, "lobby");
+    group.join(0, b, "lobby");
+    b.reset();
+
+    int seen = 0;
+    group.broadcast([&seen](FakeSession &)
+                    { ++seen; });
+    expect_true(seen == 1, "broadcast skips expired sessions");
+    expect_true(group.session_count() == 1, "broadcast prunes expired sessions");
+    expect_true(room_size(group, "lobby") == 1, "room keeps live members");
+  }
+
+  void test_reused_address()
+  {
+    Group group(1, run_inline);
+    FakeSession storage;
+    const auto noop = [](FakeSession *) {};
+
+    // Died without remove(); a new session then reuses the address.
+    auto old = std::shared_ptr<FakeSession>(&storage, noop);
+    group.join(0, old, "lobby");
+    old.reset();
+
+    auto next = std::shared_ptr<FakeSession>(&storage, noop);
+    group.add(0, next);
+    expect_true(group.session_count() == 1, "reused address is owned once");
+    expect_true(room_size(group, "lobby") == 0, "rooms of the dead session are left");
+
+    group.join(0, next, "lobby");
+    expect_true(room_size(group, "lobby") == 1, "join after reuse adds the new session");
+
+    int seen = 0;
+    group.broadcast([&seen](FakeSession &)
+                    { ++seen; });
+    expect_true(seen == 1, "reused address stores the new session");
+  }
+
+  void test_cross_core_broadcast()
+  {
+    constexpr std::size_t CORES = 4;
+    constexpr std::size_t PER_CORE = 50;
+    constexpr int SENDERS = 3;
+    constexpr int BROADCASTS = 200;
+
+    Workers workers(CORES);
+    Group group(CORES, [&workers](std::size_t core, std::function<void()> fn)
+                { workers.post(core, std::move(fn)); });
+
+    std::vector<std::shared_ptr<FakeSession>> sessions;
+    for (std::size_t c = 0; c < CORES; ++c)
+    {
+      for (std::size_t i = 0; i < PER_CORE; ++i)
+      {
+        auto s = std::make_shared<FakeSession>();
+        s->core = c;
+        group.add(c, s);
+        if (i % 2 == 0)
+        {
+          group.join(c, s, "even");
+        }
+        sessions.push_back(std::move(s));
+      }
+    }
+
+    expect_true(wait_for([&]()
+                         { return group.session_count() == CORES * PER_CORE; }),
+                "sessions registered on their cores");
+
+    auto deliver = [](FakeSession &s)
+    {
+      if (detail::this_core != s.core)
+      {
+        s.wrongCore.fetch_add(1, std::memory_order_relaxed);
+      }
+      s.received.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> senders;
+    for (int t = 0; t < SENDERS; ++t)
+    {
+      senders.emplace_back(
+          [&]()
+          {
+            for (int i = 0; i < BROADCASTS; ++i)
+            {
+              group.broadcast(deliver);
+              group.broadcast_room("even", deliver);
+            }
+          });
+    }
+    for (auto &t : senders)
+    {
+      t.join();
+    }
+
+    const int all = SENDERS * BROADCASTS;
+    const bool delivered = wait_for(
+        [&]()
+        {
+          for (std::size_t i = 0; i < sessions.size(); ++i)
+          {
+            const int expected = (i % PER_CORE) % 2 == 0 ? 2 * all : all;
+            if (sessions[i]->received.load() != expected)
+            {
+              return false;
+            }
+          }
+          return true;
+        });
+    expect_true(delivered, "every broadcast reaches every member exactly once");
+
+    int wrong = 0;
+    for (const auto &s : sessions)
+    {
+      wrong += s->wrongCore.load();
+    }
+    expect_true(wrong == 0, "sessions are only touched by their own core");
+
+    // The group must not be destroyed under a running drain.
+    workers.join();
+  }
+}
+
+int main()
+{
+  test_mpsc_queue();
+  test_membership();
+  test_expired_sessions_are_pruned();
+  test_reused_address();
+  test_cross_core_broadcast();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_core_group_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_core_group_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+#include <vix/websocket/deflate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+  using vix::websocket::detail::DeflateParams;
+  using vix::websocket::detail::negotiate_permessage_deflate;
+  using vix::websocket::detail::PerMessageDeflate;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  std::span<const std::byte> bytes(std::string_view s)
+  {
+    return {reinterpret_cast<const std::byte *>(s.data()), s.size()};
+  }
+
+  std::string sample_json(int n)
+  {
+    std::string s;
+    for (int i = 0; i < n; ++i)
+    {
+      s += R"({"type":"chat.message","payload":{"room":"general","user":"alice","text":"hello )";
+      s += std::to_string(i);
+      s += R"("}})";
+    }
+    return s;
+  }
+
+  void test_negotiation()
+  {
+    const DeflateParams policy{};
+
+    auto plain = negotiate_permessage_deflate("permessage-deflate; client_max_window_bits", policy);
+    expect_true(plain.has_value(), "basic offer accepted");
+    expect_true(plain && plain->responseHeader == "permessage-deflate",
+                "client_max_window_bits without value is not echoed");
+
+    auto bits = negotiate_permessage_deflate(
+        "permessage-deflate; server_max_window_bits=10; server_no_context_takeover", policy);
+    expect_true(bits && bits->params.serverMaxWindowBits == 10, "server window bits honoured");
+    expect_true(bits && bits->params.serverNoContextTakeover, "server_no_context_takeover honoured");
+    expect_true(bits &&
+                    bits->responseHeader ==
+                        "permessage-deflate; server_no_context_takeover; server_max_window_bits=10",
+                "response lists accepted parameters");
+
+    auto fallback = negotiate_permessage_deflate(
+        "permessage-deflate; unknown_param, permessage-deflate; server_max_window_bits=8, "
+        "permessage-deflate; client_no_context_takeover",
+        policy);
+    expect_true(fallback && fallback->params.clientNoContextTakeover,
+                "invalid offers are skipped in favour of the next one");
+
+    expect_true(!negotiate_permessage_deflate("x-webkit-deflate-frame", policy),
+                "unrelated extensions are ignored");
+    expect_true(!negotiate_permessage_deflate("permessage-deflate; server_max_window_bits", policy),
+                "server_max_window_bits requires a value");
+
+    DeflateParams strict{};
+    strict.serverNoContextTakeover = true;
+    strict.serverMaxWindowBits = 12;
+    auto forced = negotiate_permessage_deflate("permessage-deflate", strict);
+    expect_true(forced &&
+                    forced->responseHeader ==
+                        "permessage-deflate; server_no_context_takeover; server_max_window_bits=12",
+                "server policy is applied and announced");
+  }
+
+  void test_round_trip(bool noContextTakeover)
+  {
+    DeflateParams params{};
+    params.serverNoContextTakeover = noContextTakeover;
+    params.clientNoContextTakeover = noContextTakeover;
+
+    // The receiving codec plays the peer: it inflates what we deflate.
+    PerMessageDeflate sender(params);
+    PerMessageDeflate receiver(params);
+
+    for (int round = 0; round < 3; ++round)
+    {
+      const std::string message = sample_json(50 + round);
+
+      std::string wire;
+      sender.compress(bytes(message), wire);
+      expect_true(wire.size() * 4 < message.size(), "json traffic compresses well");
+
+      std::string inflated;
+      receiver.decompress(bytes(wire), true, inflated, 1 << 20);
+      expect_true(inflated == message, "round trip restores the message");
+    }
+  }
+
+  void test_chunked_inflate()
+  {
+    PerMessageDeflate sender(DeflateParams{});
+    PerMessageDeflate receiver(DeflateParams{});
+
+    const std::string message = sample_json(400);
+    std::string wire;
+    sender.compress(bytes(message), wire);
+
+    std::string inflated;
+    for (std::size_t pos = 0; pos < wire.size(); pos += 7)
+    {
+      const std::size_t n = std::min<std::size_t>(7, wire.size() - pos);
+      receiver.decompress(bytes(std::string_view(wire).substr(pos, n)),
+                          pos + n == wire.size(),
+                          inflated,
+                          1 << 20);
+    }
+
+    expect_true(inflated == message, "chunked inflate matches one-shot inflate");
+  }
+
+  void test_inflate_limit()
+  {
+    PerMessageDeflate sender(DeflateParams{});
+    PerMessageDeflate receiver(DeflateParams{});
+
+    const std::string message(1 << 20, 'a');
+    std::string wire;
+    sender.compress(bytes(message), wire);
+
+    bool threw = false;
+    try
+    {
+      std::string inflated;
+      receiver.decompress(bytes(wire), true, inflated, 64 * 1024);
+    }
+    catch (const std::runtime_error &)
+    {
+      threw = true;
+    }
+
+    expect_true(threw, "inflating past maxMessageSize is rejected");
+  }
+}
+
+int main()
+{
+  test_negotiation();
+  test_round_trip(false);
+  test_round_trip(true);
+  test_chunked_inflate();
+  test_inflate_limit();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_deflate_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_deflate_tests passed\n";
+  return EXIT_SUCCESS;
+}
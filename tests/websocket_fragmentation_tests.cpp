@@ -0,0 +1,128 @@
+#include <vix/websocket/MessageAssembler.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+  using vix::websocket::detail::MessageAssembler;
+  using vix::websocket::detail::Opcode;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  template <typename Fn>
+  bool throws(Fn &&fn)
+  {
+    try
+    {
+      fn();
+    }
+    catch (const std::runtime_error &)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  void feed(MessageAssembler &a, Opcode op, bool fin, std::string_view part)
+  {
+    a.begin_frame(op, fin, part.size());
+    a.append(vix::websocket::detail::as_byte_span(part));
+  }
+
+  void test_reassembles_fragments()
+  {
+    MessageAssembler a(1024);
+
+    feed(a, Opcode::Text, false, "hel");
+    expect_true(a.in_progress(), "message in progress after first fragment");
+
+    feed(a, Opcode::Continuation, false, "lo ");
+    feed(a, Opcode::Continuation, true, "world");
+
+    expect_true(!a.in_progress(), "message complete after FIN fragment");
+    expect_true(a.opcode() == Opcode::Text, "continuations keep the initial opcode");
+    expect_true(a.take() == "hello world", "fragments reassembled in order");
+  }
+
+  void test_binary_opcode_is_tracked()
+  {
+    MessageAssembler a(1024);
+
+    const Opcode first = a.begin_frame(Opcode::Binary, false, 4);
+    const Opcode next = a.begin_frame(Opcode::Continuation, true, 4);
+
+    expect_true(first == Opcode::Binary, "binary message opcode");
+    expect_true(next == Opcode::Binary, "continuation reports message opcode");
+  }
+
+  void test_sequence_violations()
+  {
+    MessageAssembler a(1024);
+    expect_true(throws([&]
+                       { a.begin_frame(Opcode::Continuation, true, 1); }),
+                "continuation without a message is rejected");
+
+    a.reset();
+    a.begin_frame(Opcode::Text, false, 1);
+    expect_true(throws([&]
+                       { a.begin_frame(Opcode::Text, true, 1); }),
+                "new data frame inside a fragmented message is rejected");
+
+    a.reset();
+    expect_true(throws([&]
+                       { a.begin_frame(Opcode::Ping, true, 0); }),
+                "control frames are not fragments");
+  }
+
+  void test_size_limit_spans_fragments()
+  {
+    MessageAssembler a(10);
+
+    a.begin_frame(Opcode::Text, false, 6);
+    expect_true(throws([&]
+                       { a.begin_frame(Opcode::Continuation, true, 5); }),
+                "limit enforced on the sum of fragments");
+
+    a.reset();
+    a.begin_frame(Opcode::Text, false, 6);
+    a.begin_frame(Opcode::Continuation, true, 4);
+    expect_true(a.message_size() == 10, "message exactly at the limit is accepted");
+
+    a.begin_frame(Opcode::Text, true, 10);
+    expect_true(a.message_size() == 10, "size accounting restarts for each message");
+  }
+}
+
+int main()
+{
+  test_reassembles_fragments();
+  test_binary_opcode_is_tracked();
+  test_sequence_violations();
+  test_size_limit_spans_fragments();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_fragmentation_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_fragmentation_tests passed\n";
+  return EXIT_SUCCESS;
+}
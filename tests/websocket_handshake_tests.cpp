@@ -0,0 +1,157 @@
+#include <vix/websocket/handshake.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::Sha1Kernel;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  const std::array<Sha1Kernel, 3> all_kernels = {
+      Sha1Kernel::Scalar,
+      Sha1Kernel::ShaNi,
+      Sha1Kernel::ArmSha,
+  };
+
+  const unsigned char *bytes(const std::string &s)
+  {
+    return reinterpret_cast<const unsigned char *>(s.data());
+  }
+
+  std::string hex(const vix::websocket::detail::Sha1Digest &d)
+  {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (unsigned char c : d)
+    {
+      out.push_back(digits[c >> 4]);
+      out.push_back(digits[c & 15]);
+    }
+    return out;
+  }
+
+  std::string base64(const std::string &s)
+  {
+    std::string out(vix::websocket::detail::base64_encoded_size(s.size()), '\0');
+    vix::websocket::detail::base64_encode_to(bytes(s), s.size(), out.data());
+    return out;
+  }
+
+  std::string accept(const std::string &key)
+  {
+    const auto a = vix::websocket::detail::websocket_accept_key(key);
+    return std::string(a.data(), a.size());
+  }
+
+  void test_sha1_vectors()
+  {
+    const std::string millionA(1000000, 'a');
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+        {"abc", "a9993e364706816aba3e25717850c26c9cd0d89d"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "84983e441c3bd26ebaae4aa1f95129e5e54670f1"},
+        {millionA, "34aa973cd4c4daa4f61eeb2bdbad27316534016f"},
+    };
+
+    for (const auto &[input, expected] : cases)
+    {
+      for (Sha1Kernel kernel : all_kernels)
+      {
+        const auto digest = vix::websocket::detail::sha1_digest_with(kernel, bytes(input), input.size());
+        expect_true(hex(digest) == expected,
+                    std::string("sha1 vector of ") + std::to_string(input.size()) +
+                        " bytes (" + vix::websocket::detail::sha1_kernel_name(kernel) + ")");
+      }
+    }
+  }
+
+  void test_kernels_agree_on_every_length()
+  {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    std::string input;
+    for (std::size_t len = 0; len <= 300; ++len)
+    {
+      const auto reference = vix::websocket::detail::sha1_digest_with(Sha1Kernel::Scalar, bytes(input), len);
+
+      for (Sha1Kernel kernel : all_kernels)
+      {
+        expect_true(vix::websocket::detail::sha1_digest_with(kernel, bytes(input), len) == reference,
+                    "kernel agrees at length " + std::to_string(len));
+      }
+
+      expect_true(vix::websocket::detail::sha1_digest(bytes(input), len) == reference,
+                  "dispatched digest agrees at length " + std::to_string(len));
+
+      input.push_back(static_cast<char>(byte(rng)));
+    }
+  }
+
+  void test_base64()
+  {
+    expect_true(base64("").empty(), "base64 empty");
+    expect_true(base64("f") == "Zg==", "base64 one byte");
+    expect_true(base64("fo") == "Zm8=", "base64 two bytes");
+    expect_true(base64("foo") == "Zm9v", "base64 three bytes");
+    expect_true(base64("foobar") == "Zm9vYmFy", "base64 six bytes");
+    expect_true(base64(std::string("\xff\xfe\x00", 3)) == "//4A", "base64 high bytes");
+  }
+
+  void test_accept_key()
+  {
+    // RFC 6455 section 1.3.
+    expect_true(accept("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", "rfc accept key");
+
+    // Other key lengths take the streaming path; compare against hashing
+    // the concatenation directly.
+    for (std::size_t len : {0u, 1u, 23u, 25u, 28u, 60u, 200u})
+    {
+      const std::string key(len, 'k');
+      const std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+      const auto digest = vix::websocket::detail::sha1_digest(bytes(input), input.size());
+      const std::string expected =
+          base64(std::string(reinterpret_cast<const char *>(digest.data()), digest.size()));
+
+      expect_true(accept(key) == expected, "accept key of length " + std::to_string(len));
+    }
+  }
+}
+
+int main()
+{
+  test_sha1_vectors();
+  test_kernels_agree_on_every_length();
+  test_base64();
+  test_accept_key();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_handshake_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_handshake_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,283 @@
+#include <vix/websocket/LogMessageStore.hpp>
+
+#include "store_test_support.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace
+{
+  namespace ws = vix::websocket;
+  namespace fs = std::filesystem;
+  using namespace store_test;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  std::vector<std::string> id_range(std::uint64_t from, std::uint64_t to, std::uint64_t step = 1)
+  {
+    std::vector<std::string> ids;
+    for (std::uint64_t n = from; n != to; n += step)
+    {
+      ids.push_back(make_id(n));
+    }
+    return ids;
+  }
+
+  void test_append_list_and_replay()
+  {
+    ws::LogStoreOptions options;
+    options.indexInterval = 4;
+    ws::LogMessageStore store(fresh_path("log_basic"), options);
+
+    // Rooms alternate, so each room's records are interleaved in the log.
+    for (std::uint64_t n = 1; n <= 40; ++n)
+    {
+      store.append(make_message(n, n % 2 == 0 ? "even" : "odd"));
+    }
+    expect_true(store.size() == 40, "basic: size counts records");
+
+    const auto latest = store.list_by_room("even", 3);
+    expect_true(ids_of(latest) == std::vector<std::string>{make_id(40), make_id(38), make_id(36)},
+                "basic: room page is newest first");
+
+    const auto page = store.list_by_room("odd", 3, make_id(20));
+    expect_true(ids_of(page) == std::vector<std::string>{make_id(19), make_id(17), make_id(15)},
+                "basic: page before cursor");
+
+    const auto oldest = store.list_by_room("odd", 10, make_id(4));
+    expect_true(ids_of(oldest) == std::vector<std::string>{make_id(3), make_id(1)},
+                "basic: page stops at the first record");
+
+    expect_true(store.list_by_room("none", 10).empty(), "basic: unknown room is empty");
+    expect_true(store.list_by_room("even", 0).empty(), "basic: zero limit");
+
+    expect_true(ids_of(store.replay_from(make_id(30), 5)) == id_range(31, 36),
+                "basic: replay after cursor");
+    expect_true(ids_of(store.replay_from("", 3)) == id_range(1, 4),
+                "basic: empty cursor replays from the start");
+    expect_true(store.replay_from(make_id(40), 5).empty(), "basic: replay past the end");
+
+    const auto decoded = store.list_by_room("even", 1);
+    expect_true(decoded.size() == 1 && decoded[0].room == "even" && decoded[0].type == "chat" &&
+                    decoded[0].ts == "2025-01-01T00:00:00Z",
+                "basic: fields round trip");
+    expect_true(decoded.size() == 1 && decoded[0].payload.flat.size() == 4 &&
+                    std::get<long long>(decoded[0].payload.flat[1].v) == 40 &&
+                    std::get<std::string>(decoded[0].payload.flat[3].v) == "hello",
+                "basic: payload round trip");
+  }
+
+  void test_nested_payload_and_defaults()
+  {
+    ws::LogMessageStore store(fresh_path("log_payload"));
+
+    auto inner = std::make_shared<vix::json::kvs>(vix::json::kvs{"ok", true, "ratio", 0.5});
+    auto list = std::make_shared<vix::json::array_t>();
+    list->elems.push_back(vix::json::token{1LL});
+    list->elems.push_back(vix::json::token{});
+
+    ws::JsonMessage m;
+    m.room = "r";
+    m.type = "nested";
+    m.payload = vix::json::kvs{"inner", "", "list", ""};
+    m.payload.flat[1].v = inner;
+    m.payload.flat[3].v = list;
+    store.append(m);
+    store.append(m);
+
+    const auto out = store.list_by_room("r", 2);
+    expect_true(out.size() == 2, "payload: both records listed");
+    if (out.size() != 2)
+      return;
+
+    expect_true(out[0].id.size() == 20 && out[1].id < out[0].id, "defaults: generated ids increase");
+    expect_true(out[0].kind == "event" && !out[0].ts.empty(), "defaults: kind and ts filled in");
+
+    const auto &obj = std::get<std::shared_ptr<vix::json::kvs>>(out[0].payload.flat[1].v);
+    const auto &arr = std::get<std::shared_ptr<vix::json::array_t>>(out[0].payload.flat[3].v);
+    expect_true(obj && obj->flat.size() == 4 && std::get<bool>(obj->flat[1].v) &&
+                    std::get<double>(obj->flat[3].v) == 0.5,
+                "payload: nested object round trip");
+    expect_true(arr && arr->elems.size() == 2 && std::get<long long>(arr->elems[0].v) == 1 &&
+                    std::holds_alternative<std::monostate>(arr->elems[1].v),
+                "payload: nested array round trip");
+  }
+
+  void test_segment_rollover_and_reopen()
+  {
+    const std::string dir = fresh_path("log_reopen");
+    ws::LogStoreOptions options;
+    options.segmentBytes = 4096;
+    options.indexInterval = 8;
+
+    {
+      ws::LogMessageStore store(dir, options);
+      for (std::uint64_t n = 1; n <= 300; ++n)
+      {
+        store.append(make_message(n, "room-" + std::to_string(n % 3)));
+      }
+
+      // A record above the segment size gets a segment of its own.
+      ws::JsonMessage big = make_message(301, "room-0");
+      big.payload = vix::json::kvs{"blob", std::string(10000, 'x')};
+      store.append(big);
+    }
+
+    std::size_t segments = 0;
+    for (const auto &entry : fs::directory_iterator(dir))
+    {
+      segments += entry.path().extension() == ".log" ? 1 : 0;
+    }
+    expect_true(segments > 3, "rollover: log spans several segments");
+
+    ws::LogMessageStore store(dir, options);
+    expect_true(store.size() == 301, "reopen: every record recovered");
+    expect_true(ids_of(store.replay_from("", 1000)) == id_range(1, 302),
+                "reopen: replay crosses segments in order");
+    expect_true(ids_of(store.list_by_room("room-1", 3, make_id(200))) ==
+                    std::vector<std::string>{make_id(199), make_id(196), make_id(193)},
+                "reopen: room links and cursor index rebuilt");
+
+    const auto big = store.list_by_room("room-0", 1);
+    expect_true(big.size() == 1 && big[0].id == make_id(301) &&
+                    std::get<std::string>(big[0].payload.flat[1].v).size() == 10000,
+                "rollover: oversized record readable");
+
+    // Ids continue after the stored ones.
+    ws::JsonMessage next;
+    next.room = "room-0";
+    store.append(next);
+    expect_true(store.list_by_room("room-0", 1)[0].id > make_id(301), "reopen: id generator resumes");
+  }
+
+  void test_generated_ids_follow_log_order()
+  {
+    ws::LogStoreOptions options;
+    options.indexInterval = 4;
+    ws::LogMessageStore store(fresh_path("log_generated_ids"), options);
+
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 200;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+      writers.emplace_back(
+          [&store]()
+          {
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+              ws::JsonMessage m;
+              m.room = "room";
+              store.append(m);
+            }
+          });
+    }
+    for (auto &w : writers)
+    {
+      w.join();
+    }
+
+    const auto all = ids_of(store.replay_from("", THREADS * PER_THREAD));
+    expect_true(all.size() == THREADS * PER_THREAD, "generated: every record stored");
+    expect_true(std::is_sorted(all.begin(), all.end()), "generated: ids sort in log order");
+
+    // Every cursor must resume right after itself, through the sparse index.
+    bool resumes = true;
+    for (std::size_t i = 0; i + 1 < all.size(); ++i)
+    {
+      const auto next = store.replay_from(all[i], 1);
+      resumes = resumes && next.size() == 1 && next[0].id == all[i + 1];
+    }
+    expect_true(resumes, "generated: replay resumes after every id");
+  }
+
+  void test_torn_tail()
+  {
+    const std::string dir = fresh_path("log_torn");
+    std::uint64_t tailOffset = 0;
+
+    {
+      ws::LogMessageStore store(dir);
+      for (std::uint64_t n = 1; n <= 10; ++n)
+      {
+        store.append(make_message(n, "r"));
+      }
+    }
+
+    // Corrupt one byte inside the last record, as an interrupted write would.
+    const fs::path segment = fs::path(dir) / "0000000000.log";
+    {
+      std::ifstream in(segment, std::ios::binary);
+      std::vector<char> bytes(4096);
+      in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+      std::uint64_t offset = 0;
+      for (int i = 0; i < 9; ++i)
+      {
+        const auto *p = reinterpret_cast<const unsigned char *>(bytes.data() + offset);
+        offset += 8 + (p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<std::uint32_t>(p[3]) << 24));
+      }
+      tailOffset = offset;
+    }
+    {
+      std::fstream io(segment, std::ios::binary | std::ios::in | std::ios::out);
+      io.seekp(static_cast<std::streamoff>(tailOffset + 20));
+      io.put('\x7f');
+    }
+
+    ws::LogMessageStore store(dir);
+    expect_true(store.size() == 9, "torn: damaged tail record dropped");
+    expect_true(ids_of(store.list_by_room("r", 1)) == std::vector<std::string>{make_id(9)},
+                "torn: room ends before the damaged record");
+
+    // The next append overwrites the damaged record.
+    store.append(make_message(11, "r"));
+    expect_true(ids_of(store.replay_from(make_id(8), 10)) ==
+                    std::vector<std::string>{make_id(9), make_id(11)},
+                "torn: append continues after the last good record");
+  }
+}
+
+int main()
+{
+  test_append_list_and_replay();
+  test_nested_payload_and_defaults();
+  test_segment_rollover_and_reopen();
+  test_generated_ids_follow_log_order();
+  test_torn_tail();
+
+  for (const char *name : {"basic", "payload", "reopen", "torn"})
+  {
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / (std::string("vix_ws_log_tests_") + name));
+  }
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_log_store_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_log_store_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#include <vix/websocket/mask.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::MaskKernel;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  const std::array<MaskKernel, 5> all_kernels = {
+      MaskKernel::Bytewise,
+      MaskKernel::Scalar64,
+      MaskKernel::Sse2,
+      MaskKernel::Avx2,
+      MaskKernel::Neon,
+  };
+
+  std::vector<std::byte> random_bytes(std::mt19937 &rng, std::size_t n)
+  {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<std::byte> out(n);
+    for (auto &b : out)
+    {
+      b = static_cast<std::byte>(dist(rng));
+    }
+    return out;
+  }
+
+  std::vector<std::byte> reference_mask(
+      std::vector<std::byte> data,
+      const std::array<std::byte, 4> &key,
+      std::size_t phase)
+  {
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+      data[i] ^= key[(phase + i) % 4];
+    }
+    return data;
+  }
+
+  void test_kernels_match_reference()
+  {
+    std::mt19937 rng(1234);
+    const std::array<std::byte, 4> key = {
+        std::byte{0x37}, std::byte{0xfa}, std::byte{0x21}, std::byte{0x3d}};
+
+    const std::size_t sizes[] = {0, 1, 3, 4, 7, 15, 16, 17, 31, 32, 33, 63, 64,
+                                 65, 127, 128, 129, 255, 1000, 4096, 65537};
+
+    for (MaskKernel kernel : all_kernels)
+    {
+      if (!vix::websocket::detail::mask_kernel_supported(kernel))
+      {
+        continue;
+      }
+
+      for (std::size_t size : sizes)
+      {
+        for (std::size_t offset = 0; offset < 8; ++offset)
+        {
+          for (std::size_t phase = 0; phase < 4; ++phase)
+          {
+            // Shift the view to exercise unaligned heads.
+            std::vector<std::byte> storage = random_bytes(rng, size + offset);
+            std::vector<std::byte> view(storage.begin() + static_cast<std::ptrdiff_t>(offset),
+                                        storage.end());
+            const auto expected = reference_mask(view, key, phase);
+
+            const std::size_t next = vix::websocket::detail::apply_mask_with(
+                kernel, storage.data() + offset, size, key, phase);
+
+            const bool same = std::equal(
+                expected.begin(), expected.end(),
+                storage.begin() + static_cast<std::ptrdiff_t>(offset));
+
+            expect_true(same,
+                        std::string(vix::websocket::detail::mask_kernel_name(kernel)) +
+                            " size=" + std::to_string(size) +
+                            " offset=" + std::to_string(offset) +
+                            " phase=" + std::to_string(phase));
+
+            expect_true(next == (phase + size) % 4,
+                        std::string("returned phase ") +
+                            vix::websocket::detail::mask_kernel_name(kernel));
+          }
+        }
+      }
+    }
+  }
+
+  void test_chunked_phase_continuation()
+  {
+    std::mt19937 rng(42);
+    const std::array<std::byte, 4> key = {
+        std::byte{0x01}, std::byte{0x80}, std::byte{0xff}, std::byte{0x5a}};
+
+    const auto original = random_bytes(rng, 10000);
+    const auto expected = reference_mask(original, key, 0);
+
+    std::vector<std::byte> data = original;
+    std::uniform_int_distribution<std::size_t> chunk(1, 777);
+
+    std::size_t pos = 0;
+    std::size_t phase = 0;
+    while (pos < data.size())
+    {
+      const std::size_t n = std::min(chunk(rng), data.size() - pos);
+      phase = vix::websocket::detail::apply_mask(data.data() + pos, n, key, phase);
+      pos += n;
+    }
+
+    expect_true(data == expected, "chunked unmasking matches one-shot unmasking");
+  }
+
+  void test_mask_is_involution()
+  {
+    std::mt19937 rng(7);
+    const std::array<std::byte, 4> key = {
+        std::byte{0xde}, std::byte{0xad}, std::byte{0xbe}, std::byte{0xef}};
+
+    const auto original = random_bytes(rng, 4099);
+    std::vector<std::byte> data = original;
+
+    vix::websocket::detail::apply_mask(data.data(), data.size(), key);
+    vix::websocket::detail::apply_mask(data.data(), data.size(), key);
+
+    expect_true(data == original, "masking twice restores the payload");
+  }
+}
+
+int main()
+{
+  test_kernels_match_reference();
+  test_chunked_phase_continuation();
+  test_mask_is_involution();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_mask_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_mask_tests passed (active kernel: "
+            << vix::websocket::detail::mask_kernel_name(
+                   vix::websocket::detail::active_mask_kernel())
+            << ")\n";
+  return EXIT_SUCCESS;
+}
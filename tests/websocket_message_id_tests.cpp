@@ -0,0 +1,124 @@
+#include <vix/websocket/MessageId.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::MonotonicIdGenerator;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  void test_same_instant_and_clock_step_back()
+  {
+    MonotonicIdGenerator ids;
+    expect_true(ids.next_value(1000) == 1000, "ids: follows the clock");
+    expect_true(ids.next_value(1000) == 1001, "ids: same instant does not collide");
+    expect_true(ids.next_value(1000) == 1002, "ids: same instant keeps increasing");
+    expect_true(ids.next_value(500) == 1003, "ids: clock step back keeps order");
+    expect_true(ids.next_value(2000) == 2000, "ids: catches up with the clock");
+  }
+
+  void test_observe()
+  {
+    MonotonicIdGenerator ids;
+    ids.observe(5000);
+    expect_true(ids.next_value(100) == 5001, "observe: resumes after stored id");
+    ids.observe(10);
+    expect_true(ids.next_value(100) == 5002, "observe: lower value is ignored");
+  }
+
+  void test_format_and_parse()
+  {
+    const std::string zero = MonotonicIdGenerator::format(0);
+    const std::string small = MonotonicIdGenerator::format(42);
+    const std::string large = MonotonicIdGenerator::format(UINT64_MAX);
+
+    expect_true(zero == "00000000000000000000", "format: zero padded");
+    expect_true(small == "00000000000000000042", "format: fixed width");
+    expect_true(large == "18446744073709551615", "format: full range fits");
+    expect_true(small < large, "format: string order is numeric order");
+
+    // Legacy ids were zero-padded microseconds; new ids sort after them.
+    const std::string legacy = "00001735689600000000";
+    MonotonicIdGenerator ids;
+    expect_true(ids.next() > legacy, "format: sorts after microsecond ids");
+
+    expect_true(MonotonicIdGenerator::parse(small) == 42u, "parse: round trip");
+    expect_true(!MonotonicIdGenerator::parse("42"), "parse: rejects short ids");
+    expect_true(!MonotonicIdGenerator::parse("0000000000000000004x"), "parse: rejects non digits");
+  }
+
+  void test_concurrent_ids_are_unique()
+  {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 50000;
+
+    MonotonicIdGenerator ids;
+    std::vector<std::vector<std::uint64_t>> issued(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+      threads.emplace_back(
+          [&ids, &issued, t]()
+          {
+            issued[t].reserve(PER_THREAD);
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+              issued[t].push_back(ids.next_value());
+            }
+          });
+    }
+    for (auto &t : threads)
+    {
+      t.join();
+    }
+
+    std::vector<std::uint64_t> all;
+    for (const auto &v : issued)
+    {
+      expect_true(std::is_sorted(v.begin(), v.end()) &&
+                      std::adjacent_find(v.begin(), v.end()) == v.end(),
+                  "concurrent: strictly increasing per thread");
+      all.insert(all.end(), v.begin(), v.end());
+    }
+
+    std::sort(all.begin(), all.end());
+    expect_true(std::adjacent_find(all.begin(), all.end()) == all.end(),
+                "concurrent: no duplicates across threads");
+  }
+}
+
+int main()
+{
+  test_same_instant_and_clock_step_back();
+  test_observe();
+  test_format_and_parse();
+  test_concurrent_ids_are_unique();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_message_id_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_message_id_tests passed\n";
+  return EXIT_SUCCESS;
+}
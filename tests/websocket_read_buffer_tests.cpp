@@ -0,0 +1,134 @@
+#include <vix/websocket/ReadBuffer.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+  using vix::websocket::detail::ReadBuffer;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  void put(ReadBuffer &buffer, std::string_view text)
+  {
+    buffer.append(reinterpret_cast<const std::byte *>(text.data()), text.size());
+  }
+
+  void test_prepare_uses_tail_first()
+  {
+    ReadBuffer buffer(16);
+    put(buffer, "abcdef");
+    buffer.consume(2);
+
+    const auto tail = buffer.prepare(8);
+    expect_true(tail.size() == 10, "tail: enough room, nothing moved");
+    expect_true(buffer.compactions() == 0, "tail: no compaction");
+    expect_true(buffer.view() == "cdef", "tail: unread bytes in place");
+    expect_true(buffer.capacity() == 16, "tail: no growth");
+  }
+
+  void test_compacts_when_tail_too_small()
+  {
+    ReadBuffer buffer(16);
+    put(buffer, "0123456789abcd");
+    buffer.consume(10);
+
+    // 2 bytes of tail, but 12 free once "abcd" moves to the front.
+    const auto tail = buffer.prepare(8);
+    expect_true(buffer.compactions() == 1, "compact: unread bytes moved");
+    expect_true(buffer.capacity() == 16, "compact: no growth");
+    expect_true(buffer.view() == "abcd", "compact: unread bytes kept");
+    expect_true(tail.size() == 12, "compact: whole free space offered");
+    expect_true(tail.data() == buffer.data() + 4, "compact: tail follows unread bytes");
+  }
+
+  void test_drain_rewinds()
+  {
+    ReadBuffer buffer(16);
+    put(buffer, "0123456789abcd");
+    buffer.consume(6);
+    buffer.consume(8);
+
+    expect_true(buffer.empty(), "rewind: drained");
+
+    // Both cursors are back at the start; the full buffer is free again.
+    const auto tail = buffer.prepare(16);
+    expect_true(tail.size() == 16, "rewind: full capacity free");
+    expect_true(buffer.compactions() == 0, "rewind: no copy needed");
+    expect_true(buffer.capacity() == 16, "rewind: no growth");
+
+    put(buffer, "xy");
+    expect_true(buffer.view() == "xy" && buffer.data() == tail.data(), "rewind: writes start at the front");
+
+    // Consuming more than is unread only drains.
+    buffer.consume(100);
+    expect_true(buffer.empty() && buffer.prepare(16).size() == 16, "rewind: over-consume drains");
+  }
+
+  void test_grows_with_unconsumed_bytes()
+  {
+    ReadBuffer buffer(8);
+    put(buffer, "abcdefgh");
+    buffer.consume(3);
+
+    // 5 unread bytes plus 10 free do not fit in 8 even after compaction.
+    const auto tail = buffer.prepare(10);
+    expect_true(buffer.capacity() >= 15, "grow: storage enlarged");
+    expect_true(tail.size() >= 10, "grow: requested space available");
+    expect_true(buffer.view() == "defgh", "grow: unread bytes preserved");
+    expect_true(buffer.compactions() == 1, "grow: unread bytes moved to the front");
+
+    put(buffer, "ijklmnopqr");
+    expect_true(buffer.view() == "defghijklmnopqr", "grow: appends after unread bytes");
+
+    ReadBuffer unconsumed(4);
+    put(unconsumed, "abcd");
+    put(unconsumed, "efgh");
+    expect_true(unconsumed.view() == "abcdefgh", "grow: full buffer doubles without losing bytes");
+    expect_true(unconsumed.compactions() == 0, "grow: nothing to compact at the front");
+  }
+
+  void test_commit_is_clamped()
+  {
+    ReadBuffer buffer(8);
+    const auto tail = buffer.prepare(8);
+    buffer.commit(tail.size() + 10);
+    expect_true(buffer.size() == tail.size(), "commit: clamped to prepared space");
+
+    buffer.clear();
+    expect_true(buffer.empty() && buffer.prepare(8).size() == 8, "clear: drops unread bytes");
+  }
+}
+
+int main()
+{
+  test_prepare_uses_tail_first();
+  test_compacts_when_tail_too_small();
+  test_drain_rewinds();
+  test_grows_with_unconsumed_bytes();
+  test_commit_is_clamped();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_read_buffer_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_read_buffer_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+#include <vix/websocket/ReusePort.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  using vix::websocket::detail::ReusePortSocket;
+  using vix::websocket::detail::reuse_port_joinable;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+#if !defined(_WIN32)
+  int connect_to(std::uint16_t port)
+  {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  /** Accept every pending connection of each listener; returns counts. */
+  std::vector<int> drain(const std::vector<const ReusePortSocket *> &listeners, int expected)
+  {
+    std::vector<int> accepted(listeners.size(), 0);
+    std::vector<pollfd> fds;
+    for (const auto *l : listeners)
+    {
+      fds.push_back(pollfd{l->fd(), POLLIN, 0});
+    }
+
+    int total = 0;
+    while (total < expected && ::poll(fds.data(), fds.size(), 1000) > 0)
+    {
+      for (std::size_t i = 0; i < fds.size(); ++i)
+      {
+        if (fds[i].revents & POLLIN)
+        {
+          const int fd = ::accept(fds[i].fd, nullptr, nullptr);
+          if (fd >= 0)
+          {
+            ::close(fd);
+            ++accepted[i];
+            ++total;
+          }
+        }
+      }
+    }
+    return accepted;
+  }
+
+  void test_two_shards_share_a_fixed_port()
+  {
+    // Pick a free port, then bind both shards to that fixed number.
+    ReusePortSocket first = ReusePortSocket::bind("127.0.0.1", 0);
+    const std::uint16_t port = first.port();
+    expect_true(port != 0, "shards: first listener bound");
+
+    expect_true(reuse_port_joinable("127.0.0.1", port), "shards: port joinable after first bind");
+
+    ReusePortSocket second;
+    try
+    {
+      second = ReusePortSocket::bind("127.0.0.1", port);
+    }
+    catch (const std::system_error &e)
+    {
+      std::cerr << "second bind: " << e.what() << "\n";
+    }
+    expect_true(second.fd() >= 0 && second.port() == port, "shards: second listener on the same port");
+
+    constexpr int CONNECTIONS = 64;
+    std::vector<int> clients;
+    for (int i = 0; i < CONNECTIONS; ++i)
+    {
+      clients.push_back(connect_to(port));
+    }
+
+    const auto accepted = drain({&first, &second}, CONNECTIONS);
+    expect_true(accepted[0] + accepted[1] == CONNECTIONS, "shards: every connection accepted");
+    expect_true(accepted[0] > 0 && accepted[1] > 0, "shards: kernel spreads connections across both");
+
+    for (int fd : clients)
+    {
+      if (fd >= 0)
+        ::close(fd);
+    }
+  }
+
+  void test_plain_listener_is_not_joinable()
+  {
+    const int plain = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    ::bind(plain, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+    ::listen(plain, 16);
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(plain, reinterpret_cast<sockaddr *>(&addr), &len);
+    const std::uint16_t port = ntohs(addr.sin_port);
+
+    expect_true(!reuse_port_joinable("127.0.0.1", port), "plain: listener without SO_REUSEPORT detected");
+
+    bool threw = false;
+    try
+    {
+      ReusePortSocket::bind("127.0.0.1", port);
+    }
+    catch (const std::system_error &e)
+    {
+      threw = e.code() == std::errc::address_in_use;
+    }
+    expect_true(threw, "plain: second bind fails with EADDRINUSE");
+
+    ::close(plain);
+  }
+#endif
+}
+
+int main()
+{
+#if !defined(_WIN32)
+  test_two_shards_share_a_fixed_port();
+  test_plain_listener_is_not_joinable();
+#endif
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_reuse_port_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_reuse_port_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+#include <vix/websocket/SendCompletion.hpp>
+#include <vix/websocket/WriteQueue.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::BackpressureOptions;
+  using vix::websocket::BackpressurePolicy;
+  using vix::websocket::SendAwaitable;
+  using vix::websocket::SendReceipt;
+  using vix::websocket::SendStatus;
+  using vix::websocket::detail::SendCompletion;
+
+  struct FakeMessage
+  {
+    std::string data{};
+    std::string key{};
+    SendCompletion completion{};
+
+    std::size_t payload_size() const noexcept
+    {
+      return data.size();
+    }
+  };
+
+  using Queue = vix::websocket::detail::BasicWriteQueue<FakeMessage>;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  /** Records every receipt delivered to it. */
+  struct Recorder
+  {
+    std::vector<SendReceipt> receipts{};
+
+    SendCompletion track()
+    {
+      return SendCompletion([this](const SendReceipt &r)
+                            { receipts.push_back(r); });
+    }
+  };
+
+  /** Eager, self-destroying coroutine used to await in tests. */
+  struct Detached
+  {
+    struct promise_type
+    {
+      Detached get_return_object() noexcept { return {}; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+
+  Detached await_receipt(SendAwaitable awaitable, SendReceipt &out, std::atomic<bool> &done)
+  {
+    out = co_await awaitable;
+    done.store(true, std::memory_order_release);
+  }
+
+  void test_completion_runs_once()
+  {
+    Recorder rec;
+    {
+      SendCompletion c = rec.track();
+      c.set_queue_position(3);
+      c.add_bytes(10);
+      c.add_bytes(5);
+      c.finish(SendStatus::Written, 100);
+      c.finish(SendStatus::Dropped);
+      expect_true(!c, "completion: empty after finish");
+    }
+
+    expect_true(rec.receipts.size() == 1, "completion: runs once");
+    const SendReceipt &r = rec.receipts.front();
+    expect_true(r.ok(), "completion: written");
+    expect_true(r.queuePosition == 3, "completion: queue position");
+    expect_true(r.bytes == 15, "completion: bytes accumulated");
+    expect_true(r.totalBytesFlushed == 100, "completion: session total");
+  }
+
+  void test_destroyed_completion_reports_dropped()
+  {
+    Recorder rec;
+    {
+      SendCompletion c = rec.track();
+      SendCompletion moved = std::move(c);
+      expect_true(!c && moved, "completion: move transfers ownership");
+    }
+    expect_true(rec.receipts.size() == 1 && rec.receipts[0].status == SendStatus::Dropped,
+                "completion: destructor reports dropped");
+
+    SendCompletion target = rec.track();
+    target = rec.track();
+    expect_true(rec.receipts.size() == 2 && rec.receipts[1].status == SendStatus::Dropped,
+                "completion: overwritten completion reports dropped");
+    target.finish(SendStatus::Written);
+    expect_true(rec.receipts.size() == 3 && rec.receipts[2].ok(), "completion: new one still tracked");
+  }
+
+  void test_queue_discards_complete_as_dropped()
+  {
+    BackpressureOptions options;
+    options.maxMessages = 2;
+    options.policy = BackpressurePolicy::DropOldest;
+    Queue queue(options);
+
+    Recorder rec;
+    queue.push({"a", {}, rec.track()});
+    queue.push({"b", {}, rec.track()});
+    queue.push({"c", {}, rec.track()});
+    expect_true(rec.receipts.size() == 1 && rec.receipts[0].status == SendStatus::Dropped,
+                "queue: shed message completes");
+
+    queue.push_conflated({"k1", "key", rec.track()});
+    expect_true(rec.receipts.size() == 2, "queue: shed for the keyed message");
+    queue.push_conflated({"k2", "key", rec.track()});
+    expect_true(rec.receipts.size() == 3 && rec.receipts[2].status == SendStatus::Dropped,
+                "queue: superseded message completes");
+
+    std::vector<FakeMessage> batch;
+    queue.pop_batch(batch, 10, 1 << 20);
+    for (FakeMessage &m : batch)
+    {
+      m.completion.finish(SendStatus::Written);
+    }
+    expect_true(rec.receipts.size() == 5, "queue: popped messages complete when written");
+
+    queue.push({"d", {}, rec.track()});
+    queue.clear();
+    expect_true(rec.receipts.size() == 6 && rec.receipts[5].status == SendStatus::Dropped,
+                "queue: clear completes pending messages");
+
+    FakeMessage shed{"e", {}, rec.track()};
+    options.maxMessages = 0;
+    options.policy = BackpressurePolicy::DropNewest;
+    queue.set_options(options);
+    expect_true(queue.push(std::move(shed)) == Queue::Push::Dropped, "queue: drop newest sheds");
+    expect_true(static_cast<bool>(shed.completion), "queue: shed message stays with the caller");
+    shed.completion.finish(SendStatus::Dropped);
+    expect_true(rec.receipts.back().status == SendStatus::Dropped, "queue: caller reports the drop");
+  }
+
+  void test_awaitable_completed_first()
+  {
+    SendAwaitable awaitable;
+    SendReceipt receipt;
+    receipt.status = SendStatus::Written;
+    receipt.bytes = 7;
+    awaitable.callback()(receipt);
+
+    SendReceipt out;
+    std::atomic<bool> done{false};
+    await_receipt(awaitable, out, done);
+    expect_true(done.load(), "awaitable: ready without suspending");
+    expect_true(out.ok() && out.bytes == 7, "awaitable: receipt delivered");
+  }
+
+  void test_awaitable_resumed_from_other_thread()
+  {
+    for (int round = 0; round < 200; ++round)
+    {
+      SendAwaitable awaitable;
+      auto callback = awaitable.callback();
+
+      SendReceipt out;
+      std::atomic<bool> done{false};
+
+      std::thread writer(
+          [&callback, round]()
+          {
+            SendReceipt r;
+            r.status = SendStatus::Written;
+            r.queuePosition = static_cast<std::size_t>(round);
+            callback(r);
+          });
+
+      await_receipt(awaitable, out, done);
+      writer.join();
+
+      if (!done.load(std::memory_order_acquire) ||
+          out.queuePosition != static_cast<std::size_t>(round))
+      {
+        expect_true(false, "awaitable: resumed exactly once with its receipt");
+        return;
+      }
+    }
+  }
+}
+
+int main()
+{
+  test_completion_runs_once();
+  test_destroyed_completion_reports_dropped();
+  test_queue_discards_complete_as_dropped();
+  test_awaitable_completed_first();
+  test_awaitable_resumed_from_other_thread();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_send_completion_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_send_completion_tests passed\n";
+  return EXIT_SUCCESS;
+}
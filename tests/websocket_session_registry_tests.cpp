@@ -0,0 +1,244 @@
+#include <vix/websocket/SessionRegistry.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  struct FakeSession
+  {
+    int id{0};
+    int received{0};
+  };
+
+  using Registry = vix::websocket::detail::BasicSessionRegistry<FakeSession>;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  int room_size(Registry &registry, const std::string &room)
+  {
+    int n = 0;
+    registry.for_each_in_room(room, [&n](FakeSession &)
+                              { ++n; });
+    return n;
+  }
+
+  void test_membership()
+  {
+    Registry registry;
+    auto a = std::make_shared<FakeSession>(FakeSession{1});
+    auto b = std::make_shared<FakeSession>(FakeSession{2});
+
+    registry.add(a);
+    registry.add(b);
+    registry.add(a);
+    expect_true(registry.size() == 2, "add is idempotent");
+
+    registry.join(a, "lobby");
+    registry.join(a, "lobby");
+    registry.join(b, "lobby");
+    registry.join(b, "games");
+    expect_true(room_size(registry, "lobby") == 2, "join is idempotent");
+
+    registry.leave(a.get(), "lobby");
+    expect_true(room_size(registry, "lobby") == 1, "leave removes one member");
+
+    registry.leave_all(b.get());
+    expect_true(!registry.room_members("lobby") && !registry.room_members("games"),
+                "empty rooms are dropped");
+    expect_true(registry.size() == 2, "leave_all keeps the session registered");
+
+    registry.join(a, "lobby");
+    registry.remove(a.get());
+    expect_true(registry.size() == 1, "remove unregisters");
+    expect_true(!registry.room_members("lobby"), "remove leaves every joined room");
+  }
+
+  void test_snapshot_is_stable()
+  {
+    Registry registry;
+    auto a = std::make_shared<FakeSession>(FakeSession{1});
+    auto b = std::make_shared<FakeSession>(FakeSession{2});
+
+    registry.join(a, "room");
+    auto snapshot = registry.room_members("room");
+
+    registry.join(b, "room");
+    expect_true(snapshot->size() == 1, "published snapshots are never mutated");
+    expect_true(registry.room_members("room")->size() == 2, "writers publish a new snapshot");
+  }
+
+  void test_expired_sessions_are_dropped()
+  {
+    Registry registry;
+    auto keep = std::make_shared<FakeSession>(FakeSession{1});
+    auto gone = std::make_shared<FakeSession>(FakeSession{2});
+
+    registry.join(keep, "room");
+    registry.join(gone, "room");
+    gone.reset();
+
+    expect_true(room_size(registry, "room") == 1, "expired members are skipped");
+    expect_true(registry.room_members("room")->size() == 1, "room compacted after broadcast");
+
+    int visited = 0;
+    registry.for_each_session([&visited](FakeSession &)
+                              { ++visited; });
+    expect_true(visited == 1 && registry.size() == 1, "session walk drops expired entries");
+  }
+
+  void test_large_room_leave()
+  {
+    Registry registry;
+    std::vector<std::shared_ptr<FakeSession>> sessions;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      sessions.push_back(std::make_shared<FakeSession>(FakeSession{i}));
+      registry.join(sessions.back(), "big");
+    }
+
+    auto before = registry.room_members("big");
+
+    // Leave from the front, the middle and the last chunk.
+    for (int i = 0; i < 1000; i += 3)
+    {
+      registry.leave(sessions[static_cast<std::size_t>(i)].get(), "big");
+    }
+
+    expect_true(before->size() == 1000, "leave does not mutate published snapshots");
+    expect_true(room_size(registry, "big") == 666, "leave removes exactly the leaving members");
+
+    registry.for_each_in_room("big", [](FakeSession &s)
+                              { ++s.received; });
+
+    bool exact = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+      const int expected = i % 3 == 0 ? 0 : 1;
+      exact = exact && sessions[static_cast<std::size_t>(i)]->received == expected;
+    }
+    expect_true(exact, "every remaining member is visited once");
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      registry.leave(sessions[static_cast<std::size_t>(i)].get(), "big");
+    }
+    expect_true(!registry.room_members("big"), "room dropped once everyone left");
+  }
+
+  void test_reused_address()
+  {
+    Registry registry;
+    FakeSession storage{1};
+    const auto noop = [](FakeSession *) {};
+
+    // Died without remove(); a new session then reuses the address.
+    auto old = std::shared_ptr<FakeSession>(&storage, noop);
+    registry.join(old, "lobby");
+    old.reset();
+
+    auto next = std::shared_ptr<FakeSession>(&storage, noop);
+    registry.add(next);
+    expect_true(registry.size() == 1, "reused address is registered once");
+
+    int visited = 0;
+    registry.for_each_session([&visited](FakeSession &)
+                              { ++visited; });
+    expect_true(visited == 1, "reused address stores the new session");
+    expect_true(!registry.room_members("lobby"), "rooms of the dead session are left");
+
+    auto other = std::make_shared<FakeSession>(FakeSession{2});
+    registry.join(other, "games");
+
+    old = next;
+    next.reset();
+    auto last = std::shared_ptr<FakeSession>(&storage, noop);
+    registry.join(old, "games");
+    old.reset();
+
+    registry.join(last, "games");
+    expect_true(room_size(registry, "games") == 2, "join after reuse adds the new session");
+    expect_true(registry.room_members("games")->size() == 2, "dead member replaced, not kept");
+  }
+
+  void test_concurrent_churn_and_broadcast()
+  {
+    Registry registry;
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t)
+    {
+      writers.emplace_back(
+          [&registry, t]()
+          {
+            for (int i = 0; i < 2000; ++i)
+            {
+              auto s = std::make_shared<FakeSession>(FakeSession{t * 10000 + i});
+              registry.add(s);
+              registry.join(s, "room-" + std::to_string(i % 8));
+              registry.join(s, "all");
+              registry.remove(s.get());
+            }
+          });
+    }
+
+    std::thread reader(
+        [&registry, &stop]()
+        {
+          while (!stop.load())
+          {
+            registry.for_each_in_room("all", [](FakeSession &s)
+                                      { ++s.received; });
+            registry.for_each_session([](FakeSession &) {});
+          }
+        });
+
+    for (auto &w : writers)
+    {
+      w.join();
+    }
+    stop.store(true);
+    reader.join();
+
+    expect_true(registry.size() == 0, "all sessions unregistered after churn");
+    expect_true(!registry.room_members("all"), "no room outlives its members");
+  }
+}
+
+int main()
+{
+  test_membership();
+  test_snapshot_is_stable();
+  test_expired_sessions_are_dropped();
+  test_large_room_leave();
+  test_reused_address();
+  test_concurrent_churn_and_broadcast();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_session_registry_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_session_registry_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,317 @@
+#include <vix/websocket/SqliteMessageStore.hpp>
+
+#include "store_test_support.hpp"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  namespace ws = vix::websocket;
+  using namespace store_test;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  /** Second connection to the same database, used to hold its write lock. */
+  class Connection
+  {
+  public:
+    explicit Connection(const std::string &path)
+    {
+      sqlite3_open(path.c_str(), &db_);
+    }
+
+    ~Connection()
+    {
+      sqlite3_close(db_);
+    }
+
+    Connection(const Connection &) = delete;
+    Connection &operator=(const Connection &) = delete;
+
+    bool exec(const std::string &sql)
+    {
+      return sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+
+    std::int64_t query_int(const std::string &sql)
+    {
+      sqlite3_stmt *stmt = nullptr;
+      std::int64_t value = -1;
+      if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK &&
+          sqlite3_step(stmt) == SQLITE_ROW)
+      {
+        value = sqlite3_column_int64(stmt, 0);
+      }
+      sqlite3_finalize(stmt);
+      return value;
+    }
+
+  private:
+    sqlite3 *db_{nullptr};
+  };
+
+  std::vector<std::string> ids(std::initializer_list<std::uint64_t> ns)
+  {
+    std::vector<std::string> out;
+    for (std::uint64_t n : ns)
+    {
+      out.push_back(make_id(n));
+    }
+    return out;
+  }
+
+  void test_migrates_version_0()
+  {
+    const std::string path = fresh_path("sqlite_migrate.db");
+
+    {
+      // Version 0 layout: TEXT primary key, rows inserted out of id order.
+      Connection v0(path);
+      v0.exec("CREATE TABLE messages ("
+              "  id           TEXT PRIMARY KEY,"
+              "  kind         TEXT NOT NULL,"
+              "  room         TEXT,"
+              "  type         TEXT NOT NULL,"
+              "  ts           TEXT NOT NULL,"
+              "  payload_json TEXT NOT NULL"
+              ");");
+
+      for (std::uint64_t n : {5, 1, 3, 6, 2, 4})
+      {
+        const std::string room = n % 2 == 0 ? "'b'" : "'a'";
+        v0.exec("INSERT INTO messages VALUES ('" + make_id(n) + "', 'event', " + room +
+                ", 'chat', '2025-01-01T00:00:00Z', '{\"n\":" + std::to_string(n) + "}');");
+      }
+      expect_true(v0.query_int("PRAGMA user_version;") == 0, "fixture starts at version 0");
+    }
+
+    {
+      ws::SqliteMessageStore store(path);
+
+      expect_true(ids_of(store.list_by_room("a", 10)) == ids({5, 3, 1}),
+                  "migrated rooms list newest id first");
+      expect_true(ids_of(store.list_by_room("b", 2)) == ids({6, 4}), "limit applies after migration");
+      expect_true(ids_of(store.list_by_room("a", 10, make_id(5))) == ids({3, 1}),
+                  "before_id resolves a stored id");
+      expect_true(ids_of(store.list_by_room("b", 10, make_id(5))) == ids({4, 2}),
+                  "before_id splits by id when the cursor is in another room");
+      expect_true(ids_of(store.replay_from(make_id(2), 10)) == ids({3, 4, 5, 6}),
+                  "replay_from continues in id order across rooms");
+      expect_true(ids_of(store.replay_from(make_id(0), 2)) == ids({1, 2}),
+                  "replay_from before the first id starts at the beginning");
+
+      const auto first = store.replay_from(make_id(0), 1);
+      expect_true(first.size() == 1 && first[0].room == "a" && first[0].type == "chat",
+                  "migrated columns are kept");
+
+      // New appends land after every migrated row.
+      store.append(make_message(7, "a"));
+      expect_true(ids_of(store.list_by_room("a", 2)) == ids({7, 5}), "append after migration");
+    }
+
+    Connection check(path);
+    expect_true(check.query_int("PRAGMA user_version;") == 1, "user_version is written");
+    expect_true(check.query_int("SELECT COUNT(*) FROM sqlite_master WHERE name = 'messages_v0';") == 0,
+                "the version 0 table is dropped");
+    expect_true(check.query_int("SELECT COUNT(*) FROM messages;") == 7, "no row is lost");
+
+    // Reopening a version 1 database does not migrate again.
+    ws::SqliteMessageStore reopened(path);
+    expect_true(ids_of(reopened.replay_from(make_id(0), 10)) == ids({1, 2, 3, 4, 5, 6, 7}),
+                "reopened store keeps the order");
+  }
+
+  void test_reappend_keeps_position()
+  {
+    ws::SqliteMessageStore store(fresh_path("sqlite_reappend.db"));
+
+    for (std::uint64_t n = 1; n <= 3; ++n)
+    {
+      store.append(make_message(n, "room"));
+    }
+
+    ws::JsonMessage update = make_message(1, "room");
+    update.type = "chat.edit";
+    store.append(update);
+
+    const auto listed = store.list_by_room("room", 10);
+    expect_true(ids_of(listed) == ids({3, 2, 1}), "re-appending an id keeps its position");
+    expect_true(listed.size() == 3 && listed[2].type == "chat.edit", "re-appending updates the row");
+    expect_true(ids_of(store.replay_from(make_id(1), 10)) == ids({2, 3}),
+                "replay after a re-appended id");
+  }
+
+  void test_group_commit_flush_and_drain()
+  {
+    const std::string path = fresh_path("sqlite_group_commit.db");
+
+    ws::SqliteStoreOptions options;
+    options.groupCommitMessages = 1000;
+    options.groupCommitDelay = std::chrono::milliseconds(60000);
+
+    {
+      ws::SqliteMessageStore store(path, options);
+
+      for (std::uint64_t n = 1; n <= 5; ++n)
+      {
+        store.append(make_message(n, "room"));
+      }
+
+      // Neither the size nor the delay has been reached; the read commits.
+      expect_true(ids_of(store.list_by_room("room", 10)) == ids({5, 4, 3, 2, 1}),
+                  "reads see pending appends");
+      expect_true(ids_of(store.replay_from(make_id(3), 10)) == ids({4, 5}),
+                  "replay sees pending appends");
+
+      for (std::uint64_t n = 6; n <= 8; ++n)
+      {
+        store.append(make_message(n, "room"));
+      }
+    }
+
+    // The destructor drained the last batch.
+    ws::SqliteMessageStore reopened(path);
+    expect_true(ids_of(reopened.list_by_room("room", 10)) == ids({8, 7, 6, 5, 4, 3, 2, 1}),
+                "destructor commits pending appends");
+  }
+
+  void test_generated_ids_follow_append_order()
+  {
+    for (const std::size_t batch : {std::size_t{1}, std::size_t{64}})
+    {
+      ws::SqliteStoreOptions options;
+      options.groupCommitMessages = batch;
+
+      ws::SqliteMessageStore store(fresh_path("sqlite_generated_ids.db"), options);
+
+      constexpr int THREADS = 4;
+      constexpr int PER_THREAD = 200;
+      std::vector<std::thread> writers;
+      for (int t = 0; t < THREADS; ++t)
+      {
+        writers.emplace_back(
+            [&store]()
+            {
+              for (int i = 0; i < PER_THREAD; ++i)
+              {
+                ws::JsonMessage m = make_message(0, "room");
+                m.id.clear();
+                store.append(m);
+              }
+            });
+      }
+      for (auto &w : writers)
+      {
+        w.join();
+      }
+
+      const auto all = ids_of(store.replay_from(make_id(0), THREADS * PER_THREAD));
+      expect_true(all.size() == THREADS * PER_THREAD, "every generated id is stored");
+      expect_true(std::is_sorted(all.begin(), all.end()), "generated ids sort in append order");
+      expect_true(store.replay_from(all.front(), THREADS * PER_THREAD).size() == all.size() - 1,
+                  "replay after the first generated id skips nothing");
+    }
+  }
+
+  void test_failed_batch_is_reported()
+  {
+    const std::string path = fresh_path("sqlite_failed_batch.db");
+
+    std::mutex lostMutex;
+    std::vector<std::string> lost;
+
+    ws::SqliteStoreOptions options;
+    options.groupCommitMessages = 1000;
+    options.groupCommitDelay = std::chrono::milliseconds(60000);
+    options.onCommitError =
+        [&](std::exception_ptr, const std::vector<std::string> &ids)
+    {
+      std::lock_guard<std::mutex> lock(lostMutex);
+      lost.insert(lost.end(), ids.begin(), ids.end());
+    };
+
+    ws::SqliteMessageStore store(path, options);
+    Connection other(path);
+
+    // The other connection holds the write lock, so the batch cannot commit.
+    other.exec("BEGIN IMMEDIATE;");
+    store.append(make_message(1, "room"));
+    store.append(make_message(2, "room"));
+
+    bool threw = false;
+    try
+    {
+      store.flush();
+    }
+    catch (const std::exception &)
+    {
+      threw = true;
+    }
+    expect_true(threw, "flush reports the failed batch");
+
+    {
+      std::lock_guard<std::mutex> lock(lostMutex);
+      expect_true(lost == std::vector<std::string>{make_id(1), make_id(2)},
+                  "onCommitError receives the lost ids");
+    }
+
+    other.exec("COMMIT;");
+
+    bool appendThrew = false;
+    try
+    {
+      store.append(make_message(3, "room"));
+    }
+    catch (const std::exception &)
+    {
+      appendThrew = true;
+    }
+    expect_true(!appendThrew, "a later append does not inherit the failure");
+
+    store.flush();
+    expect_true(ids_of(store.list_by_room("room", 10)) == std::vector<std::string>{make_id(3)},
+                "the append after the failure is committed");
+  }
+}
+
+int main()
+{
+  test_migrates_version_0();
+  test_reappend_keeps_position();
+  test_group_commit_flush_and_drain();
+  test_generated_ids_follow_append_order();
+  test_failed_batch_is_reported();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_sqlite_store_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_sqlite_store_tests passed\n";
+  return EXIT_SUCCESS;
+}
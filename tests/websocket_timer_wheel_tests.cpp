@@ -0,0 +1,153 @@
+#include <vix/websocket/TimerWheel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::TimerWheel;
+  using namespace std::chrono_literals;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  const TimerWheel::Clock::time_point origin{};
+
+  TimerWheel::Clock::time_point at_tick(std::uint64_t tick)
+  {
+    return origin + std::chrono::milliseconds{static_cast<std::int64_t>(tick) * 10};
+  }
+
+  void test_fires_on_its_tick_across_levels()
+  {
+    TimerWheel wheel(10ms, origin);
+
+    // Delays chosen to land on every level and on wrap boundaries.
+    const std::vector<std::uint64_t> delays = {
+        1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 70000, 262143};
+
+    std::vector<std::unique_ptr<TimerWheel::Timer>> timers;
+    std::vector<bool> inWindow(delays.size(), false);
+    std::vector<int> fireCount(delays.size(), 0);
+
+    // Advance in uneven steps, as a late ticker would; a timer must fire in
+    // the advance() call whose window (previous, tick] holds its deadline.
+    std::uint64_t previous = 0;
+    std::uint64_t tick = 0;
+
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+      timers.push_back(std::make_unique<TimerWheel::Timer>());
+      wheel.schedule(*timers.back(),
+                     std::chrono::milliseconds{static_cast<std::int64_t>(delays[i]) * 10},
+                     [&, i]
+                     {
+                       ++fireCount[i];
+                       inWindow[i] = previous < delays[i] && delays[i] <= tick;
+                     });
+    }
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::uint64_t> step(1, 700);
+    while (tick < 270000)
+    {
+      previous = tick;
+      tick += step(rng);
+      wheel.advance(at_tick(tick));
+    }
+
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+      expect_true(fireCount[i] == 1 && inWindow[i],
+                  "timer with delay " + std::to_string(delays[i]) + " fired once, on time");
+    }
+    expect_true(wheel.size() == 0, "wheel is empty after all timers fired");
+  }
+
+  void test_rearm_and_cancel()
+  {
+    TimerWheel wheel(10ms, origin);
+    TimerWheel::Timer timer;
+    int fired = 0;
+
+    wheel.schedule(timer, 100ms, [&]
+                   { ++fired; });
+
+    wheel.advance(at_tick(5));
+    wheel.reschedule(timer, 100ms); // pushed back to tick 15
+    wheel.advance(at_tick(14));
+    expect_true(fired == 0, "re-armed timer did not fire at its old deadline");
+
+    wheel.advance(at_tick(15));
+    expect_true(fired == 1, "re-armed timer fired at its new deadline");
+
+    wheel.schedule(timer, 50ms, [&]
+                   { ++fired; });
+    wheel.cancel(timer);
+    wheel.advance(at_tick(100));
+    expect_true(fired == 1, "cancelled timer never fires");
+
+    {
+      TimerWheel::Timer scoped;
+      wheel.schedule(scoped, 10ms, [&]
+                     { ++fired; });
+      expect_true(wheel.size() == 1, "scoped timer armed");
+    }
+    expect_true(wheel.size() == 0, "destroying a timer disarms it");
+  }
+
+  void test_callback_can_rearm_itself()
+  {
+    TimerWheel wheel(10ms, origin);
+    TimerWheel::Timer timer;
+    std::vector<std::uint64_t> ticks;
+
+    wheel.schedule(timer, 30ms, [&]
+                   {
+      ticks.push_back(wheel.now_tick());
+      if (ticks.size() < 3)
+      {
+        wheel.reschedule(timer, 30ms);
+      } });
+
+    wheel.advance(at_tick(3));
+    wheel.advance(at_tick(6));
+    wheel.advance(at_tick(9));
+    wheel.advance(at_tick(50));
+
+    expect_true(ticks == std::vector<std::uint64_t>{3, 6, 9}, "periodic re-arm from callback");
+  }
+}
+
+int main()
+{
+  test_fires_on_its_tick_across_levels();
+  test_rearm_and_cancel();
+  test_callback_can_rearm_itself();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_timer_wheel_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_timer_wheel_tests passed\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,238 @@
+#include <vix/websocket/UpgradeParser.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+  using vix::websocket::detail::header_has_token;
+  using vix::websocket::detail::UpgradeParser;
+  using vix::websocket::detail::UpgradeRequest;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  const std::string browser_request =
+      "GET /chat/room?id=42&lang=fr HTTP/1.1\r\n"
+      "Host: example.com:8080\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+      "Accept: */*\r\n"
+      "Sec-WebSocket-Version: 13\r\n"
+      "Origin: https://example.com\r\n"
+      "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n"
+      "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+      "Connection: keep-alive, Upgrade\r\n"
+      "Upgrade: websocket\r\n"
+      "\r\n";
+
+  void check_browser_request(const UpgradeRequest &r, const std::string &name)
+  {
+    expect_true(r.method == "GET", name + ": method");
+    expect_true(r.target == "/chat/room?id=42&lang=fr", name + ": target");
+    expect_true(r.path == "/chat/room", name + ": path");
+    expect_true(r.query == "id=42&lang=fr", name + ": query");
+    expect_true(r.host == "example.com:8080", name + ": host");
+    expect_true(r.origin == "https://example.com", name + ": origin");
+    expect_true(r.upgrade == "websocket", name + ": upgrade");
+    expect_true(r.key == "dGhlIHNhbXBsZSBub25jZQ==", name + ": key");
+    expect_true(r.version == "13", name + ": version");
+    expect_true(r.extensions.count == 1 &&
+                    r.extensions.lines[0] == "permessage-deflate; client_max_window_bits",
+                name + ": extensions");
+    expect_true(r.protocol.empty(), name + ": protocol absent");
+    expect_true(r.connectionUpgrade, name + ": connection upgrade token");
+    expect_true(r.headSize == browser_request.size(), name + ": head size");
+  }
+
+  void test_whole_request()
+  {
+    UpgradeParser parser;
+    expect_true(parser.parse(browser_request) == UpgradeParser::Status::Complete, "whole request completes");
+    check_browser_request(parser.request(browser_request), "whole request");
+  }
+
+  void test_resumes_across_every_split()
+  {
+    // Feed the request in two reads split at every position, including
+    // between CR and LF, from a buffer that is re-created (and therefore
+    // moved) between calls.
+    for (std::size_t split = 0; split < browser_request.size(); ++split)
+    {
+      UpgradeParser parser;
+      const std::string head = browser_request.substr(0, split);
+
+      expect_true(parser.parse(head) == UpgradeParser::Status::NeedMore,
+                  "partial head needs more at " + std::to_string(split));
+
+      const std::string full = head + browser_request.substr(split) + "\x81\x05";
+      expect_true(parser.parse(full) == UpgradeParser::Status::Complete,
+                  "completes after split at " + std::to_string(split));
+      check_browser_request(parser.request(full), "split at " + std::to_string(split));
+    }
+  }
+
+  void test_byte_at_a_time()
+  {
+    UpgradeParser parser;
+    std::string buffer;
+    UpgradeParser::Status status = UpgradeParser::Status::NeedMore;
+
+    for (char c : browser_request)
+    {
+      buffer.push_back(c);
+      status = parser.parse(buffer);
+    }
+
+    expect_true(status == UpgradeParser::Status::Complete, "byte at a time completes");
+    check_browser_request(parser.request(buffer), "byte at a time");
+  }
+
+  void test_header_rules()
+  {
+    const std::string request =
+        "GET / HTTP/1.1\r\n"
+        "HOST:example.com\r\n"
+        "connection: keep-alive\r\n"
+        "Connection:  UPGRADE \r\n"
+        "sec-websocket-key: \tfirst \r\n"
+        "Sec-WebSocket-Key: second\r\n"
+        "X-Sec-WebSocket-Key: ignored\r\n"
+        "\r\n";
+
+    UpgradeParser parser;
+    expect_true(parser.parse(request) == UpgradeParser::Status::Complete, "header rules request completes");
+
+    const UpgradeRequest r = parser.request(request);
+    expect_true(r.host == "example.com", "names are case-insensitive and OWS is optional");
+    expect_true(r.connectionUpgrade, "upgrade token found in a repeated Connection header");
+    expect_true(r.key == "first", "first occurrence wins and value is trimmed");
+    expect_true(r.path == "/" && r.query.empty(), "target without query");
+    expect_true(r.upgrade.empty(), "absent header is empty");
+  }
+
+  void test_repeated_list_headers()
+  {
+    const std::string request =
+        "GET / HTTP/1.1\r\n"
+        "Sec-WebSocket-Extensions: x-webkit-deflate-frame\r\n"
+        "Sec-WebSocket-Protocol: chat\r\n"
+        "sec-websocket-extensions: permessage-deflate; client_max_window_bits\r\n"
+        "Sec-WebSocket-Protocol: superchat\r\n"
+        "\r\n";
+
+    UpgradeParser parser;
+    expect_true(parser.parse(request) == UpgradeParser::Status::Complete, "list headers request completes");
+
+    const UpgradeRequest r = parser.request(request);
+    expect_true(r.extensions.count == 2 && r.extensions.lines[1] == "permessage-deflate; client_max_window_bits",
+                "every extensions line is kept");
+
+    std::string storage;
+    expect_true(r.extensions.joined(storage) ==
+                    "x-webkit-deflate-frame, permessage-deflate; client_max_window_bits",
+                "extensions lines join into one list");
+    expect_true(r.protocol.joined(storage) == "chat, superchat", "protocol lines join into one list");
+
+    UpgradeParser single;
+    const std::string one =
+        "GET / HTTP/1.1\r\n"
+        "Sec-WebSocket-Extensions: permessage-deflate\r\n"
+        "\r\n";
+    single.parse(one);
+    std::string unused;
+    const UpgradeRequest s = single.request(one);
+    expect_true(s.extensions.joined(unused).data() == s.extensions.lines[0].data() && unused.empty(),
+                "a single line is returned without copying");
+    expect_true(s.protocol.empty() && s.protocol.joined(unused).empty(), "absent list header is empty");
+
+    std::string many = "GET / HTTP/1.1\r\n";
+    for (std::size_t i = 0; i <= vix::websocket::detail::HeaderValues::MAX_LINES; ++i)
+    {
+      many += "Sec-WebSocket-Extensions: x\r\n";
+    }
+    many += "\r\n";
+
+    UpgradeParser bounded;
+    expect_true(bounded.parse(many) == UpgradeParser::Status::Error, "too many list lines are rejected");
+  }
+
+  void test_rejects_malformed()
+  {
+    const std::string_view bad[] = {
+        "GET\r\n\r\n",
+        "GET /\r\n\r\n",
+        "GET / FTP/1.0\r\n\r\n",
+        " GET / HTTP/1.1\r\n\r\n",
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\nUpgrade : websocket\r\n\r\n",
+        "GET / HTTP/1.1\r\nUpgrade: websocket\r\n continued\r\n\r\n",
+        "\r\n",
+    };
+
+    for (std::string_view request : bad)
+    {
+      UpgradeParser parser;
+      expect_true(parser.parse(request) == UpgradeParser::Status::Error,
+                  "rejects: " + std::string(request));
+      expect_true(std::string_view(parser.error()).size() > 0, "error has a reason");
+    }
+  }
+
+  void test_head_size_limit()
+  {
+    UpgradeParser parser(128);
+    std::string request = "GET / HTTP/1.1\r\n";
+
+    while (request.size() <= 128)
+    {
+      request += "X-Padding: aaaaaaaaaaaaaaaa\r\n";
+    }
+
+    expect_true(parser.parse(request) == UpgradeParser::Status::Error, "head larger than the limit fails");
+
+    parser.reset();
+    expect_true(parser.parse("GET / HTTP/1.1\r\n\r\n") == UpgradeParser::Status::Complete, "reset parser accepts a new request");
+  }
+
+  void test_header_has_token()
+  {
+    expect_true(header_has_token("keep-alive, Upgrade", "upgrade"), "token after comma");
+    expect_true(header_has_token(" upgrade ", "upgrade"), "token with whitespace");
+    expect_true(!header_has_token("upgrades", "upgrade"), "token must match whole element");
+    expect_true(!header_has_token("", "upgrade"), "empty value");
+  }
+}
+
+int main()
+{
+  test_whole_request();
+  test_resumes_across_every_split();
+  test_byte_at_a_time();
+  test_header_rules();
+  test_repeated_list_headers();
+  test_rejects_malformed();
+  test_head_size_limit();
+  test_header_has_token();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_upgrade_parser_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_upgrade_parser_tests passed\n";
+  return EXIT_SUCCESS;
+}
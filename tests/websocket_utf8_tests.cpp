@@ -0,0 +1,286 @@
+#include <vix/websocket/utf8.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::detail::is_valid_utf8_with;
+  using vix::websocket::detail::Utf8Kernel;
+  using vix::websocket::detail::Utf8Validator;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  const std::array<Utf8Kernel, 4> all_kernels = {
+      Utf8Kernel::Scalar,
+      Utf8Kernel::Sse4,
+      Utf8Kernel::Avx2,
+      Utf8Kernel::Neon,
+  };
+
+  std::span<const std::byte> bytes(const std::vector<std::uint8_t> &v)
+  {
+    return {reinterpret_cast<const std::byte *>(v.data()), v.size()};
+  }
+
+  /** Decode-based reference, written independently of the kernels. */
+  bool reference_valid(const std::vector<std::uint8_t> &s)
+  {
+    std::size_t i = 0;
+    while (i < s.size())
+    {
+      const std::uint8_t c = s[i];
+      std::size_t len = 0;
+      std::uint32_t cp = 0;
+
+      if (c < 0x80)
+      {
+        len = 1;
+        cp = c;
+      }
+      else if ((c & 0xE0) == 0xC0)
+      {
+        len = 2;
+        cp = c & 0x1F;
+      }
+      else if ((c & 0xF0) == 0xE0)
+      {
+        len = 3;
+        cp = c & 0x0F;
+      }
+      else if ((c & 0xF8) == 0xF0)
+      {
+        len = 4;
+        cp = c & 0x07;
+      }
+      else
+      {
+        return false;
+      }
+
+      if (i + len > s.size())
+      {
+        return false;
+      }
+
+      for (std::size_t k = 1; k < len; ++k)
+      {
+        if ((s[i + k] & 0xC0) != 0x80)
+        {
+          return false;
+        }
+        cp = (cp << 6) | (s[i + k] & 0x3F);
+      }
+
+      static const std::uint32_t minimum[5] = {0, 0, 0x80, 0x800, 0x10000};
+      if (cp < minimum[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+      {
+        return false;
+      }
+
+      i += len;
+    }
+    return true;
+  }
+
+  void append_code_point(std::vector<std::uint8_t> &out, std::uint32_t cp)
+  {
+    if (cp < 0x80)
+    {
+      out.push_back(static_cast<std::uint8_t>(cp));
+    }
+    else if (cp < 0x800)
+    {
+      out.push_back(static_cast<std::uint8_t>(0xC0 | (cp >> 6)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    }
+    else if (cp < 0x10000)
+    {
+      out.push_back(static_cast<std::uint8_t>(0xE0 | (cp >> 12)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    }
+    else
+    {
+      out.push_back(static_cast<std::uint8_t>(0xF0 | (cp >> 18)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | ((cp >> 12) & 0x3F)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+      out.push_back(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    }
+  }
+
+  std::vector<std::uint8_t> random_text(std::mt19937 &rng, std::size_t codePoints)
+  {
+    std::uniform_int_distribution<int> width(0, 9);
+    std::vector<std::uint8_t> out;
+
+    for (std::size_t i = 0; i < codePoints; ++i)
+    {
+      std::uint32_t cp = 0;
+      switch (width(rng))
+      {
+      case 0:
+        cp = std::uniform_int_distribution<std::uint32_t>(0x80, 0x7FF)(rng);
+        break;
+      case 1:
+        cp = std::uniform_int_distribution<std::uint32_t>(0x800, 0xFFFF)(rng);
+        if (cp >= 0xD800 && cp <= 0xDFFF)
+        {
+          cp = 0xE000;
+        }
+        break;
+      case 2:
+        cp = std::uniform_int_distribution<std::uint32_t>(0x10000, 0x10FFFF)(rng);
+        break;
+      default:
+        cp = std::uniform_int_distribution<std::uint32_t>(0x20, 0x7E)(rng);
+        break;
+      }
+      append_code_point(out, cp);
+    }
+    return out;
+  }
+
+  bool incremental_valid(const std::vector<std::uint8_t> &s, std::size_t step)
+  {
+    Utf8Validator v;
+    bool ok = true;
+    for (std::size_t pos = 0; pos < s.size() && ok; pos += step)
+    {
+      const std::size_t n = std::min(step, s.size() - pos);
+      ok = v.feed(std::span<const std::byte>(reinterpret_cast<const std::byte *>(s.data() + pos), n));
+    }
+    return ok && v.finish();
+  }
+
+  void check_all(const std::vector<std::uint8_t> &s, const std::string &name)
+  {
+    const bool expected = reference_valid(s);
+
+    for (Utf8Kernel kernel : all_kernels)
+    {
+      if (is_valid_utf8_with(kernel, bytes(s)) != expected)
+      {
+        expect_true(false, name + " (" + vix::websocket::detail::utf8_kernel_name(kernel) + ")");
+      }
+    }
+
+    for (std::size_t step : {1u, 2u, 3u, 7u, 64u})
+    {
+      if (incremental_valid(s, step) != expected)
+      {
+        expect_true(false, name + " (incremental step " + std::to_string(step) + ")");
+      }
+    }
+  }
+
+  void test_known_sequences()
+  {
+    const std::vector<std::vector<std::uint8_t>> cases = {
+        {},
+        {'h', 'i'},
+        {0xC2, 0xA9},
+        {0xE2, 0x82, 0xAC},
+        {0xF0, 0x9F, 0x98, 0x80},
+        {0xF4, 0x8F, 0xBF, 0xBF},
+        {0xC0, 0xAF},             // overlong 2
+        {0xE0, 0x80, 0xAF},       // overlong 3
+        {0xF0, 0x80, 0x80, 0xAF}, // overlong 4
+        {0xED, 0xA0, 0x80},       // surrogate
+        {0xF4, 0x90, 0x80, 0x80}, // above U+10FFFF
+        {0xF5, 0x80, 0x80, 0x80},
+        {0xFF},
+        {0x80},
+        {0xC2},
+        {0xE2, 0x82},
+        {0xC2, 0x41},
+        {0xCE, 0xBA, 0xE1, 0xBD, 0xB9, 0xCF, 0x83, 0xCE, 0xBC, 0xCE, 0xB5}, // Autobahn 6.2.1
+    };
+
+    for (std::size_t i = 0; i < cases.size(); ++i)
+    {
+      // Place each case at every offset of a buffer long enough for the
+      // vector kernels, so it crosses every block boundary.
+      for (std::size_t offset = 0; offset < 70; ++offset)
+      {
+        std::vector<std::uint8_t> s(offset, 'a');
+        s.insert(s.end(), cases[i].begin(), cases[i].end());
+        s.resize(s.size() + (offset % 5) * 13, 'z');
+        check_all(s, "case " + std::to_string(i) + " at offset " + std::to_string(offset));
+      }
+    }
+  }
+
+  void test_random_text_and_corruption()
+  {
+    std::mt19937 rng(2024);
+
+    for (int round = 0; round < 400; ++round)
+    {
+      auto s = random_text(rng, 10 + static_cast<std::size_t>(round));
+      check_all(s, "random valid text round " + std::to_string(round));
+
+      for (int k = 0; k < 3; ++k)
+      {
+        auto corrupted = s;
+        const std::size_t pos = std::uniform_int_distribution<std::size_t>(0, s.size() - 1)(rng);
+        corrupted[pos] = static_cast<std::uint8_t>(std::uniform_int_distribution<int>(0x80, 0xFF)(rng));
+        check_all(corrupted, "corrupted text round " + std::to_string(round));
+      }
+
+      auto truncated = s;
+      truncated.pop_back();
+      check_all(truncated, "truncated text round " + std::to_string(round));
+    }
+  }
+
+  void test_fail_fast()
+  {
+    Utf8Validator v;
+    const std::vector<std::uint8_t> head = {'o', 'k', 0xF4, 0x90};
+    expect_true(!v.feed(bytes(head)), "impossible prefix at piece end fails immediately");
+
+    v.reset();
+    const std::vector<std::uint8_t> a = {'x', 0xF0, 0x9F};
+    const std::vector<std::uint8_t> b = {0x98, 0x80, 'y'};
+    expect_true(v.feed(bytes(a)) && v.feed(bytes(b)) && v.finish(), "code point split across pieces");
+
+    v.reset();
+    expect_true(v.feed(bytes(a)) && !v.finish(), "open sequence at message end is invalid");
+  }
+}
+
+int main()
+{
+  test_known_sequences();
+  test_random_text_and_corruption();
+  test_fail_fast();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_utf8_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_utf8_tests passed\n";
+  return EXIT_SUCCESS;
+}
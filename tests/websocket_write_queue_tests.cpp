@@ -0,0 +1,366 @@
+#include <vix/websocket/WriteQueue.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using vix::websocket::BackpressureOptions;
+  using vix::websocket::BackpressurePolicy;
+
+  struct FakeMessage
+  {
+    std::string data{};
+    std::string key{};
+
+    std::size_t payload_size() const noexcept
+    {
+      return data.size();
+    }
+  };
+
+  using Queue = vix::websocket::detail::BasicWriteQueue<FakeMessage>;
+  using Push = Queue::Push;
+
+  int failures = 0;
+
+  void expect_true(bool value, const std::string &name)
+  {
+    if (!value)
+    {
+      std::cerr << "FAILED: expected true: " << name << "\n";
+      ++failures;
+    }
+  }
+
+  Queue make_queue(BackpressurePolicy policy, std::size_t maxMessages, std::size_t maxBytes)
+  {
+    BackpressureOptions options;
+    options.maxMessages = maxMessages;
+    options.maxBytes = maxBytes;
+    options.policy = policy;
+    return Queue(options);
+  }
+
+  std::string drain(Queue &queue)
+  {
+    std::vector<FakeMessage> batch;
+    queue.pop_batch(batch, 1000, 1 << 20);
+
+    std::string out;
+    for (const auto &m : batch)
+    {
+      out += m.data;
+      out += ' ';
+    }
+    return out;
+  }
+
+  void test_close_policy()
+  {
+    Queue queue = make_queue(BackpressurePolicy::Close, 2, 100);
+    expect_true(queue.push({"a"}) == Push::Queued, "close: first fits");
+    expect_true(queue.push({"b"}) == Push::Queued, "close: second fits");
+    expect_true(queue.push({"c"}) == Push::Overflow, "close: count overflow");
+    expect_true(queue.size() == 2, "close: queue unchanged");
+
+    Queue bytes = make_queue(BackpressurePolicy::Close, 10, 4);
+    expect_true(bytes.push({"abc"}) == Push::Queued, "close: bytes fit");
+    expect_true(bytes.push({"de"}) == Push::Overflow, "close: byte overflow");
+  }
+
+  void test_drop_newest()
+  {
+    Queue queue = make_queue(BackpressurePolicy::DropNewest, 2, 100);
+    queue.push({"a"});
+    queue.push({"b"});
+    expect_true(queue.push({"c"}) == Push::Dropped, "drop newest: rejected");
+    expect_true(drain(queue) == "a b ", "drop newest: keeps oldest");
+    expect_true(queue.stats().dropped == 1, "drop newest: counted");
+  }
+
+  void test_drop_oldest()
+  {
+    Queue queue = make_queue(BackpressurePolicy::DropOldest, 3, 6);
+    queue.push({"aa"});
+    queue.push({"bb"});
+    queue.push({"cc"});
+    expect_true(queue.push({"ddd"}) == Push::QueuedAfterShedding, "drop oldest: queued");
+    expect_true(drain(queue) == "cc ddd ", "drop oldest: sheds until it fits");
+    expect_true(queue.stats().dropped == 2, "drop oldest: counted");
+    expect_true(queue.bytes() == 0, "drop oldest: bytes drained");
+
+    expect_true(queue.push({"toolarge"}) == Push::Dropped, "drop oldest: oversize dropped");
+    expect_true(queue.empty(), "drop oldest: oversize leaves queue alone");
+  }
+
+  void test_conflate_by_key()
+  {
+    Queue queue = make_queue(BackpressurePolicy::ConflateByKey, 3, 100);
+    queue.push({"eur1", "EUR"});
+    queue.push({"usd1", "USD"});
+    queue.push({"note"});
+
+    expect_true(queue.push({"eur2", "EUR"}) == Push::QueuedAfterShedding, "conflate: replaced");
+    expect_true(queue.size() == 3, "conflate: depth bounded");
+    expect_true(drain(queue) == "eur2 usd1 note ", "conflate: latest value in place");
+    expect_true(queue.stats().conflated == 1, "conflate: counted");
+
+    // Below the limits keyed messages are queued normally.
+    queue.push({"eur3", "EUR"});
+    queue.push({"eur4", "EUR"});
+    queue.push({"gbp1", "GBP"});
+    expect_true(queue.size() == 3, "conflate: no shedding below limits");
+
+    // A new key compacts superseded entries to make room.
+    expect_true(queue.push({"jpy1", "JPY"}) == Push::QueuedAfterShedding, "conflate: compacted");
+    expect_true(drain(queue) == "eur4 gbp1 jpy1 ", "conflate: keeps latest per key");
+
+    queue.push({"x"});
+    queue.push({"y"});
+    queue.push({"z"});
+    expect_true(queue.push({"w"}) == Push::Overflow, "conflate: unkeyed overflow closes");
+  }
+
+  void test_push_conflated()
+  {
+    Queue queue = make_queue(BackpressurePolicy::Close, 100, 1000);
+    queue.push_conflated({"cpu=10", "cpu"});
+    queue.push_conflated({"mem=40", "mem"});
+    queue.push({"log"});
+
+    expect_true(queue.push_conflated({"cpu=12", "cpu"}) == Push::Replaced, "conflated: replaced");
+    expect_true(queue.push_conflated({"cpu=15", "cpu"}) == Push::Replaced, "conflated: replaced again");
+    expect_true(queue.size() == 3, "conflated: no growth");
+    expect_true(queue.bytes() == 15, "conflated: bytes follow replacement");
+    expect_true(queue.stats().conflated == 2, "conflated: counted");
+
+    std::vector<FakeMessage> batch;
+    queue.pop_batch(batch, 1, 1000);
+    expect_true(batch.front().data == "cpu=15", "conflated: keeps original position");
+
+    // The popped message is being written; a new value queues behind it.
+    expect_true(queue.push_conflated({"cpu=20", "cpu"}) == Push::Queued, "conflated: popped key requeues");
+    expect_true(queue.push_conflated({"mem=41", "mem"}) == Push::Replaced, "conflated: other key still indexed");
+    expect_true(drain(queue) == "mem=41 log cpu=20 ", "conflated: order after pop");
+
+    for (int round = 0; round < 1000; ++round)
+    {
+      queue.push_conflated({"v" + std::to_string(round), "tick"});
+    }
+    expect_true(queue.size() == 1, "conflated: bounded by key count");
+    expect_true(drain(queue) == "v999 ", "conflated: freshest value");
+  }
+
+  void test_priority_lanes()
+  {
+    using vix::websocket::detail::WriteLane;
+
+    Queue queue = make_queue(BackpressurePolicy::Close, 1000, 1 << 20);
+    for (int i = 0; i < 20; ++i)
+    {
+      queue.push({"b"}, WriteLane::Bulk);
+      queue.push({"n"}, WriteLane::Normal);
+      queue.push({"h"}, WriteLane::High);
+    }
+    queue.push({"p"}, WriteLane::Control);
+
+    std::vector<FakeMessage> batch;
+    queue.pop_batch(batch, 14, 1 << 20);
+
+    std::string order;
+    for (const auto &m : batch)
+    {
+      order += m.data;
+    }
+    expect_true(order == "phhhhhhhhnnnnb", "lanes: control first, then 8/4/1 weights");
+
+    batch.clear();
+    queue.pop_batch(batch, 1000, 1 << 20);
+    int bulk = 0;
+    for (std::size_t i = 0; i < 26; ++i)
+    {
+      bulk += batch[i].data == "b" ? 1 : 0;
+    }
+    expect_true(bulk >= 2, "lanes: bulk is not starved");
+    expect_true(queue.empty(), "lanes: all drained");
+  }
+
+  void test_pop_control_and_split()
+  {
+    using vix::websocket::detail::WriteLane;
+
+    Queue queue = make_queue(BackpressurePolicy::Close, 100, 1 << 20);
+    queue.push({std::string(100, 'x')});
+    queue.push({"after"});
+    queue.push({"ping"}, WriteLane::Control);
+
+    std::vector<FakeMessage> batch;
+    queue.pop_control(batch);
+    expect_true(batch.size() == 1 && batch[0].data == "ping", "control: popped alone");
+
+    batch.clear();
+    queue.pop_batch(batch, 10, 1 << 20, 50);
+    expect_true(batch.size() == 1 && batch[0].data.size() == 100, "split: batch ends after large message");
+    expect_true(queue.size() == 1, "split: rest stays queued");
+  }
+
+  void test_drop_oldest_sheds_bulk_first()
+  {
+    using vix::websocket::detail::WriteLane;
+
+    Queue queue = make_queue(BackpressurePolicy::DropOldest, 3, 100);
+    queue.push({"h1"}, WriteLane::High);
+    queue.push({"b1"}, WriteLane::Bulk);
+    queue.push({"n1"}, WriteLane::Normal);
+    queue.push({"h2"}, WriteLane::High);
+
+    expect_true(drain(queue) == "h1 h2 n1 ", "drop oldest: bulk lane shed first");
+  }
+
+  void test_control_bypasses_limits()
+  {
+    using vix::websocket::detail::WriteLane;
+
+    const BackpressurePolicy policies[] = {
+        BackpressurePolicy::Close,
+        BackpressurePolicy::DropOldest,
+        BackpressurePolicy::DropNewest,
+        BackpressurePolicy::ConflateByKey,
+    };
+    const char *names[] = {"close", "drop oldest", "drop newest", "conflate"};
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      const std::string name = std::string("control under ") + names[i] + ": ";
+
+      Queue queue = make_queue(policies[i], 2, 4);
+      queue.push({"ab"}, WriteLane::Bulk);
+      queue.push({"cd"}, WriteLane::Normal);
+
+      // The data lanes are full by count and by bytes.
+      expect_true(queue.push({"pong"}, WriteLane::Control) == Push::Queued, name + "pong queued");
+      expect_true(queue.push({"close"}, WriteLane::Control) == Push::Queued, name + "close queued");
+      expect_true(queue.size(WriteLane::Control) == 2, name + "control kept");
+      expect_true(queue.stats().dropped == 0, name + "nothing shed");
+
+      // Shedding for a data message never reaches the Control lane.
+      queue.push({"ef"}, WriteLane::High);
+      expect_true(queue.size(WriteLane::Control) == 2, name + "control survives data overflow");
+
+      // Queued control frames do not take the data budget.
+      std::vector<FakeMessage> batch;
+      queue.pop_batch(batch, 2, 1 << 20);
+      expect_true(batch.size() == 2 && batch[0].data == "pong" && batch[1].data == "close",
+                  name + "control written first");
+    }
+
+    // Control does not count, so a data message still fits next to it.
+    Queue queue = make_queue(BackpressurePolicy::Close, 1, 2);
+    queue.push({"ping"}, WriteLane::Control);
+    expect_true(queue.push({"ab"}) == Push::Queued, "control: data fits beside it");
+    expect_true(queue.push({"c"}) == Push::Overflow, "control: data limit still enforced");
+    expect_true(drain(queue) == "ping ab ", "control: order");
+    expect_true(queue.bytes() == 0 && queue.push({"ab"}) == Push::Queued, "control: budget released");
+  }
+
+  void test_push_last_is_written_last()
+  {
+    using vix::websocket::detail::WriteLane;
+
+    Queue queue = make_queue(BackpressurePolicy::Close, 2, 100);
+    queue.push({"big"});
+    queue.push({"h"}, WriteLane::High);
+    queue.push({"pong"}, WriteLane::Control);
+
+    expect_true(queue.push_last({"close"}), "last: queued over the limits");
+    expect_true(!queue.push_last({"close2"}), "last: only once");
+    expect_true(queue.push({"late"}, WriteLane::Control) == Push::Dropped, "last: later pushes dropped");
+    expect_true(queue.sealed(), "last: sealed");
+
+    // Between fragments only the earlier control frames may go out.
+    std::vector<FakeMessage> batch;
+    queue.pop_control(batch);
+    expect_true(batch.size() == 1 && batch[0].data == "pong", "last: held back between fragments");
+
+    batch.clear();
+    queue.pop_batch(batch, 1, 1 << 20);
+    queue.pop_batch(batch, 1, 1 << 20);
+    expect_true(batch.size() == 2 && batch[0].data == "h" && batch[1].data == "big", "last: data drains first");
+
+    batch.clear();
+    queue.pop_control(batch);
+    expect_true(batch.empty(), "last: pop_control never takes it");
+    queue.pop_batch(batch, 10, 1 << 20);
+    expect_true(batch.size() == 1 && batch[0].data == "close", "last: written after everything");
+
+    queue.clear();
+    expect_true(!queue.sealed() && queue.push({"a"}) == Push::Queued, "last: clear unseals");
+  }
+
+  void test_high_water_and_options()
+  {
+    Queue queue = make_queue(BackpressurePolicy::Close, 10, 100);
+    queue.push({"aaaa"});
+    queue.push({"bbbb"});
+    queue.push({"cc"});
+    drain(queue);
+    queue.push({"d"});
+
+    const auto stats = queue.stats();
+    expect_true(stats.messages == 1 && stats.bytes == 1, "stats: current depth");
+    expect_true(stats.highWaterMessages == 3, "stats: message high-water");
+    expect_true(stats.highWaterBytes == 10, "stats: byte high-water");
+
+    BackpressureOptions tight;
+    tight.maxMessages = 1;
+    queue.set_options(tight);
+    expect_true(queue.push({"e"}) == Push::Overflow, "options: new limits apply");
+  }
+
+  void test_pop_batch_limits()
+  {
+    Queue queue = make_queue(BackpressurePolicy::Close, 10, 100);
+    queue.push({std::string(30, 'a')});
+    queue.push({std::string(30, 'b')});
+    queue.push({std::string(30, 'c')});
+
+    std::vector<FakeMessage> batch;
+    expect_true(queue.pop_batch(batch, 10, 50) == 30, "batch: byte cap");
+    expect_true(batch.size() == 1 && queue.size() == 2, "batch: one message taken");
+
+    batch.clear();
+    expect_true(queue.pop_batch(batch, 1, 1) == 30, "batch: first message always taken");
+    expect_true(queue.bytes() == 30, "batch: bytes tracked");
+  }
+}
+
+int main()
+{
+  test_close_policy();
+  test_drop_newest();
+  test_drop_oldest();
+  test_conflate_by_key();
+  test_push_conflated();
+  test_priority_lanes();
+  test_pop_control_and_split();
+  test_drop_oldest_sheds_bulk_first();
+  test_control_bypasses_limits();
+  test_push_last_is_written_last();
+  test_high_water_and_options();
+  test_pop_batch_limits();
+
+  if (failures != 0)
+  {
+    std::cerr << "websocket_write_queue_tests failed with "
+              << failures
+              << " failure(s)\n";
+
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "websocket_write_queue_tests passed\n";
+  return EXIT_SUCCESS;
+}